@@ -0,0 +1,222 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_ALGORITHM_H
+#define MY_ALGORITHM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_simd.h"
+#include "my_span.h"
+#include "my_storage.h"
+#include "my_vector.h"
+
+// Batch kernels over MyVector / MyArray / MySpan: prefix sums, histograms
+// and partitioning.
+//
+//     MyVector<std::uint32_t> offsets(counts.size(), 0);
+//     std::uint32_t total = my::exclusive_scan(counts, offsets, 0);
+//     MyVector<size_t> top = my::histogram(keys, 256, [](std::uint32_t k) { return k >> 24; });
+//     size_t small = my::partition(keys, [](std::uint32_t k) { return k < 1000; });
+//
+// Sums of 32- and 64-bit integers use the SIMD scans from my_simd.h. The
+// multi-threaded versions are in my_parallel.h (my::parallel). The kernels
+// work on raw pointers, so strided views are rejected at compile time.
+namespace my {
+
+namespace detail {
+
+template<typename C>
+using value_t = typename decltype(mutable_span(std::declval<C&>()))::value_type;
+
+// Scanning In into Out with Op is a wrapping integer sum my_simd handles.
+template<typename In, typename Out, typename Op>
+inline constexpr bool is_simd_sum = std::is_same_v<std::remove_const_t<In>, Out> && my_simd::has_simd_scan<Out>
+                                    && (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<Out>>);
+
+// Scans n elements into `out` continuing from `init`, which must be an
+// identity of op for the first element of the whole range (the parallel
+// versions pass each block's prefix). Returns the running value at the end.
+template<bool Inclusive, typename In, typename Out, typename Op>
+Out scan_into(const In* in, size_t n, Out* out, Out init, Op& op) {
+    if constexpr (is_simd_sum<In, Out, Op>) {
+        return my_simd::scan<Inclusive>(in, n, out, init);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            if constexpr (Inclusive) {
+                init = op(std::move(init), in[i]);
+                out[i] = init;
+            } else {
+                Out next = op(init, in[i]);   // before out[i], which may be in[i]
+                out[i] = std::move(init);
+                init = std::move(next);
+            }
+        }
+        return init;
+    }
+}
+
+// Uninitialized scratch space for trivially copyable elements.
+template<typename T>
+class RawBuffer {
+    T* data_;
+
+public:
+    explicit RawBuffer(size_t n) : data_(my_storage::allocate<T>(n)) {}
+    RawBuffer(const RawBuffer&) = delete;
+    RawBuffer& operator=(const RawBuffer&) = delete;
+    ~RawBuffer() { my_storage::deallocate(data_); }
+    T* data() const noexcept { return data_; }
+};
+
+// Consecutive elements are counted in kHistogramLanes interleaved copies
+// of the counters, so a run of equal keys does not serialize on one
+// counter's store-to-load forwarding. Past kMaxLanedBins the copies stop
+// fitting in L1 and a single array is faster.
+inline constexpr size_t kHistogramLanes = 4;
+inline constexpr size_t kMaxLanedBins = 4096;
+
+template<typename T, typename Key>
+void count_into(const T* data, size_t n, size_t bins, Key& key, size_t* counts) {
+    auto bin = [&](const T& x) {
+        const size_t k = static_cast<size_t>(key(x));
+        if (k >= bins) throw std::out_of_range("my::histogram: key out of range");
+        return k;
+    };
+    if (bins > kMaxLanedBins || n < 1024) {
+        for (size_t i = 0; i < n; ++i) ++counts[bin(data[i])];
+        return;
+    }
+    constexpr size_t L = kHistogramLanes;
+    // 32-bit counters, flushed before any of them can overflow.
+    constexpr size_t kFlushEvery = size_t(1) << 30;
+    MyVector<std::uint32_t> lanes(bins * L, 0);
+    size_t i = 0;
+    while (i < n) {
+        const size_t end = i + std::min(n - i, kFlushEvery);
+        for (; i + L <= end; i += L)
+            for (size_t l = 0; l < L; ++l) ++lanes[bin(data[i + l]) * L + l];
+        for (; i < end; ++i) ++lanes[bin(data[i]) * L];
+        for (size_t k = 0; k < bins; ++k) {
+            for (size_t l = 0; l < L; ++l) counts[k] += lanes[k * L + l];
+        }
+        std::fill(lanes.begin(), lanes.end(), 0u);
+    }
+}
+
+// Lomuto partition that always swaps and advances the boundary by the
+// predicate's result, so there is no data-dependent branch to mispredict.
+template<typename T, typename Pred>
+size_t partition_branchless(T* a, size_t n, Pred& pred) {
+    size_t j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const T x = a[i];
+        const bool keep = static_cast<bool>(pred(x));
+        a[i] = a[j];
+        a[j] = x;
+        j += keep;
+    }
+    return j;
+}
+
+// Every element is written both to the front of `a` (never past the one
+// being read) and to `rest`; only the matching position advances.
+template<typename T, typename Pred>
+size_t stable_partition_branchless(T* a, size_t n, T* rest, Pred& pred) {
+    size_t j = 0, k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const T x = a[i];
+        const bool keep = static_cast<bool>(pred(x));
+        a[j] = x;
+        rest[k] = x;
+        j += keep;
+        k += !keep;
+    }
+    std::copy(rest, rest + k, a + j);
+    return j;
+}
+
+} // namespace detail
+
+// out[i] = in[0] op ... op in[i]; `out` must have in.size() elements and
+// may be `in`. Returns the last value written (T() for an empty range).
+template<typename In, typename Out, typename Op = std::plus<>>
+    requires detail::contiguous_range<In> && detail::contiguous_range<Out>
+auto inclusive_scan(const In& in, Out&& out, Op op = Op()) {
+    auto src = detail::const_span(in);
+    auto dst = detail::mutable_span(out);
+    using T = detail::value_t<Out>;
+    if (src.size() != dst.size()) throw std::invalid_argument("my::inclusive_scan: sizes differ");
+    if (src.is_empty()) return T();
+    if constexpr (detail::is_simd_sum<typename decltype(src)::value_type, T, Op>) {
+        return my_simd::inclusive_scan(src.data(), src.size(), dst.data());
+    } else {
+        T first = src[0];
+        dst[0] = first;
+        return detail::scan_into<true>(src.data() + 1, src.size() - 1, dst.data() + 1, std::move(first), op);
+    }
+}
+
+// out[i] = init op in[0] op ... op in[i - 1]; `out` must have in.size()
+// elements and may be `in`. Returns init op (all elements), which for
+// offsets is the end of the last bucket.
+template<typename In, typename Out, typename Op = std::plus<>>
+    requires detail::contiguous_range<In> && detail::contiguous_range<Out>
+auto exclusive_scan(const In& in, Out&& out, detail::value_t<Out> init, Op op = Op()) {
+    auto src = detail::const_span(in);
+    auto dst = detail::mutable_span(out);
+    if (src.size() != dst.size()) throw std::invalid_argument("my::exclusive_scan: sizes differ");
+    return detail::scan_into<false>(src.data(), src.size(), dst.data(), std::move(init), op);
+}
+
+// counts[k] is the number of elements x with key(x) == k. Keys must be
+// below `bins` (std::out_of_range otherwise).
+template<typename In, typename Key = std::identity>
+    requires detail::contiguous_range<In>
+MyVector<size_t> histogram(const In& in, size_t bins, Key key = Key()) {
+    auto src = detail::const_span(in);
+    MyVector<size_t> counts(bins, 0);
+    detail::count_into(src.data(), src.size(), bins, key, counts.begin());
+    return counts;
+}
+
+// Moves the elements that satisfy `pred` to the front and returns how many
+// there are (std::partition, with an index for the iterator). Trivially
+// copyable elements take a branchless loop; others use std::partition.
+// For a three-way split, partition by "less", then partition the rest
+// (MySpan::subspan) by "equal".
+template<typename C, typename Pred>
+    requires detail::contiguous_range<C>
+size_t partition(C&& range, Pred pred) {
+    auto s = detail::mutable_span(range);
+    if constexpr (std::is_trivially_copyable_v<detail::value_t<C>>) {
+        return detail::partition_branchless(s.data(), s.size(), pred);
+    } else {
+        return static_cast<size_t>(std::partition(s.begin(), s.end(), pred) - s.begin());
+    }
+}
+
+// Like partition(), but both groups keep their order. The branchless
+// version needs a scratch buffer of size() elements.
+template<typename C, typename Pred>
+    requires detail::contiguous_range<C>
+size_t stable_partition(C&& range, Pred pred) {
+    auto s = detail::mutable_span(range);
+    using T = detail::value_t<C>;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        detail::RawBuffer<T> rest(s.size());
+        return detail::stable_partition_branchless(s.data(), s.size(), rest.data(), pred);
+    } else {
+        return static_cast<size_t>(std::stable_partition(s.begin(), s.end(), pred) - s.begin());
+    }
+}
+
+} // namespace my
+
+#endif // MY_ALGORITHM_H
@@ -12,6 +12,8 @@
 #include <compare>
 #include <utility>
 
+#include "my_simd.h"
+
 template<typename T, std::size_t N>
 class MyArray {
     T data_[N > 0 ? N : 1];
@@ -41,6 +43,13 @@ public:
         }
     }
 
+    // One-pass evaluation of a lazy element-wise expression (see my_expr.h).
+    template<typename E>
+        requires requires { typename E::my_expression_tag; }
+    MyArray(const E& expr) {
+        *this = expr;
+    }
+
     MyArray(const MyArray& other) {
         for (std::size_t i = 0; i < N; ++i) {
             data_[i] = other.data_[i];
@@ -71,6 +80,15 @@ public:
         return *this;
     }
 
+    template<typename E>
+        requires requires { typename E::my_expression_tag; }
+    MyArray& operator=(const E& expr) {
+        if (expr.size() != N) throw std::invalid_argument("MyArray: expression size differs");
+        for (std::size_t i = 0; i < N; ++i)
+            data_[i] = expr[i];
+        return *this;
+    }
+
     ~MyArray() {}
 
     T& operator[](std::size_t index) { return data_[index]; }
@@ -119,7 +137,10 @@ public:
         }
     }
 
+    // Integral, enum and pointer elements go through the my_simd.h kernels.
     bool operator==(const MyArray& other) const {
+        if constexpr (my_simd::is_bitwise_comparable<T> && N > 0)
+            return my_simd::equal(data_, other.data_, N);
         for (std::size_t i = 0; i < N; ++i) {
             if (!(data_[i] == other.data_[i]))
                 return false;
@@ -128,6 +149,11 @@ public:
     }
 
     auto operator<=>(const MyArray& other) const {
+        if constexpr (my_simd::is_bitwise_comparable<T> && N > 0) {
+            const std::size_t i = my_simd::mismatch(data_, other.data_, N);
+            if (i < N) return data_[i] <=> other.data_[i];
+            return std::strong_ordering::equal;
+        }
         for (std::size_t i = 0; i < N; ++i) {
             if (auto cmp = data_[i] <=> other.data_[i]; cmp != 0) {
                 return cmp;
@@ -0,0 +1,296 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_BIT_VECTOR_H
+#define MY_BIT_VECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "my_simd.h"
+#include "my_vector.h"
+
+// Packed sequence of bits, 64 per word (MyVector<bool> spends a byte on each).
+// Bits past size() in the last word are always zero, so the word-level
+// kernels (count, bitwise ops, comparison) never need to mask them.
+class MyBitVector {
+public:
+    using word_type = std::uint64_t;
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Proxy for a single bit, returned by the non-const operator[].
+    class reference {
+        word_type* word_;
+        word_type mask_;
+
+        reference(word_type* word, size_t bit) noexcept : word_(word), mask_(word_type(1) << bit) {}
+        friend class MyBitVector;
+
+    public:
+        reference(const reference&) = default;
+
+        operator bool() const noexcept { return (*word_ & mask_) != 0; }
+        bool operator~() const noexcept { return !bool(*this); }
+
+        reference& operator=(bool value) noexcept {
+            if (value) *word_ |= mask_;
+            else *word_ &= ~mask_;
+            return *this;
+        }
+        reference& operator=(const reference& other) noexcept { return *this = bool(other); }
+
+        void flip() noexcept { *word_ ^= mask_; }
+    };
+
+private:
+    MyVector<word_type> words_;
+    size_t size_ = 0;
+
+    static size_t words_for(size_t bits) noexcept { return (bits + kWordBits - 1) / kWordBits; }
+
+    void clear_tail() noexcept {
+        if (size_ % kWordBits) words_.back() &= (word_type(1) << (size_ % kWordBits)) - 1;
+    }
+
+    void check_size(const MyBitVector& other, const char* what) const {
+        if (other.size_ != size_) throw std::invalid_argument(what);
+    }
+
+public:
+    MyBitVector() noexcept = default;
+
+    explicit MyBitVector(size_t count, bool value = false)
+        : words_(words_for(count), value ? ~word_type(0) : word_type(0)), size_(count) {
+        clear_tail();
+    }
+
+    MyBitVector(std::initializer_list<bool> init) {
+        reserve(init.size());
+        for (bool bit : init) push_back(bit);
+    }
+
+    bool operator[](size_t index) const noexcept {
+        return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+    reference operator[](size_t index) noexcept {
+        return reference(&words_[index / kWordBits], index % kWordBits);
+    }
+
+    bool at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MyBitVector::at");
+        return (*this)[index];
+    }
+    reference at(size_t index) {
+        if (index >= size_) throw std::out_of_range("MyBitVector::at");
+        return (*this)[index];
+    }
+
+    bool is_empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return words_.capacity() * kWordBits; }
+    // Bytes of bit storage in use.
+    size_t memory_bytes() const noexcept { return words_.capacity() * sizeof(word_type); }
+
+    // Raw words; bits past size() are zero.
+    const word_type* words() const noexcept { return words_.begin(); }
+    size_t word_count() const noexcept { return words_.size(); }
+
+    void reserve(size_t bits) { words_.reserve(words_for(bits)); }
+    void shrink_to_fit() { words_.shrink_to_fit(); }
+
+    void clear() noexcept {
+        words_.clear();
+        size_ = 0;
+    }
+
+    void resize(size_t count, bool value = false) {
+        if (count > size_ && value) {
+            if (size_ % kWordBits) words_.back() |= ~word_type(0) << (size_ % kWordBits);
+            words_.resize(words_for(count), ~word_type(0));
+        } else {
+            words_.resize(words_for(count), word_type(0));
+        }
+        size_ = count;
+        clear_tail();
+    }
+
+    void push_back(bool value) {
+        if (size_ % kWordBits == 0) words_.push_back(word_type(0));
+        words_.back() |= word_type(value) << (size_ % kWordBits);
+        ++size_;
+    }
+
+    void pop_back() {
+        if (size_ == 0) throw std::out_of_range("MyBitVector::pop_back");
+        --size_;
+        if (size_ % kWordBits == 0) words_.pop_back();
+        else clear_tail();
+    }
+
+    void set(size_t index, bool value = true) { (*this)[index] = value; }
+    void reset(size_t index) { (*this)[index] = false; }
+    void flip(size_t index) { (*this)[index].flip(); }
+
+    // Whole-vector versions.
+    void set() noexcept {
+        std::fill(words_.begin(), words_.end(), ~word_type(0));
+        clear_tail();
+    }
+    void reset() noexcept { std::fill(words_.begin(), words_.end(), word_type(0)); }
+    void flip() noexcept {
+        for (auto& w : words_) w = ~w;
+        clear_tail();
+    }
+
+    // Number of set bits.
+    size_t count() const noexcept { return my_simd::popcount(words_.begin(), words_.size()); }
+    // Number of positions set in both vectors, without materializing the AND.
+    size_t count_and(const MyBitVector& other) const {
+        check_size(other, "MyBitVector::count_and");
+        return my_simd::popcount_and(words_.begin(), other.words_.begin(), words_.size());
+    }
+
+    bool any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](word_type w) { return w != 0; });
+    }
+    bool none() const noexcept { return !any(); }
+    bool all() const noexcept { return count() == size_; }
+
+    // Set bits in [0, pos); O(pos / 64). Use MyBitRank for repeated queries.
+    size_t rank(size_t pos) const noexcept {
+        pos = std::min(pos, size_);
+        size_t full = pos / kWordBits;
+        size_t count = my_simd::popcount(words_.begin(), full);
+        if (pos % kWordBits)
+            count += static_cast<size_t>(std::popcount(words_[full] & ((word_type(1) << (pos % kWordBits)) - 1)));
+        return count;
+    }
+
+    // Index of the first set bit, or npos.
+    size_t find_first() const noexcept {
+        for (size_t w = 0; w < words_.size(); ++w)
+            if (words_[w]) return w * kWordBits + static_cast<size_t>(std::countr_zero(words_[w]));
+        return npos;
+    }
+
+    // Index of the first set bit after `pos`, or npos (also for pos == npos).
+    size_t find_next(size_t pos) const noexcept {
+        if (pos >= size_ || ++pos == size_) return npos;
+        size_t w = pos / kWordBits;
+        word_type word = words_[w] & (~word_type(0) << (pos % kWordBits));
+        while (true) {
+            if (word) return w * kWordBits + static_cast<size_t>(std::countr_zero(word));
+            if (++w == words_.size()) return npos;
+            word = words_[w];
+        }
+    }
+
+    MyBitVector& operator&=(const MyBitVector& other) {
+        check_size(other, "MyBitVector::operator&=");
+        for (size_t i = 0; i < words_.size(); ++i) words_[i] &= other.words_[i];
+        return *this;
+    }
+    MyBitVector& operator|=(const MyBitVector& other) {
+        check_size(other, "MyBitVector::operator|=");
+        for (size_t i = 0; i < words_.size(); ++i) words_[i] |= other.words_[i];
+        return *this;
+    }
+    MyBitVector& operator^=(const MyBitVector& other) {
+        check_size(other, "MyBitVector::operator^=");
+        for (size_t i = 0; i < words_.size(); ++i) words_[i] ^= other.words_[i];
+        return *this;
+    }
+
+    MyBitVector operator~() const {
+        MyBitVector result(*this);
+        result.flip();
+        return result;
+    }
+
+    friend MyBitVector operator&(MyBitVector lhs, const MyBitVector& rhs) { return lhs &= rhs; }
+    friend MyBitVector operator|(MyBitVector lhs, const MyBitVector& rhs) { return lhs |= rhs; }
+    friend MyBitVector operator^(MyBitVector lhs, const MyBitVector& rhs) { return lhs ^= rhs; }
+
+    bool operator==(const MyBitVector& other) const {
+        return size_ == other.size_ && words_ == other.words_;
+    }
+
+    void swap(MyBitVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+};
+
+// Rank/select index over a MyBitVector: cumulative counts every 512 bits
+// (one cache line of words) plus a 16-bit in-block count per word, so rank
+// costs one popcount and select a binary search. About 5% extra memory.
+// The index must be rebuilt after the vector changes.
+class MyBitRank {
+private:
+    using word_type = MyBitVector::word_type;
+    static constexpr size_t kBlockWords = 8;
+    static constexpr size_t kWordBits = MyBitVector::kWordBits;
+
+    const MyBitVector* bits_;
+    MyVector<size_t> blocks_;           // set bits before each block, plus the total
+    MyVector<std::uint16_t> in_block_;  // set bits before each word within its block
+
+    // Position of the k-th (0-based) set bit of a word that has more than k.
+    static size_t select_in_word(word_type word, size_t k) noexcept {
+        for (; k; --k) word &= word - 1;
+        return static_cast<size_t>(std::countr_zero(word));
+    }
+
+public:
+    static constexpr size_t npos = MyBitVector::npos;
+
+    explicit MyBitRank(const MyBitVector& bits) : bits_(&bits) {
+        const size_t words = bits.word_count();
+        blocks_.reserve((words + kBlockWords - 1) / kBlockWords + 1);
+        in_block_.reserve(words);
+        size_t total = 0, block_start = 0;
+        for (size_t w = 0; w < words; ++w) {
+            if (w % kBlockWords == 0) {
+                blocks_.push_back(total);
+                block_start = total;
+            }
+            in_block_.push_back(static_cast<std::uint16_t>(total - block_start));
+            total += static_cast<size_t>(std::popcount(bits.words()[w]));
+        }
+        blocks_.push_back(total);
+    }
+
+    // Total number of set bits.
+    size_t ones() const noexcept { return blocks_.back(); }
+
+    // Set bits in [0, pos).
+    size_t rank(size_t pos) const noexcept {
+        pos = std::min(pos, bits_->size());
+        const size_t w = pos / kWordBits;
+        if (w == in_block_.size()) return ones();
+        size_t count = blocks_[w / kBlockWords] + in_block_[w];
+        if (pos % kWordBits)
+            count += static_cast<size_t>(std::popcount(bits_->words()[w] & ((word_type(1) << (pos % kWordBits)) - 1)));
+        return count;
+    }
+
+    // Index of the k-th (0-based) set bit, or npos if there are not that many.
+    size_t select(size_t k) const noexcept {
+        if (k >= ones()) return npos;
+        // Last block whose prefix count is <= k, then the last word in it.
+        size_t block = static_cast<size_t>(std::upper_bound(blocks_.begin(), blocks_.end() - 1, k) - blocks_.begin()) - 1;
+        k -= blocks_[block];
+        const size_t first = block * kBlockWords;
+        const size_t last = std::min(first + kBlockWords, in_block_.size());
+        size_t w = static_cast<size_t>(std::upper_bound(in_block_.begin() + first, in_block_.begin() + last, k)
+                                       - in_block_.begin()) - 1;
+        return w * kWordBits + select_in_word(bits_->words()[w], k - in_block_[w]);
+    }
+};
+
+#endif // MY_BIT_VECTOR_H
@@ -0,0 +1,418 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_COMPACT_VECTOR_H
+#define MY_COMPACT_VECTOR_H
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_storage.h"
+
+// Where MyCompactVector keeps its 32-bit size and capacity.
+enum class CompactLayout {
+    inline_counts,   // next to the pointer: 16-byte object
+    heap_header      // in front of the elements on the heap: 8-byte object, empty vectors allocate nothing
+};
+
+// MyVector with a smaller object: at most 2^32 - 1 elements, and the counts
+// stored as 32-bit values either inline or in the heap block. Meant for the
+// inner level of vectors-of-vectors (adjacency lists, buckets), where most
+// vectors are short and the 24-byte MyVector header dominates. Growing past
+// max_size() throws std::length_error. The API and the exception guarantees
+// follow MyVector.
+template<typename T, CompactLayout Layout = CompactLayout::inline_counts>
+class MyCompactVector {
+private:
+    static constexpr bool kInline = Layout == CompactLayout::inline_counts;
+
+    struct Header {
+        std::uint32_t size;
+        std::uint32_t capacity;
+    };
+
+    // Heap layout: the header sits in the first kHeaderBytes of the block,
+    // padded so that the elements stay aligned.
+    static constexpr size_t kBlockAlign = std::max(alignof(T), alignof(Header));
+    static constexpr size_t kHeaderBytes = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+    static constexpr bool kOverAligned = kBlockAlign > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    struct InlineCounts {
+        std::uint32_t size = 0;
+        std::uint32_t capacity = 0;
+    };
+    struct NoCounts {};
+
+    T* data_ = nullptr;
+    [[no_unique_address]] std::conditional_t<kInline, InlineCounts, NoCounts> counts_;
+
+    Header* header() const noexcept {
+        return reinterpret_cast<Header*>(reinterpret_cast<unsigned char*>(data_) - kHeaderBytes);
+    }
+
+    // Only called with a buffer (capacity() > 0) unless n == 0.
+    void set_size(size_t n) noexcept {
+        if constexpr (kInline) counts_.size = static_cast<std::uint32_t>(n);
+        else if (data_) header()->size = static_cast<std::uint32_t>(n);
+    }
+
+    static void check_size(size_t n) {
+        if (n > max_size()) throw std::length_error("MyCompactVector: more than 2^32 - 1 elements");
+    }
+
+    static T* allocate(size_t cap) {
+        if (cap == 0) return nullptr;
+        check_size(cap);
+        if constexpr (kInline) {
+            return my_storage::allocate<T>(cap);
+        } else {
+            const size_t bytes = kHeaderBytes + cap * sizeof(T);
+            void* block = kOverAligned ? ::operator new(bytes, std::align_val_t(kBlockAlign)) : ::operator new(bytes);
+            new (block) Header{0, static_cast<std::uint32_t>(cap)};
+            return reinterpret_cast<T*>(static_cast<unsigned char*>(block) + kHeaderBytes);
+        }
+    }
+
+    static void deallocate(T* data) noexcept {
+        if (!data) return;
+        if constexpr (kInline) {
+            my_storage::deallocate(data);
+        } else {
+            void* block = reinterpret_cast<unsigned char*>(data) - kHeaderBytes;
+            if constexpr (kOverAligned) ::operator delete(block, std::align_val_t(kBlockAlign));
+            else ::operator delete(block);
+        }
+    }
+
+    // Takes ownership of `data` (from allocate(cap)) holding `size` elements
+    // and frees the old buffer, whose elements must be gone already.
+    void adopt(T* data, size_t cap, size_t size) noexcept {
+        deallocate(data_);
+        data_ = data;
+        if constexpr (kInline) counts_.capacity = static_cast<std::uint32_t>(cap);
+        (void)cap;
+        set_size(size);
+    }
+
+    size_t grown_capacity(size_t needed) const {
+        check_size(needed);
+        return std::clamp<size_t>(capacity() * 2, std::max<size_t>(needed, 1), max_size());
+    }
+
+    // Shifting relocates elements one by one, so a move that throws halfway
+    // would leave raw slots inside [0, size()). Types without a nothrow move
+    // are appended and rotated into place instead (see insert_with/erase).
+    static constexpr bool kShiftSafe = std::is_trivially_copyable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    void shift_right(size_t idx, size_t count) noexcept {
+        static_assert(kShiftSafe);
+        T* d = data_;
+        const size_t n = size();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(static_cast<void*>(d + idx + count), static_cast<const void*>(d + idx), (n - idx) * sizeof(T));
+        } else {
+            for (size_t i = n; i > idx; --i) {
+                new (d + i + count - 1) T(std::move_if_noexcept(d[i - 1]));
+                d[i - 1].~T();
+            }
+        }
+    }
+
+    // Moves [from, end) back by `count` slots onto raw storage.
+    void shift_left(size_t from, size_t end, size_t count) noexcept {
+        static_assert(kShiftSafe);
+        for (size_t i = from; i < end; ++i) {
+            new (data_ + i - count) T(std::move_if_noexcept(data_[i]));
+            data_[i].~T();
+        }
+    }
+
+    // Opens a gap of `count` slots at `idx` and calls fill(gap), which must
+    // construct all of them or none (and throw). On reallocation the new
+    // elements are built before the old ones move, so fill may read *this.
+    // A throwing fill leaves *this unchanged. If T's move can throw, the new
+    // elements are built at the end and rotated into place; a failure in the
+    // rotation leaves every element valid and counted, in an unspecified order.
+    template<typename Fill>
+    T* insert_with(size_t idx, size_t count, Fill fill) {
+        const size_t n = size();
+        if (count == 0) return data_ + idx;
+        if (n + count > capacity()) {
+            const size_t new_cap = grown_capacity(n + count);
+            T* new_data = allocate(new_cap);
+            try {
+                fill(new_data + idx);
+            } catch (...) {
+                deallocate(new_data);
+                throw;
+            }
+            my_storage::relocate(data_, idx, new_data);
+            my_storage::relocate(data_ + idx, n - idx, new_data + idx + count);
+            adopt(new_data, new_cap, n + count);
+        } else if constexpr (kShiftSafe) {
+            shift_right(idx, count);
+            try {
+                fill(data_ + idx);
+            } catch (...) {
+                shift_left(idx + count, n + count, count);
+                throw;
+            }
+            set_size(n + count);
+        } else {
+            fill(data_ + n);
+            set_size(n + count);
+            std::rotate(data_ + idx, data_ + n, data_ + n + count);
+        }
+        return data_ + idx;
+    }
+
+    void reallocate(size_t new_cap) {
+        const size_t n = size();
+        T* new_data = allocate(new_cap);
+        my_storage::relocate(data_, n, new_data);
+        adopt(new_data, new_cap, n);
+    }
+
+public:
+    using value_type = T;
+    static constexpr CompactLayout layout = Layout;
+
+    MyCompactVector() noexcept = default;
+
+    MyCompactVector(size_t count, const T& value) {
+        reserve(count);
+        try {
+            std::uninitialized_fill_n(data_, count, value);
+        } catch (...) {
+            deallocate(data_);
+            throw;
+        }
+        set_size(count);
+    }
+
+    template<std::input_iterator InputIt>
+    MyCompactVector(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            reserve(count);
+            try {
+                std::uninitialized_copy(first, last, data_);
+            } catch (...) {
+                deallocate(data_);
+                throw;
+            }
+            set_size(count);
+        } else {
+            try {
+                for (; first != last; ++first) emplace_back(*first);
+            } catch (...) {
+                clear();
+                deallocate(data_);
+                throw;
+            }
+        }
+    }
+
+    MyCompactVector(std::initializer_list<T> init) : MyCompactVector(init.begin(), init.end()) {}
+
+    MyCompactVector(const MyCompactVector& other) : MyCompactVector(other.begin(), other.end()) {}
+
+    MyCompactVector(MyCompactVector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), counts_(std::exchange(other.counts_, {})) {}
+
+    ~MyCompactVector() {
+        clear();
+        deallocate(data_);
+    }
+
+    MyCompactVector& operator=(const MyCompactVector& other) {
+        if (this != &other) {
+            MyCompactVector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    MyCompactVector& operator=(MyCompactVector&& other) noexcept {
+        if (this != &other) {
+            MyCompactVector tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    T& operator[](size_t index) noexcept { return data_[index]; }
+    const T& operator[](size_t index) const noexcept { return data_[index]; }
+
+    T& at(size_t index) {
+        if (index >= size()) throw std::out_of_range("MyCompactVector::at");
+        return data_[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= size()) throw std::out_of_range("MyCompactVector::at");
+        return data_[index];
+    }
+
+    T& front() {
+        if (is_empty()) throw std::out_of_range("MyCompactVector::front");
+        return data_[0];
+    }
+    const T& front() const {
+        if (is_empty()) throw std::out_of_range("MyCompactVector::front");
+        return data_[0];
+    }
+
+    T& back() {
+        if (is_empty()) throw std::out_of_range("MyCompactVector::back");
+        return data_[size() - 1];
+    }
+    const T& back() const {
+        if (is_empty()) throw std::out_of_range("MyCompactVector::back");
+        return data_[size() - 1];
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + size(); }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size(); }
+    const T* cbegin() const noexcept { return begin(); }
+    const T* cend() const noexcept { return end(); }
+
+    auto rbegin() noexcept { return std::reverse_iterator<T*>(end()); }
+    auto rend() noexcept { return std::reverse_iterator<T*>(begin()); }
+    auto rbegin() const noexcept { return std::reverse_iterator<const T*>(end()); }
+    auto rend() const noexcept { return std::reverse_iterator<const T*>(begin()); }
+
+    size_t size() const noexcept {
+        if constexpr (kInline) return counts_.size;
+        else return data_ ? header()->size : 0;
+    }
+    size_t capacity() const noexcept {
+        if constexpr (kInline) return counts_.capacity;
+        else return data_ ? header()->capacity : 0;
+    }
+    bool is_empty() const noexcept { return size() == 0; }
+    static constexpr size_t max_size() noexcept { return UINT32_MAX; }
+
+    void reserve(size_t new_cap) {
+        if (new_cap > capacity()) reallocate(new_cap);
+    }
+
+    // Shrinking to zero frees the buffer, so an emptied heap_header vector
+    // is back to 8 bytes in total.
+    void shrink_to_fit() {
+        if (size() < capacity()) reallocate(size());
+    }
+
+    void clear() noexcept {
+        my_storage::destroy(begin(), end());
+        set_size(0);
+    }
+
+    void resize(size_t count, const T& value = T()) {
+        const size_t n = size();
+        if (count < n) {
+            my_storage::destroy(data_ + count, data_ + n);
+            set_size(count);
+        } else if (count > n) {
+            insert_with(n, count - n, [&](T* gap) { std::uninitialized_fill_n(gap, count - n, value); });
+        }
+    }
+
+    void swap(MyCompactVector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(counts_, other.counts_);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        const size_t n = size();
+        if (n < capacity()) {
+            new (data_ + n) T(std::forward<Args>(args)...);
+            set_size(n + 1);
+            return data_[n];
+        }
+        return *insert_with(n, 1, [&](T* gap) { new (gap) T(std::forward<Args>(args)...); });
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        if (is_empty()) throw std::out_of_range("MyCompactVector::pop_back");
+        const size_t n = size() - 1;
+        data_[n].~T();
+        set_size(n);
+    }
+
+    // Constructs an element from `args` before `pos`; the arguments may
+    // refer to elements of *this.
+    template<typename... Args>
+    T* emplace(T* pos, Args&&... args) {
+        if (pos < begin() || pos > end()) throw std::out_of_range("MyCompactVector::emplace");
+        const size_t idx = static_cast<size_t>(pos - begin());
+        if (idx == size()) return &emplace_back(std::forward<Args>(args)...);
+        T value(std::forward<Args>(args)...);
+        return insert_with(idx, 1, [&](T* gap) { new (gap) T(std::move(value)); });
+    }
+
+    T* insert(T* pos, const T& value) { return emplace(pos, value); }
+    T* insert(T* pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    // Inserts [first, last), which must not point into *this.
+    template<std::forward_iterator ForwardIt>
+    T* insert(T* pos, ForwardIt first, ForwardIt last) {
+        if (pos < begin() || pos > end()) throw std::out_of_range("MyCompactVector::insert");
+        const size_t idx = static_cast<size_t>(pos - begin());
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        return insert_with(idx, count, [&](T* gap) { std::uninitialized_copy(first, last, gap); });
+    }
+
+    T* erase(T* pos) {
+        if (pos < begin() || pos >= end()) throw std::out_of_range("MyCompactVector::erase");
+        return erase(pos, pos + 1);
+    }
+
+    T* erase(T* first, T* last) {
+        if (first < begin() || last > end() || first > last) throw std::out_of_range("MyCompactVector::erase");
+        const size_t idx = static_cast<size_t>(first - begin());
+        const size_t count = static_cast<size_t>(last - first);
+        const size_t n = size();
+        if constexpr (kShiftSafe) {
+            my_storage::destroy(first, last);
+            shift_left(idx + count, n, count);
+        } else {
+            std::move(last, end(), first);
+            my_storage::destroy(end() - count, end());
+        }
+        set_size(n - count);
+        return data_ + idx;
+    }
+
+    auto operator<=>(const MyCompactVector& other) const {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+
+    bool operator==(const MyCompactVector& other) const {
+        return size() == other.size() && std::equal(begin(), end(), other.begin());
+    }
+};
+
+// 8-byte variant for the innermost level of very large nested structures.
+template<typename T>
+using MyThinVector = MyCompactVector<T, CompactLayout::heap_header>;
+
+#endif // MY_COMPACT_VECTOR_H
@@ -0,0 +1,224 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_EXPR_H
+#define MY_EXPR_H
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_array.h"
+#include "my_span.h"
+#include "my_vector.h"
+
+// Lazy element-wise arithmetic on numeric MyVector / MyArray (and views of
+// them: MySpan, MyStridedView):
+//
+//     MyVector<double> r = a * 2.0 + b - c;   // one pass, no temporaries
+//     double s = my::sum(a * b);               // reductions take expressions too
+//
+// Operators build small expression nodes; the loop runs when the result is
+// assigned to (or constructed as) a MyVector or MyArray, or reduced. Operand
+// sizes are checked once, when a node is built. Nodes refer to their
+// containers, so an expression must not outlive them (don't keep `auto e =`
+// around past the statement that uses it).
+namespace my_expr {
+
+// Nodes carry this tag; MyVector and MyArray accept anything that has it.
+template<typename E>
+concept Expression = requires { typename std::remove_cvref_t<E>::my_expression_tag; };
+
+template<typename T>
+inline constexpr bool is_container_v = false;
+template<typename T>
+inline constexpr bool is_container_v<MyVector<T>> = std::is_arithmetic_v<T>;
+template<typename T, size_t N>
+inline constexpr bool is_container_v<MyArray<T, N>> = std::is_arithmetic_v<T>;
+template<typename T>
+inline constexpr bool is_container_v<MySpan<T>> = std::is_arithmetic_v<T>;
+template<typename T>
+inline constexpr bool is_container_v<MyStridedView<T>> = std::is_arithmetic_v<T>;
+
+// Anything that can sit in an expression next to a scalar.
+template<typename T>
+concept Operand = Expression<T> || is_container_v<std::remove_cvref_t<T>>;
+
+// Size reported by scalars: they broadcast to any length.
+inline constexpr size_t kAnySize = static_cast<size_t>(-1);
+
+inline size_t common_size(size_t a, size_t b) {
+    if (a == kAnySize) return b;
+    if (b != kAnySize && a != b) throw std::invalid_argument("my_expr: operand sizes differ");
+    return a;
+}
+
+template<typename T>
+struct Terminal {
+    using my_expression_tag = void;
+    using value_type = T;
+    const T* data;
+    size_t n;
+
+    size_t size() const noexcept { return n; }
+    T operator[](size_t i) const noexcept { return data[i]; }
+};
+
+template<typename T>
+struct StridedTerminal {
+    using my_expression_tag = void;
+    using value_type = T;
+    const T* data;
+    size_t n;
+    size_t stride;
+
+    size_t size() const noexcept { return n; }
+    T operator[](size_t i) const noexcept { return data[i * stride]; }
+};
+
+template<typename T>
+struct Scalar {
+    using my_expression_tag = void;
+    using value_type = T;
+    T value;
+
+    size_t size() const noexcept { return kAnySize; }
+    T operator[](size_t) const noexcept { return value; }
+};
+
+template<typename Op, typename L, typename R>
+struct Binary {
+    using my_expression_tag = void;
+    using value_type = decltype(Op()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+    L lhs;
+    R rhs;
+    size_t n;
+
+    Binary(L l, R r) : lhs(l), rhs(r), n(common_size(l.size(), r.size())) {}
+
+    size_t size() const noexcept { return n; }
+    value_type operator[](size_t i) const { return Op()(lhs[i], rhs[i]); }
+};
+
+template<typename Op, typename E>
+struct Unary {
+    using my_expression_tag = void;
+    using value_type = decltype(Op()(std::declval<typename E::value_type>()));
+    E arg;
+
+    size_t size() const noexcept { return arg.size(); }
+    value_type operator[](size_t i) const { return Op()(arg[i]); }
+};
+
+struct Sqrt {
+    template<typename T>
+    auto operator()(T x) const { return std::sqrt(x); }
+};
+
+struct Abs {
+    template<typename T>
+    auto operator()(T x) const { return std::abs(x); }
+};
+
+template<typename T>
+Terminal<T> as_expr(const MyVector<T>& v) noexcept { return {v.begin(), v.size()}; }
+template<typename T, size_t N>
+Terminal<T> as_expr(const MyArray<T, N>& a) noexcept { return {a.begin(), N}; }
+template<typename T>
+Terminal<std::remove_const_t<T>> as_expr(MySpan<T> s) noexcept { return {s.data(), s.size()}; }
+template<typename T>
+StridedTerminal<std::remove_const_t<T>> as_expr(MyStridedView<T> s) noexcept { return {s.data(), s.size(), s.stride()}; }
+template<Expression E>
+const E& as_expr(const E& e) noexcept { return e; }
+template<typename T>
+    requires std::is_arithmetic_v<T>
+Scalar<T> as_expr(T value) noexcept { return {value}; }
+
+template<typename T>
+using expr_t = std::remove_cvref_t<decltype(as_expr(std::declval<const T&>()))>;
+
+template<typename Op, typename A, typename B>
+Binary<Op, expr_t<A>, expr_t<B>> make_binary(const A& a, const B& b) {
+    return {as_expr(a), as_expr(b)};
+}
+
+} // namespace my_expr
+
+template<typename A, typename B>
+    requires (my_expr::Operand<A> && (my_expr::Operand<B> || std::is_arithmetic_v<B>))
+             || (std::is_arithmetic_v<A> && my_expr::Operand<B>)
+auto operator+(const A& a, const B& b) { return my_expr::make_binary<std::plus<>>(a, b); }
+
+template<typename A, typename B>
+    requires (my_expr::Operand<A> && (my_expr::Operand<B> || std::is_arithmetic_v<B>))
+             || (std::is_arithmetic_v<A> && my_expr::Operand<B>)
+auto operator-(const A& a, const B& b) { return my_expr::make_binary<std::minus<>>(a, b); }
+
+template<typename A, typename B>
+    requires (my_expr::Operand<A> && (my_expr::Operand<B> || std::is_arithmetic_v<B>))
+             || (std::is_arithmetic_v<A> && my_expr::Operand<B>)
+auto operator*(const A& a, const B& b) { return my_expr::make_binary<std::multiplies<>>(a, b); }
+
+template<typename A, typename B>
+    requires (my_expr::Operand<A> && (my_expr::Operand<B> || std::is_arithmetic_v<B>))
+             || (std::is_arithmetic_v<A> && my_expr::Operand<B>)
+auto operator/(const A& a, const B& b) { return my_expr::make_binary<std::divides<>>(a, b); }
+
+template<my_expr::Operand A>
+auto operator-(const A& a) { return my_expr::Unary<std::negate<>, my_expr::expr_t<A>>{my_expr::as_expr(a)}; }
+
+namespace my {
+
+template<my_expr::Operand A>
+auto sqrt(const A& a) { return my_expr::Unary<my_expr::Sqrt, my_expr::expr_t<A>>{my_expr::as_expr(a)}; }
+
+template<my_expr::Operand A>
+auto abs(const A& a) { return my_expr::Unary<my_expr::Abs, my_expr::expr_t<A>>{my_expr::as_expr(a)}; }
+
+// Reductions evaluate the expression in one pass without materializing it.
+// sum/dot keep four partial sums, so floating-point results may differ from
+// a strictly left-to-right sum in the last bits.
+template<my_expr::Operand A>
+auto sum(const A& a) {
+    const auto& e = my_expr::as_expr(a);
+    using V = typename my_expr::expr_t<A>::value_type;
+    const size_t n = e.size();
+    V acc[4] = {V(), V(), V(), V()};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc[0] += e[i];
+        acc[1] += e[i + 1];
+        acc[2] += e[i + 2];
+        acc[3] += e[i + 3];
+    }
+    for (; i < n; ++i) acc[0] += e[i];
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template<my_expr::Operand A, my_expr::Operand B>
+auto dot(const A& a, const B& b) { return sum(a * b); }
+
+template<my_expr::Operand A>
+auto min(const A& a) {
+    const auto& e = my_expr::as_expr(a);
+    if (e.size() == 0) throw std::out_of_range("my::min");
+    auto best = e[0];
+    for (size_t i = 1; i < e.size(); ++i) best = e[i] < best ? e[i] : best;
+    return best;
+}
+
+template<my_expr::Operand A>
+auto max(const A& a) {
+    const auto& e = my_expr::as_expr(a);
+    if (e.size() == 0) throw std::out_of_range("my::max");
+    auto best = e[0];
+    for (size_t i = 1; i < e.size(); ++i) best = best < e[i] ? e[i] : best;
+    return best;
+}
+
+} // namespace my
+
+#endif // MY_EXPR_H
@@ -0,0 +1,136 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "my_sorted_vector.h"
+#include "my_span.h"
+#include "my_vector.h"
+
+// Read-mostly associative array: unique keys in a MySortedVector and the
+// values in a parallel MyVector, so searches only touch the dense key array.
+template<typename K, typename V, typename Compare = std::less<K>>
+class MyFlatMap {
+private:
+    MySortedVector<K, Compare> keys_;
+    MyVector<V> values_;
+    Compare comp_;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit MyFlatMap(SortedLayout layout = SortedLayout::sorted, Compare comp = Compare())
+        : keys_(layout, comp), comp_(comp) {}
+
+    // Bulk build: sorts once; for duplicate keys the first occurrence wins.
+    explicit MyFlatMap(MyVector<std::pair<K, V>> items, SortedLayout layout = SortedLayout::sorted,
+                       Compare comp = Compare())
+        : keys_(layout, comp), comp_(comp) {
+        std::stable_sort(items.begin(), items.end(),
+                         [&](const auto& a, const auto& b) { return comp_(a.first, b.first); });
+        MyVector<K> keys;
+        keys.reserve(items.size());
+        values_.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (!keys.is_empty() && !comp_(keys.back(), items[i].first)) continue;
+            keys.push_back(items[i].first);
+            values_.push_back(items[i].second);
+        }
+        keys_ = MySortedVector<K, Compare>(std::move(keys), layout, comp);
+    }
+
+    bool is_empty() const noexcept { return keys_.is_empty(); }
+    size_t size() const noexcept { return keys_.size(); }
+    SortedLayout layout() const noexcept { return keys_.layout(); }
+    void set_layout(SortedLayout layout) { keys_.set_layout(layout); }
+
+    // Keys in sorted order and the values at the same positions.
+    const MySortedVector<K, Compare>& keys() const noexcept { return keys_; }
+    const MyVector<V>& values() const noexcept { return values_; }
+    MyVector<V>& values() noexcept { return values_; }
+
+    // Position of `key` in keys()/values(), or npos.
+    size_t index_of(const K& key) const {
+        size_t i = keys_.find(key);
+        return i == keys_.size() ? npos : i;
+    }
+
+    V* find(const K& key) {
+        size_t i = index_of(key);
+        return i == npos ? nullptr : &values_[i];
+    }
+    const V* find(const K& key) const {
+        size_t i = index_of(key);
+        return i == npos ? nullptr : &values_[i];
+    }
+
+    bool contains(const K& key) const { return index_of(key) != npos; }
+
+    V& at(const K& key) {
+        V* v = find(key);
+        if (!v) throw std::out_of_range("MyFlatMap::at");
+        return *v;
+    }
+    const V& at(const K& key) const {
+        const V* v = find(key);
+        if (!v) throw std::out_of_range("MyFlatMap::at");
+        return *v;
+    }
+
+    // Batched lookup: `out[i]` receives the position of keys[i] or npos.
+    void find_many(const K* keys, size_t count, size_t* out) const {
+        keys_.lower_bound_many(keys, count, out);
+        for (size_t i = 0; i < count; ++i) {
+            size_t pos = out[i];
+            if (pos == keys_.size() || comp_(keys[i], keys_[pos])) out[i] = npos;
+        }
+    }
+
+    void find_many(MySpan<const K> keys, MySpan<size_t> out) const {
+        if (out.size() < keys.size()) throw std::out_of_range("MyFlatMap::find_many");
+        find_many(keys.data(), keys.size(), out.data());
+    }
+
+    MyVector<size_t> find_many(const MyVector<K>& keys) const {
+        MyVector<size_t> out(keys.size(), 0);
+        find_many(keys.begin(), keys.size(), out.begin());
+        return out;
+    }
+
+    // O(n) insertion; returns false (and keeps the old value) if the key exists.
+    bool insert(const K& key, const V& value) {
+        if (contains(key)) return false;
+        size_t i = keys_.insert(key);
+        values_.insert(values_.begin() + i, value);
+        return true;
+    }
+
+    void insert_or_assign(const K& key, const V& value) {
+        if (V* v = find(key)) *v = value;
+        else insert(key, value);
+    }
+
+    bool erase(const K& key) {
+        size_t i = index_of(key);
+        if (i == npos) return false;
+        keys_.erase_at(i);
+        values_.erase(values_.begin() + i);
+        return true;
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+};
+
+#endif // MY_FLAT_MAP_H
@@ -0,0 +1,304 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_GAP_VECTOR_H
+#define MY_GAP_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_storage.h"
+#include "my_vector.h"
+
+// Gap buffer: one allocation holding [elements | gap | elements]. Inserting or
+// erasing at the gap (the "cursor") is O(1) amortized; moving the cursor by d
+// positions costs d element moves, so edits near the last edit are cheap.
+// Positions are logical indices in [0, size()], the gap is invisible to readers.
+template<typename T>
+class MyGapVector {
+private:
+    T* data_;
+    size_t capacity_;
+    size_t gap_begin_;  // physical index of the first free slot == cursor
+    size_t gap_end_;    // physical index one past the last free slot
+
+    size_t gap_size() const noexcept { return gap_end_ - gap_begin_; }
+    size_t physical(size_t index) const noexcept {
+        return index < gap_begin_ ? index : index + gap_size();
+    }
+
+    // Move-constructs data_[from] into the free slot data_[to] and destroys the source.
+    static void shift_one(T* data, size_t from, size_t to) {
+        new (&data[to]) T(std::move_if_noexcept(data[from]));
+        data[from].~T();
+    }
+
+    // Grows the gap to at least `extra` slots, keeping it at the cursor.
+    void grow(size_t extra) {
+        size_t size = this->size();
+        size_t new_cap = std::max(capacity_ ? capacity_ * 2 : 1, size + extra);
+        T* new_data = my_storage::allocate<T>(new_cap);
+        size_t tail = capacity_ - gap_end_;
+        size_t new_gap_end = new_cap - tail;
+        my_storage::relocate(data_, gap_begin_, new_data);
+        my_storage::relocate(data_ + gap_end_, tail, new_data + new_gap_end);
+        my_storage::deallocate(data_);
+        data_ = new_data;
+        capacity_ = new_cap;
+        gap_end_ = new_gap_end;
+    }
+
+    template<bool Const>
+    class Iterator {
+        using Gap = std::conditional_t<Const, const MyGapVector, MyGapVector>;
+        Gap* vec_ = nullptr;
+        size_t index_ = 0;
+
+        friend class MyGapVector;
+        template<bool> friend class Iterator;
+        Iterator(Gap* vec, size_t index) : vec_(vec), index_(index) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        operator Iterator<true>() const { return Iterator<true>(vec_, index_); }
+
+        size_t index() const noexcept { return index_; }
+
+        reference operator*() const { return (*vec_)[index_]; }
+        pointer operator->() const { return &(*vec_)[index_]; }
+        reference operator[](difference_type n) const { return (*vec_)[index_ + n]; }
+
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+        Iterator& operator--() { --index_; return *this; }
+        Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+        Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(vec_, index_ + n); }
+        Iterator operator-(difference_type n) const { return Iterator(vec_, index_ - n); }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+        difference_type operator-(const Iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        auto operator<=>(const Iterator& other) const { return index_ <=> other.index_; }
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    MyGapVector() noexcept
+        : data_(nullptr), capacity_(0), gap_begin_(0), gap_end_(0) {}
+
+    MyGapVector(std::initializer_list<T> init) : MyGapVector() {
+        reserve(init.size());
+        for (const auto& item : init)
+            push_back(item);
+    }
+
+    MyGapVector(const MyGapVector& other) : MyGapVector() {
+        reserve(other.size());
+        for (const auto& item : other)
+            push_back(item);
+    }
+
+    MyGapVector(MyGapVector&& other) noexcept
+        : data_(other.data_), capacity_(other.capacity_),
+          gap_begin_(other.gap_begin_), gap_end_(other.gap_end_) {
+        other.data_ = nullptr;
+        other.capacity_ = other.gap_begin_ = other.gap_end_ = 0;
+    }
+
+    ~MyGapVector() {
+        clear();
+        my_storage::deallocate(data_);
+    }
+
+    MyGapVector& operator=(const MyGapVector& other) {
+        if (this != &other) {
+            MyGapVector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    MyGapVector& operator=(MyGapVector&& other) noexcept {
+        if (this != &other) {
+            MyGapVector temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    T& operator[](size_t index) noexcept { return data_[physical(index)]; }
+    const T& operator[](size_t index) const noexcept { return data_[physical(index)]; }
+
+    T& at(size_t index) {
+        if (index >= size()) throw std::out_of_range("MyGapVector::at");
+        return (*this)[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= size()) throw std::out_of_range("MyGapVector::at");
+        return (*this)[index];
+    }
+
+    T& front() {
+        if (is_empty()) throw std::out_of_range("MyGapVector::front");
+        return (*this)[0];
+    }
+    const T& front() const {
+        if (is_empty()) throw std::out_of_range("MyGapVector::front");
+        return (*this)[0];
+    }
+
+    T& back() {
+        if (is_empty()) throw std::out_of_range("MyGapVector::back");
+        return (*this)[size() - 1];
+    }
+    const T& back() const {
+        if (is_empty()) throw std::out_of_range("MyGapVector::back");
+        return (*this)[size() - 1];
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size()); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool is_empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept { return capacity_ - gap_size(); }
+    size_t capacity() const noexcept { return capacity_; }
+    size_t cursor() const noexcept { return gap_begin_; }
+
+    void reserve(size_t new_cap) {
+        if (new_cap > capacity_) grow(new_cap - size());
+    }
+
+    void clear() noexcept {
+        my_storage::destroy(data_, data_ + gap_begin_);
+        my_storage::destroy(data_ + gap_end_, data_ + capacity_);
+        gap_begin_ = 0;
+        gap_end_ = capacity_;
+    }
+
+    void swap(MyGapVector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+    }
+
+    // Moves the gap so that it starts before logical index `pos`.
+    void move_cursor(size_t pos) {
+        if (pos > size()) throw std::out_of_range("MyGapVector::move_cursor");
+        if (pos == gap_begin_) return;
+        size_t gap = gap_size();
+        if (gap == 0) {
+            gap_begin_ = gap_end_ = pos;
+            return;
+        }
+        if (pos < gap_begin_) {
+            size_t count = gap_begin_ - pos;
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memmove(static_cast<void*>(data_ + pos + gap), static_cast<const void*>(data_ + pos),
+                             count * sizeof(T));
+            } else {
+                for (size_t i = gap_begin_; i-- > pos;)
+                    shift_one(data_, i, i + gap);
+            }
+        } else {
+            size_t count = pos - gap_begin_;
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memmove(static_cast<void*>(data_ + gap_begin_), static_cast<const void*>(data_ + gap_end_),
+                             count * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; ++i)
+                    shift_one(data_, gap_end_ + i, gap_begin_ + i);
+            }
+        }
+        gap_begin_ = pos;
+        gap_end_ = pos + gap;
+    }
+
+    template<typename... Args>
+    T& emplace(size_t pos, Args&&... args) {
+        if (pos > size()) throw std::out_of_range("MyGapVector::emplace");
+        if (pos == gap_begin_ && gap_size() != 0) {
+            // Nothing moves, so args stay valid even if they refer to an element.
+            new (&data_[gap_begin_]) T(std::forward<Args>(args)...);
+            return data_[gap_begin_++];
+        }
+        // Build the element first: args may refer to an element that moving
+        // the gap is about to relocate.
+        T value(std::forward<Args>(args)...);
+        if (gap_size() == 0) grow(1);
+        move_cursor(pos);
+        new (&data_[gap_begin_]) T(std::move(value));
+        return data_[gap_begin_++];
+    }
+
+    T& insert(size_t pos, const T& value) { return emplace(pos, value); }
+    T& insert(size_t pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    // Inserts at the cursor and leaves the cursor after the new element.
+    T& insert_at_cursor(const T& value) { return emplace(gap_begin_, value); }
+
+    void push_back(const T& value) { emplace(size(), value); }
+    void push_back(T&& value) { emplace(size(), std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) { return emplace(size(), std::forward<Args>(args)...); }
+
+    void erase(size_t pos) { erase(pos, pos + 1); }
+
+    // Erases [first, last); the cursor ends up at `first`.
+    void erase(size_t first, size_t last) {
+        if (first > last || last > size()) throw std::out_of_range("MyGapVector::erase");
+        move_cursor(first);
+        my_storage::destroy(data_ + gap_end_, data_ + gap_end_ + (last - first));
+        gap_end_ += last - first;
+    }
+
+    void pop_back() {
+        if (is_empty()) throw std::out_of_range("MyGapVector::pop_back");
+        erase(size() - 1);
+    }
+
+    // Moves the gap to the end so all elements are contiguous and returns them.
+    T* as_contiguous() {
+        move_cursor(size());
+        return data_;
+    }
+
+    // Copies the elements into a new MyVector.
+    MyVector<T> to_vector() const {
+        MyVector<T> out;
+        out.reserve(size());
+        for (size_t i = 0; i < gap_begin_; ++i) out.push_back(data_[i]);
+        for (size_t i = gap_end_; i < capacity_; ++i) out.push_back(data_[i]);
+        return out;
+    }
+
+    bool operator==(const MyGapVector& other) const {
+        return size() == other.size() && std::equal(begin(), end(), other.begin());
+    }
+};
+
+#endif // MY_GAP_VECTOR_H
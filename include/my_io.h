@@ -0,0 +1,318 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_IO_H
+#define MY_IO_H
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "my_span.h"
+#include "my_vector.h"
+
+// Streaming file input for MyVector: a background thread reads the file in
+// large pread() calls into two buffers while the caller parses the other
+// one, so I/O and parsing overlap and only two chunks are ever in memory.
+//
+//     my_io::ChunkReader reader("data.bin");
+//     for (MySpan<const char> chunk : reader) ...;       // raw chunks
+//     my_io::for_each_line("results.csv", [](std::string_view line) { ... });
+//     MyVector<double> xs = my_io::load_binary<double>("xs.bin");
+//
+// POSIX only. System call failures throw std::system_error, malformed input
+// std::runtime_error.
+namespace my_io {
+
+inline constexpr size_t kDefaultChunkBytes = size_t(4) << 20;
+
+[[noreturn]] inline void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Sequential reader with one chunk in flight ahead of the consumer.
+class ChunkReader {
+private:
+    struct Buffer {
+        std::unique_ptr<char[]> data;
+        size_t bytes = 0;
+        bool ready = false;    // filled by the reader, not yet released by the consumer
+    };
+
+    int fd_ = -1;
+    std::string path_;
+    size_t file_size_ = 0;
+    size_t chunk_bytes_;
+    Buffer buffers_[2];
+    size_t next_ = 0;          // buffer the consumer takes next
+    bool holding_ = false;     // consumer still uses buffers_[next_ ^ 1]
+    bool done_ = false;        // reader reached the end (or failed)
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread thread_;
+
+    // Fills `buf` from `offset`; short only at the end of the file.
+    size_t fill(char* buf, size_t offset) {
+        size_t got = 0;
+        while (got < chunk_bytes_) {
+            ssize_t r = ::pread(fd_, buf + got, chunk_bytes_ - got, static_cast<off_t>(offset + got));
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                throw_errno("my_io: read " + path_);
+            }
+            if (r == 0) break;
+            got += static_cast<size_t>(r);
+        }
+        return got;
+    }
+
+    void read_loop() {
+        size_t offset = 0;
+        for (size_t i = 0;; i ^= 1) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                changed_.wait(lock, [&] { return stop_ || !buffers_[i].ready; });
+                if (stop_) return;
+            }
+            size_t bytes = 0;
+            try {
+                bytes = fill(buffers_[i].data.get(), offset);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+                done_ = true;
+                changed_.notify_all();
+                return;
+            }
+            offset += bytes;
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffers_[i].bytes = bytes;
+            buffers_[i].ready = true;
+            if (bytes < chunk_bytes_) done_ = true;
+            changed_.notify_all();
+            if (done_) return;
+        }
+    }
+
+public:
+    // `chunk_bytes` is rounded down to a multiple of `record_bytes`, so fixed
+    // size records never straddle two chunks.
+    explicit ChunkReader(const std::string& path, size_t chunk_bytes = kDefaultChunkBytes, size_t record_bytes = 1)
+        : path_(path) {
+        record_bytes = std::max<size_t>(record_bytes, 1);
+        chunk_bytes_ = std::max(chunk_bytes / record_bytes, size_t(1)) * record_bytes;
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) throw_errno("my_io: open " + path);
+        // The destructor does not run if this throws. The exception has
+        // already captured errno when close() runs.
+        try {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) throw_errno("my_io: stat " + path);
+            file_size_ = static_cast<size_t>(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            for (auto& b : buffers_) b.data.reset(new char[chunk_bytes_]);
+            thread_ = std::thread([this] { read_loop(); });
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+
+    ~ChunkReader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+        ::close(fd_);
+    }
+
+    size_t file_size() const noexcept { return file_size_; }
+    size_t chunk_bytes() const noexcept { return chunk_bytes_; }
+
+    // Releases the previous chunk and returns the next one; an empty span
+    // means end of file. The span stays valid until the following call.
+    MySpan<const char> next() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (holding_) {
+            buffers_[next_ ^ 1].ready = false;
+            holding_ = false;
+            changed_.notify_all();
+        }
+        Buffer& b = buffers_[next_];
+        changed_.wait(lock, [&] { return b.ready || done_; });
+        if (!b.ready) {
+            if (error_) std::rethrow_exception(error_);
+            return {};
+        }
+        next_ ^= 1;
+        holding_ = true;
+        if (b.bytes == 0) return {};
+        return MySpan<const char>(b.data.get(), b.bytes);
+    }
+
+    // Single-pass iteration over the chunks.
+    class iterator {
+        ChunkReader* reader_ = nullptr;
+        MySpan<const char> chunk_;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = MySpan<const char>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        iterator() = default;
+        explicit iterator(ChunkReader* reader) : reader_(reader) { ++*this; }
+
+        reference operator*() const noexcept { return chunk_; }
+        pointer operator->() const noexcept { return &chunk_; }
+        iterator& operator++() {
+            chunk_ = reader_->next();
+            if (chunk_.is_empty()) reader_ = nullptr;
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator& other) const noexcept { return reader_ == other.reader_; }
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() noexcept { return iterator(); }
+};
+
+namespace detail {
+
+// Calls on_chunk(chunk) and then emit(line) for the lines completed by every
+// chunk. Lines that cross a chunk boundary are stitched in a side buffer.
+template<typename OnChunk, typename Emit>
+void split_lines(ChunkReader& reader, OnChunk on_chunk, Emit emit) {
+    std::string carry;
+    auto line_out = [&](std::string_view line) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        emit(line);
+    };
+    for (MySpan<const char> chunk : reader) {
+        on_chunk(chunk);
+        std::string_view rest(chunk.data(), chunk.size());
+        size_t eol = rest.find('\n');
+        if (!carry.empty()) {
+            carry.append(rest.substr(0, eol));
+            if (eol == std::string_view::npos) continue;
+            line_out(carry);
+            carry.clear();
+            rest.remove_prefix(eol + 1);
+            eol = rest.find('\n');
+        }
+        for (; eol != std::string_view::npos; eol = rest.find('\n')) {
+            line_out(rest.substr(0, eol));
+            rest.remove_prefix(eol + 1);
+        }
+        carry.assign(rest);
+    }
+    if (!carry.empty()) line_out(carry);
+}
+
+} // namespace detail
+
+// Calls f(line) for every line, without the '\n' (and a trailing '\r').
+template<typename F>
+void for_each_line(const std::string& path, F f, size_t chunk_bytes = kDefaultChunkBytes) {
+    ChunkReader reader(path, chunk_bytes);
+    detail::split_lines(reader, [](MySpan<const char>) {}, f);
+}
+
+// Appends parse(line) for every line to `out`. The capacity is reserved
+// once, from the file size and the average line length of the first chunk.
+template<typename T, typename Parse>
+void load_lines(const std::string& path, MyVector<T>& out, Parse parse, bool skip_header = false,
+                size_t chunk_bytes = kDefaultChunkBytes) {
+    ChunkReader reader(path, chunk_bytes);
+    bool reserved = false, header = skip_header;
+    detail::split_lines(reader, [&](MySpan<const char> chunk) {
+        if (std::exchange(reserved, true)) return;
+        const size_t lines = std::max<size_t>(1, static_cast<size_t>(std::count(chunk.begin(), chunk.end(), '\n')));
+        out.reserve(out.size() + reader.file_size() / std::max<size_t>(1, chunk.size() / lines) + 1);
+    }, [&](std::string_view line) {
+        if (std::exchange(header, false)) return;
+        out.push_back(parse(line));
+    });
+}
+
+// Appends the file, read as raw T values in native byte order, to `out`
+// with a single reserve(). Throws if the size is not a multiple of sizeof(T).
+template<typename T>
+void load_binary(const std::string& path, MyVector<T>& out, size_t chunk_bytes = kDefaultChunkBytes) {
+    static_assert(std::is_trivially_copyable_v<T>, "load_binary reads raw bytes");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "chunk buffers are only new-aligned");
+    ChunkReader reader(path, chunk_bytes, sizeof(T));
+    if (reader.file_size() % sizeof(T))
+        throw std::runtime_error("my_io::load_binary: size of " + path + " is not a multiple of the element size");
+    out.reserve(out.size() + reader.file_size() / sizeof(T));
+    for (MySpan<const char> chunk : reader) {
+        if (chunk.size() % sizeof(T))
+            throw std::runtime_error("my_io::load_binary: " + path + " changed while reading");
+        // Chunks start at the beginning of a buffer and hold whole records.
+        const T* first = reinterpret_cast<const T*>(chunk.data());
+        out.insert(out.end(), first, first + chunk.size() / sizeof(T));
+    }
+}
+
+template<typename T>
+MyVector<T> load_binary(const std::string& path, size_t chunk_bytes = kDefaultChunkBytes) {
+    MyVector<T> out;
+    load_binary(path, out, chunk_bytes);
+    return out;
+}
+
+// Writes the elements of `data` as raw bytes (the inverse of load_binary).
+template<typename T>
+void save_binary(const std::string& path, MySpan<const T> data) {
+    static_assert(std::is_trivially_copyable_v<T>, "save_binary writes raw bytes");
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw_errno("my_io: open " + path);
+    const char* p = reinterpret_cast<const char*>(data.data());
+    size_t left = data.size_bytes();
+    while (left) {
+        ssize_t w = ::write(fd, p, left);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            throw_errno("my_io: write " + path);
+        }
+        p += w;
+        left -= static_cast<size_t>(w);
+    }
+    if (::close(fd) != 0) throw_errno("my_io: close " + path);
+}
+
+} // namespace my_io
+
+#endif // MY_IO_H
@@ -0,0 +1,302 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_JAGGED_VECTOR_H
+#define MY_JAGGED_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "my_span.h"
+#include "my_vector.h"
+
+// Many short sequences stored back to back (compressed sparse row layout):
+// all elements in one MyVector, and row r is values()[offsets()[r],
+// offsets()[r + 1]). Two allocations in total instead of one per row, and a
+// full scan is a single linear pass.
+//
+//     MyJaggedVector<std::uint32_t> adj;
+//     adj.push_row({1, 2});        // row 0
+//     adj.push_row();              // row 1, then filled with push_back()
+//     adj.push_back(0);
+//     for (MySpan<const std::uint32_t> row : adj) ...;
+//
+// Appending rows, or elements to the last row, is amortized O(1). A row in
+// the middle that grows is moved to the end of the value array, and the
+// space it leaves (like space freed by shrinking a row) stays unused until
+// compact(). Spans returned by row access are invalidated by any change.
+template<typename T>
+class MyJaggedVector {
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    // Position of an edited row; begin == kNone for rows still in CSR order.
+    struct Extent {
+        size_t begin = kNone;
+        size_t end = 0;
+    };
+
+    MyVector<T> values_;
+    MyVector<size_t> offsets_{0};
+    MyVector<Extent> edited_;   // one per row once anything was edited, else empty
+    size_t live_ = 0;           // elements that belong to some row
+
+    bool is_edited(size_t r) const noexcept { return !edited_.is_empty() && edited_[r].begin != kNone; }
+
+    Extent extent(size_t r) const noexcept {
+        if (is_edited(r)) return edited_[r];
+        return {offsets_[r], offsets_[r + 1]};
+    }
+
+    void set_extent(size_t r, Extent e) {
+        if (edited_.is_empty()) edited_.resize(rows(), Extent{});
+        edited_[r] = e;
+    }
+
+    void check_row(size_t r, const char* what) const {
+        if (r >= rows()) throw std::out_of_range(what);
+    }
+
+    // True if elements appended to values_ extend row r in place.
+    bool at_tail(size_t r) const noexcept {
+        if (is_edited(r)) return edited_[r].end == values_.size();
+        return r + 1 == rows() && offsets_[r + 1] == values_.size();
+    }
+
+    // Starts a new, empty row at the end of values_.
+    void open_row() {
+        const size_t r = rows();
+        if (offsets_.back() != values_.size()) {
+            if (r > 0 && !is_edited(r - 1)) {
+                // The previous row still ends at offsets_.back(), so this row
+                // cannot start there; give it an explicit extent instead.
+                offsets_.push_back(offsets_.back());
+                edited_.resize(rows(), Extent{});
+                edited_[r] = {values_.size(), values_.size()};
+                return;
+            }
+            offsets_.back() = values_.size();
+        }
+        offsets_.push_back(values_.size());
+        if (!edited_.is_empty()) edited_.push_back(Extent{});
+    }
+
+    // Copies row r to the end of values_ (with room for `extra` more) and
+    // points the row there; the old place becomes unused.
+    void move_to_tail(size_t r, size_t extra) {
+        const Extent e = extent(r);
+        const size_t needed = values_.size() + (e.end - e.begin) + extra;
+        if (needed > values_.capacity()) values_.reserve(std::max(needed, values_.capacity() * 2));
+        const size_t begin = values_.size();
+        for (size_t i = e.begin; i < e.end; ++i) values_.push_back(values_[i]);
+        set_extent(r, {begin, values_.size()});
+    }
+
+public:
+    using value_type = T;
+
+    // Iterates over rows as MySpan<const T>. Dereferencing returns the span
+    // by value, so for the classic categories this is only an input
+    // iterator; iterator_concept still makes it a C++20 forward iterator.
+    class const_iterator {
+        const MyJaggedVector* owner_ = nullptr;
+        size_t row_ = 0;
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = MySpan<const T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = MySpan<const T>;
+
+        const_iterator() = default;
+        const_iterator(const MyJaggedVector* owner, size_t row) : owner_(owner), row_(row) {}
+
+        reference operator*() const noexcept { return (*owner_)[row_]; }
+        const_iterator& operator++() noexcept {
+            ++row_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator old = *this;
+            ++row_;
+            return old;
+        }
+        bool operator==(const const_iterator& other) const noexcept { return row_ == other.row_; }
+    };
+
+    MyJaggedVector() = default;
+
+    // Flattens a nested vector with one allocation per array.
+    explicit MyJaggedVector(const MyVector<MyVector<T>>& nested) {
+        size_t total = 0;
+        for (const auto& row : nested) total += row.size();
+        reserve(nested.size(), total);
+        for (const auto& row : nested) push_row(row.begin(), row.end());
+    }
+
+    size_t rows() const noexcept { return offsets_.size() - 1; }
+    size_t size() const noexcept { return live_; }
+    bool is_empty() const noexcept { return rows() == 0; }
+
+    // Elements no row uses any more (left behind by edits); compact() frees them.
+    size_t wasted() const noexcept { return values_.size() - live_; }
+
+    // Rows are in order and back to back, so values() and offsets() describe
+    // the whole structure (the plain CSR arrays).
+    bool is_compact() const noexcept { return edited_.is_empty() && offsets_.back() == values_.size(); }
+
+    const MyVector<T>& values() const noexcept { return values_; }
+
+    // Row boundaries; only meaningful when is_compact().
+    const MyVector<size_t>& offsets() const noexcept { return offsets_; }
+
+    MySpan<const T> operator[](size_t r) const noexcept {
+        const Extent e = extent(r);
+        return MySpan<const T>(values_.begin() + e.begin, e.end - e.begin);
+    }
+    MySpan<T> operator[](size_t r) noexcept {
+        const Extent e = extent(r);
+        return MySpan<T>(values_.begin() + e.begin, e.end - e.begin);
+    }
+
+    MySpan<const T> row(size_t r) const {
+        check_row(r, "MyJaggedVector::row");
+        return (*this)[r];
+    }
+    MySpan<T> row(size_t r) {
+        check_row(r, "MyJaggedVector::row");
+        return (*this)[r];
+    }
+
+    size_t row_size(size_t r) const {
+        check_row(r, "MyJaggedVector::row_size");
+        const Extent e = extent(r);
+        return e.end - e.begin;
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, rows()); }
+
+    void reserve(size_t rows, size_t values) {
+        offsets_.reserve(rows + 1);
+        values_.reserve(values);
+    }
+
+    void clear() noexcept {
+        values_.clear();
+        offsets_.resize(1);
+        offsets_[0] = 0;
+        edited_.clear();
+        live_ = 0;
+    }
+
+    // Appends a row with the elements of [first, last), which must not point
+    // into *this.
+    template<std::input_iterator InputIt>
+    void push_row(InputIt first, InputIt last) {
+        open_row();
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    void push_row(std::initializer_list<T> init) { push_row(init.begin(), init.end()); }
+    void push_row(MySpan<const T> row) { push_row(row.begin(), row.end()); }
+
+    // Appends an empty row, to be filled with push_back().
+    void push_row() { open_row(); }
+
+    // Appends `value` to the last row.
+    void push_back(const T& value) {
+        if (is_empty()) throw std::out_of_range("MyJaggedVector::push_back: no rows");
+        append_to_row(rows() - 1, value);
+    }
+
+    // Appends `value` to row r. Amortized O(1) for the last row and for a
+    // row that was just moved to the end; otherwise the row is moved first.
+    void append_to_row(size_t r, const T& value) {
+        check_row(r, "MyJaggedVector::append_to_row");
+        T copy(value);   // `value` may live in values_
+        if (!at_tail(r)) move_to_tail(r, 1);
+        values_.push_back(std::move(copy));
+        if (is_edited(r)) ++edited_[r].end;
+        else ++offsets_[r + 1];
+        ++live_;
+    }
+
+    // Replaces the contents of row r; grows in place only at the tail.
+    void assign_row(size_t r, MySpan<const T> row) {
+        check_row(r, "MyJaggedVector::assign_row");
+        if (row.data() >= values_.begin() && row.data() < values_.end()) {
+            MyVector<T> copy(row.begin(), row.end());
+            assign_row(r, MySpan<const T>(copy));
+            return;
+        }
+        const Extent e = extent(r);
+        const size_t old_size = e.end - e.begin;
+        if (row.size() <= old_size || at_tail(r)) {
+            const size_t common = std::min(old_size, row.size());
+            std::copy(row.begin(), row.begin() + common, values_.begin() + e.begin);
+            if (at_tail(r)) {
+                values_.erase(values_.begin() + e.begin + common, values_.end());
+                values_.insert(values_.end(), row.begin() + common, row.end());
+                if (is_edited(r)) edited_[r].end = values_.size();
+                else offsets_[r + 1] = values_.size();
+            } else if (row.size() < old_size) {
+                set_extent(r, {e.begin, e.begin + row.size()});
+            }
+        } else {
+            const size_t begin = values_.size();
+            values_.insert(values_.end(), row.begin(), row.end());
+            set_extent(r, {begin, values_.size()});
+        }
+        live_ = live_ - old_size + row.size();
+    }
+
+    void clear_row(size_t r) { assign_row(r, MySpan<const T>()); }
+
+    // Removes the last row.
+    void pop_row() {
+        if (is_empty()) throw std::out_of_range("MyJaggedVector::pop_row");
+        const size_t r = rows() - 1;
+        const Extent e = extent(r);
+        if (at_tail(r)) values_.erase(values_.begin() + e.begin, values_.end());
+        live_ -= e.end - e.begin;
+        offsets_.pop_back();
+        if (!edited_.is_empty()) edited_.pop_back();
+    }
+
+    // Rewrites the rows in order without gaps, after which the structure is
+    // plain CSR again (is_compact()). Linear in size(); allocates once.
+    void compact() {
+        if (is_compact()) return;
+        MyVector<T> values;
+        values.reserve(live_);
+        MyVector<size_t> offsets;
+        offsets.reserve(offsets_.size());
+        offsets.push_back(0);
+        for (size_t r = 0; r < rows(); ++r) {
+            const Extent e = extent(r);
+            for (size_t i = e.begin; i < e.end; ++i) values.push_back(std::move(values_[i]));
+            offsets.push_back(values.size());
+        }
+        values_ = std::move(values);
+        offsets_ = std::move(offsets);
+        edited_ = MyVector<Extent>();
+    }
+
+    bool operator==(const MyJaggedVector& other) const {
+        if (rows() != other.rows()) return false;
+        for (size_t r = 0; r < rows(); ++r) {
+            MySpan<const T> a = (*this)[r], b = other[r];
+            if (a.size() != b.size() || !std::equal(a.begin(), a.end(), b.begin())) return false;
+        }
+        return true;
+    }
+};
+
+#endif // MY_JAGGED_VECTOR_H
@@ -0,0 +1,288 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_NUMA_H
+#define MY_NUMA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "my_vector.h"
+
+// NUMA placement for large buffers, through raw mbind/move_pages syscalls so
+// there is no libnuma dependency. On other systems everything reports a
+// single node and placement calls return false.
+//
+// Placement is per page and only partial pages at the ends of a range are
+// skipped, so it matters for buffers of many pages (reserve() the vector
+// first, then place, then fill).
+namespace my_numa {
+
+// How a buffer's pages should be spread over the nodes.
+enum class Placement {
+    bind,          // all pages on one node
+    interleave,    // round-robin over all nodes
+    first_touch    // chunk k on the node of worker k (see first_touch())
+};
+
+namespace detail {
+
+inline constexpr int kBind = 2;         // MPOL_BIND
+inline constexpr int kInterleave = 3;   // MPOL_INTERLEAVE
+inline constexpr unsigned kMove = 2;    // MPOL_MF_MOVE
+inline constexpr size_t kMaxNodes = 64; // one mask word
+
+inline size_t page_size() noexcept {
+#ifdef __linux__
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+// Whole pages inside [p, p + bytes); false if there are none.
+inline bool page_range(const void* p, size_t bytes, std::uintptr_t& first, size_t& length) noexcept {
+    const std::uintptr_t page = page_size();
+    const auto begin = reinterpret_cast<std::uintptr_t>(p);
+    first = (begin + page - 1) & ~(page - 1);
+    const std::uintptr_t last = (begin + bytes) & ~(page - 1);
+    if (last <= first) return false;
+    length = last - first;
+    return true;
+}
+
+inline bool set_policy(const void* p, size_t bytes, int mode, std::uint64_t mask) noexcept {
+#ifdef __linux__
+    std::uintptr_t first;
+    size_t length;
+    if (!page_range(p, bytes, first, length)) return false;
+    return syscall(SYS_mbind, first, length, mode, &mask, kMaxNodes + 1, kMove) == 0;
+#else
+    (void)p, (void)bytes, (void)mode, (void)mask;
+    return false;
+#endif
+}
+
+inline std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+} // namespace detail
+
+// Parses a kernel cpu/node list such as "0-3,8,10-11".
+inline MyVector<int> parse_list(const std::string& text) {
+    MyVector<int> out;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        const std::string item = text.substr(pos, end - pos);
+        const size_t dash = item.find('-');
+        if (!item.empty()) {
+            const int lo = std::stoi(item.substr(0, dash));
+            const int hi = dash == std::string::npos ? lo : std::stoi(item.substr(dash + 1));
+            for (int v = lo; v <= hi; ++v) out.push_back(v);
+        }
+        pos = end + 1;
+    }
+    return out;
+}
+
+// Online memory nodes; {0} when the topology cannot be read.
+inline const MyVector<int>& nodes() {
+    static const MyVector<int> online = [] {
+        MyVector<int> list;
+#ifdef __linux__
+        try {
+            list = parse_list(detail::read_line("/sys/devices/system/node/online"));
+        } catch (const std::exception&) {
+            list.clear();
+        }
+#endif
+        if (list.is_empty()) list.push_back(0);
+        return list;
+    }();
+    return online;
+}
+
+inline size_t node_count() { return nodes().size(); }
+
+// CPUs of `node`; empty if unknown.
+inline MyVector<int> node_cpus(int node) {
+#ifdef __linux__
+    try {
+        return parse_list(detail::read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+    } catch (const std::exception&) {
+    }
+#else
+    (void)node;
+#endif
+    return {};
+}
+
+// Node the calling thread is running on.
+inline int current_node() noexcept {
+#ifdef __linux__
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+    return 0;
+}
+
+// Node holding the page that contains `p`, or -1 if the page is not
+// resident yet (or the query failed).
+inline int node_of(const void* p) noexcept {
+#ifdef __linux__
+    const auto page = reinterpret_cast<std::uintptr_t>(p) & ~(detail::page_size() - 1);
+    void* pages[1] = {reinterpret_cast<void*>(page)};
+    int status[1] = {-1};
+    if (syscall(SYS_move_pages, 0, 1, pages, nullptr, status, 0) == 0 && status[0] >= 0) return status[0];
+#else
+    (void)p;
+#endif
+    return -1;
+}
+
+// Resident pages of [p, p + bytes) per node: element n counts node n's pages.
+inline MyVector<size_t> pages_per_node(const void* p, size_t bytes) {
+    const int max_node = *std::max_element(nodes().begin(), nodes().end());
+    MyVector<size_t> counts(static_cast<size_t>(max_node) + 1, size_t(0));
+#ifdef __linux__
+    std::uintptr_t first;
+    size_t length;
+    if (!detail::page_range(p, bytes, first, length)) return counts;
+    const size_t page = detail::page_size(), batch = 1024;
+    MyVector<void*> pages(batch, nullptr);
+    MyVector<int> status(batch, 0);
+    for (size_t offset = 0; offset < length; offset += batch * page) {
+        const size_t count = std::min(batch, (length - offset) / page);
+        for (size_t i = 0; i < count; ++i) pages[i] = reinterpret_cast<void*>(first + offset + i * page);
+        if (syscall(SYS_move_pages, 0, count, pages.begin(), nullptr, status.begin(), 0) != 0) break;
+        for (size_t i = 0; i < count; ++i)
+            if (status[i] >= 0 && size_t(status[i]) < counts.size()) ++counts[size_t(status[i])];
+    }
+#else
+    (void)p, (void)bytes;
+#endif
+    return counts;
+}
+
+// Puts every whole page of the range on `node`; pages already present are
+// migrated.
+inline bool bind(const void* p, size_t bytes, int node) noexcept {
+    if (node < 0 || size_t(node) >= detail::kMaxNodes) return false;
+    return detail::set_policy(p, bytes, detail::kBind, std::uint64_t(1) << node);
+}
+
+// Spreads the pages round-robin over all online nodes.
+inline bool interleave(const void* p, size_t bytes) {
+    std::uint64_t mask = 0;
+    for (int n : nodes())
+        if (size_t(n) < detail::kMaxNodes) mask |= std::uint64_t(1) << n;
+    return detail::set_policy(p, bytes, detail::kInterleave, mask);
+}
+
+// Node that worker `worker` of `workers` should run on: workers are split
+// into contiguous groups, one per node, like MySpan::chunks() splits data.
+inline int node_for_worker(size_t worker, size_t workers) {
+    return nodes()[worker * node_count() / std::max<size_t>(workers, 1)];
+}
+
+// Pins the calling thread to the CPUs of `node` for its lifetime and
+// restores the previous affinity afterwards.
+class NodePin {
+private:
+#ifdef __linux__
+    cpu_set_t saved_;
+#endif
+    bool pinned_ = false;
+
+public:
+    explicit NodePin(int node) {
+#ifdef __linux__
+        if (pthread_getaffinity_np(pthread_self(), sizeof(saved_), &saved_) != 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : node_cpus(node))
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        if (CPU_COUNT(&set) == 0) return;
+        pinned_ = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)node;
+#endif
+    }
+
+    NodePin(const NodePin&) = delete;
+    NodePin& operator=(const NodePin&) = delete;
+
+    ~NodePin() {
+#ifdef __linux__
+        if (pinned_) pthread_setaffinity_np(pthread_self(), sizeof(saved_), &saved_);
+#endif
+    }
+
+    bool pinned() const noexcept { return pinned_; }
+};
+
+// Touches the range from `workers` threads, each pinned to
+// node_for_worker(k, workers) and writing one byte per page of its chunk,
+// so that untouched pages are allocated where that worker runs. Pages that
+// are already resident stay where they are (use bind() to move them).
+// Existing bytes are preserved.
+inline void first_touch(void* p, size_t bytes, size_t workers) {
+    workers = std::max<size_t>(workers, 1);
+    const size_t page = detail::page_size();
+    auto* base = static_cast<unsigned char*>(p);
+    auto touch = [&](size_t k) {
+        NodePin pin(node_for_worker(k, workers));
+        const size_t from = bytes / workers * k + std::min(k, bytes % workers);
+        const size_t to = from + bytes / workers + (k < bytes % workers);
+        for (size_t i = from; i < to; i += page) {
+            volatile unsigned char* byte = base + i;
+            *byte = *byte;
+        }
+    };
+    MyVector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t k = 1; k < workers; ++k) threads.emplace_back(touch, k);
+    touch(0);
+    for (auto& t : threads) t.join();
+}
+
+// Applies `placement` to the whole capacity of `v`. `node` is used by
+// Placement::bind, `workers` by Placement::first_touch. Returns false if
+// the kernel refused (or the system has no NUMA support).
+template<typename T>
+bool place(MyVector<T>& v, Placement placement, int node = 0, size_t workers = 1) {
+    const size_t bytes = v.capacity() * sizeof(T);
+    switch (placement) {
+    case Placement::bind:
+        return bind(v.begin(), bytes, node);
+    case Placement::interleave:
+        return interleave(v.begin(), bytes);
+    case Placement::first_touch:
+        first_touch(v.begin(), bytes, workers);
+        return true;
+    }
+    return false;
+}
+
+} // namespace my_numa
+
+#endif // MY_NUMA_H
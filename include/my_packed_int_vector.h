@@ -0,0 +1,315 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_PACKED_INT_VECTOR_H
+#define MY_PACKED_INT_VECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "my_simd.h"
+#include "my_span.h"
+#include "my_vector.h"
+
+namespace my_packing {
+
+inline unsigned bits_needed(std::uint64_t value) noexcept {
+    return static_cast<unsigned>(64 - std::countl_zero(value));
+}
+
+inline std::uint64_t width_mask(unsigned width) noexcept {
+    return width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+}
+
+// Words needed for `bits` bits plus the padding word the decoders read past the end.
+inline size_t words_for(size_t bits) noexcept { return (bits + 63) / 64 + 1; }
+
+inline std::uint64_t read_bits(const std::uint64_t* words, size_t bit, std::uint64_t mask) noexcept {
+    const size_t w = bit / 64, off = bit % 64;
+    return ((words[w] >> off) | ((words[w + 1] << 1) << (63 - off))) & mask;
+}
+
+// Grows `words` to at least `count` zeroed words, doubling the capacity.
+inline void grow_words(MyVector<std::uint64_t>& words, size_t count) {
+    if (words.size() >= count) return;
+    if (words.capacity() < count) words.reserve(std::max(count, words.capacity() * 2));
+    words.resize(count, 0);
+}
+
+// Overwrites `width` bits at `bit`; `value` must fit in `width` bits.
+inline void write_bits(std::uint64_t* words, size_t bit, unsigned width, std::uint64_t value) noexcept {
+    const size_t w = bit / 64, off = bit % 64;
+    const std::uint64_t mask = width_mask(width);
+    words[w] = (words[w] & ~(mask << off)) | (value << off);
+    if (off + width > 64) {
+        const size_t spill = 64 - off;
+        words[w + 1] = (words[w + 1] & ~(mask >> spill)) | (value >> spill);
+    }
+}
+
+} // namespace my_packing
+
+// Unsigned integers stored with a common bit width (0..64) in a packed bit
+// stream. Random access is O(1); writing a value that needs more bits
+// repacks everything at the wider width (at most 64 times over the lifetime).
+class MyPackedIntVector {
+private:
+    MyVector<std::uint64_t> words_;
+    size_t size_ = 0;
+    unsigned width_ = 0;
+    std::uint64_t mask_ = 0;
+
+    void ensure_words(size_t count) { my_packing::grow_words(words_, my_packing::words_for(count * width_)); }
+
+    void widen(unsigned width) {
+        MyPackedIntVector wider(width);
+        wider.reserve(size_);
+        std::uint64_t chunk[256];
+        for (size_t first = 0; first < size_; first += 256) {
+            size_t count = std::min<size_t>(256, size_ - first);
+            decode(first, count, chunk);
+            for (size_t i = 0; i < count; ++i) wider.push_back(chunk[i]);
+        }
+        swap(wider);
+    }
+
+public:
+    explicit MyPackedIntVector(unsigned width = 0)
+        : words_(1, std::uint64_t(0)), width_(std::min(width, 64u)), mask_(my_packing::width_mask(width_)) {}
+
+    // Packs `values` at the smallest width that holds all of them.
+    explicit MyPackedIntVector(const MyVector<std::uint64_t>& values) : MyPackedIntVector(0) {
+        std::uint64_t all = 0;
+        for (auto v : values) all |= v;
+        width_ = my_packing::bits_needed(all);
+        mask_ = my_packing::width_mask(width_);
+        ensure_words(values.size());
+        for (auto v : values) my_packing::write_bits(words_.begin(), size_++ * width_, width_, v);
+    }
+
+    MyPackedIntVector(std::initializer_list<std::uint64_t> init)
+        : MyPackedIntVector(MyVector<std::uint64_t>(init)) {}
+
+    std::uint64_t operator[](size_t index) const noexcept {
+        return my_packing::read_bits(words_.begin(), index * width_, mask_);
+    }
+
+    std::uint64_t at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MyPackedIntVector::at");
+        return (*this)[index];
+    }
+
+    bool is_empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    unsigned width() const noexcept { return width_; }
+    size_t memory_bytes() const noexcept { return words_.capacity() * sizeof(std::uint64_t); }
+
+    void reserve(size_t count) { words_.reserve(my_packing::words_for(count * width_)); }
+    void shrink_to_fit() {
+        words_.resize(my_packing::words_for(size_ * width_), 0);
+        words_.shrink_to_fit();
+    }
+
+    void set(size_t index, std::uint64_t value) {
+        if (index >= size_) throw std::out_of_range("MyPackedIntVector::set");
+        if (value > mask_) widen(my_packing::bits_needed(value));
+        my_packing::write_bits(words_.begin(), index * width_, width_, value);
+    }
+
+    void push_back(std::uint64_t value) {
+        if (value > mask_) widen(my_packing::bits_needed(value));
+        ensure_words(size_ + 1);
+        my_packing::write_bits(words_.begin(), size_++ * width_, width_, value);
+    }
+
+    void pop_back() {
+        if (size_ == 0) throw std::out_of_range("MyPackedIntVector::pop_back");
+        my_packing::write_bits(words_.begin(), --size_ * width_, width_, 0);
+    }
+
+    void clear() noexcept {
+        std::fill(words_.begin(), words_.end(), 0);
+        size_ = 0;
+    }
+
+    // Bulk decode of [first, first + count) into `out`.
+    void decode(size_t first, size_t count, std::uint64_t* out) const {
+        if (first + count > size_) throw std::out_of_range("MyPackedIntVector::decode");
+        my_simd::unpack_bits(words_.begin(), first * width_, width_, count, out);
+    }
+
+    // Fills `out` with the values starting at `first`.
+    void decode(size_t first, MySpan<std::uint64_t> out) const { decode(first, out.size(), out.data()); }
+
+    MyVector<std::uint64_t> decode() const {
+        MyVector<std::uint64_t> out(size_, 0);
+        decode(0, size_, out.begin());
+        return out;
+    }
+
+    bool operator==(const MyPackedIntVector& other) const {
+        if (size_ != other.size_) return false;
+        for (size_t i = 0; i < size_; ++i)
+            if ((*this)[i] != other[i]) return false;
+        return true;
+    }
+
+    void swap(MyPackedIntVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+        std::swap(width_, other.width_);
+        std::swap(mask_, other.mask_);
+    }
+};
+
+// How MyBlockPackedVector encodes each block of values.
+enum class BlockEncoding {
+    frame_of_reference,   // value - block minimum; O(1) random access
+    delta                 // difference to the previous value; needs non-decreasing values
+};
+
+// Append-only integer column split into blocks of kBlockSize values, each
+// packed at its own width. Values are kept raw in a tail buffer until a
+// block fills up. Delta blocks decode with a prefix sum, so random access
+// costs up to one block of work there.
+class MyBlockPackedVector {
+public:
+    static constexpr size_t kBlockSize = 128;
+
+private:
+    struct Block {
+        std::uint64_t base;   // block minimum (FOR) or first value (delta)
+        size_t first_bit;
+        unsigned width;
+    };
+
+    MyVector<Block> blocks_;
+    MyVector<std::uint64_t> words_;
+    MyVector<std::uint64_t> tail_;
+    size_t bits_ = 0;
+    BlockEncoding encoding_;
+
+    void seal() {
+        std::uint64_t base = tail_[0], spread = 0;
+        if (encoding_ == BlockEncoding::frame_of_reference) {
+            base = *std::min_element(tail_.begin(), tail_.end());
+            for (auto v : tail_) spread |= v - base;
+        } else {
+            for (size_t i = 1; i < tail_.size(); ++i) spread |= tail_[i] - tail_[i - 1];
+        }
+        const unsigned width = my_packing::bits_needed(spread);
+        blocks_.push_back({base, bits_, width});
+        my_packing::grow_words(words_, my_packing::words_for(bits_ + tail_.size() * width));
+        for (size_t i = 0; i < tail_.size(); ++i) {
+            std::uint64_t v = encoding_ == BlockEncoding::frame_of_reference ? tail_[i] - base
+                              : i == 0 ? 0 : tail_[i] - tail_[i - 1];
+            my_packing::write_bits(words_.begin(), bits_, width, v);
+            bits_ += width;
+        }
+        tail_.clear();
+    }
+
+    void decode_block(size_t block, size_t count, std::uint64_t* out) const {
+        const Block& b = blocks_[block];
+        my_simd::unpack_bits(words_.begin(), b.first_bit, b.width, count, out);
+        if (encoding_ == BlockEncoding::frame_of_reference) {
+            for (size_t i = 0; i < count; ++i) out[i] += b.base;
+        } else {
+            std::uint64_t running = b.base;
+            for (size_t i = 0; i < count; ++i) out[i] = running += out[i];
+        }
+    }
+
+public:
+    explicit MyBlockPackedVector(BlockEncoding encoding = BlockEncoding::frame_of_reference)
+        : words_(1, std::uint64_t(0)), encoding_(encoding) {
+        tail_.reserve(kBlockSize);
+    }
+
+    explicit MyBlockPackedVector(const MyVector<std::uint64_t>& values,
+                                 BlockEncoding encoding = BlockEncoding::frame_of_reference)
+        : MyBlockPackedVector(encoding) {
+        for (auto v : values) push_back(v);
+    }
+
+    BlockEncoding encoding() const noexcept { return encoding_; }
+    bool is_empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept { return blocks_.size() * kBlockSize + tail_.size(); }
+
+    size_t memory_bytes() const noexcept {
+        return words_.capacity() * sizeof(std::uint64_t) + blocks_.capacity() * sizeof(Block)
+               + tail_.capacity() * sizeof(std::uint64_t);
+    }
+
+    // Drops the growth slack once the column is complete.
+    void shrink_to_fit() {
+        words_.shrink_to_fit();
+        blocks_.shrink_to_fit();
+        tail_.shrink_to_fit();
+    }
+
+    void push_back(std::uint64_t value) {
+        if (encoding_ == BlockEncoding::delta && !is_empty() && value < back())
+            throw std::invalid_argument("MyBlockPackedVector::push_back: delta encoding needs sorted values");
+        tail_.push_back(value);
+        if (tail_.size() == kBlockSize) seal();
+    }
+
+    std::uint64_t operator[](size_t index) const {
+        const size_t block = index / kBlockSize, offset = index % kBlockSize;
+        if (block == blocks_.size()) return tail_[offset];
+        const Block& b = blocks_[block];
+        if (encoding_ == BlockEncoding::frame_of_reference)
+            return b.base + my_packing::read_bits(words_.begin(), b.first_bit + offset * b.width,
+                                                  my_packing::width_mask(b.width));
+        std::uint64_t values[kBlockSize];
+        decode_block(block, offset + 1, values);
+        return values[offset];
+    }
+
+    std::uint64_t at(size_t index) const {
+        if (index >= size()) throw std::out_of_range("MyBlockPackedVector::at");
+        return (*this)[index];
+    }
+
+    std::uint64_t back() const {
+        if (is_empty()) throw std::out_of_range("MyBlockPackedVector::back");
+        return (*this)[size() - 1];
+    }
+
+    // Bulk decode of [first, first + count) into `out`.
+    void decode(size_t first, size_t count, std::uint64_t* out) const {
+        if (first + count > size()) throw std::out_of_range("MyBlockPackedVector::decode");
+        std::uint64_t buffer[kBlockSize];
+        while (count) {
+            const size_t block = first / kBlockSize, offset = first % kBlockSize;
+            const size_t take = std::min(count, kBlockSize - offset);
+            if (block == blocks_.size()) {
+                std::copy(tail_.begin() + offset, tail_.begin() + offset + take, out);
+            } else if (offset == 0 && take == kBlockSize) {
+                decode_block(block, kBlockSize, out);
+            } else {
+                decode_block(block, offset + take, buffer);
+                std::copy(buffer + offset, buffer + offset + take, out);
+            }
+            first += take;
+            count -= take;
+            out += take;
+        }
+    }
+
+    // Fills `out` with the values starting at `first`.
+    void decode(size_t first, MySpan<std::uint64_t> out) const { decode(first, out.size(), out.data()); }
+
+    MyVector<std::uint64_t> decode() const {
+        MyVector<std::uint64_t> out(size(), 0);
+        decode(0, size(), out.begin());
+        return out;
+    }
+};
+
+#endif // MY_PACKED_INT_VECTOR_H
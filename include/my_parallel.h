@@ -0,0 +1,495 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_PARALLEL_H
+#define MY_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "my_algorithm.h"
+#include "my_ring_vector.h"
+#include "my_span.h"
+#include "my_vector.h"
+
+namespace my {
+
+// Fixed set of worker threads with one deque of range tasks each. A worker
+// pops from the back of its own deque and, when that is empty, steals from
+// the front of the others. Loop bodies split lazily: a task larger than its
+// grain pushes its upper half (which someone idle can steal) and keeps the
+// lower half, so work is divided only as far as the load needs it.
+//
+// The thread that calls run() takes part until its loop is done, running
+// only that loop's tasks, so nested loops inside a body cannot deadlock.
+// When none of them is left to take, it blocks until a task is pushed or
+// finished instead of spinning, leaving the core to the workers.
+class ThreadPool {
+public:
+    // A cache line; per-thread slots are padded to this to avoid false sharing.
+    static constexpr size_t kCacheLine = 64;
+
+    explicit ThreadPool(size_t threads = default_threads())
+        : queue_count_(std::max<size_t>(threads, 1)), queues_(new Queue[queue_count_]) {
+        workers_.reserve(queue_count_ - 1);
+        for (size_t w = 0; w + 1 < queue_count_; ++w)
+            workers_.emplace_back([this, w]() { worker_loop(w); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    static size_t default_threads() noexcept {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // Process-wide pool with default_threads() threads, started on first use.
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Threads that run loop bodies: the workers plus the calling thread.
+    size_t size() const noexcept { return queue_count_; }
+
+    // Distinct `slot` values passed to bodies; index per-thread state with them.
+    size_t slots() const noexcept { return queue_count_; }
+
+    // Grain that gives each thread about eight tasks (so stealing can even
+    // out imbalance), but no fewer than `min_grain` elements per task.
+    size_t grain_for(size_t n, size_t min_grain = 1024) const noexcept {
+        return std::max(min_grain, n / (size() * 8) + 1);
+    }
+
+    // Calls body(begin, end, slot) over pieces of [0, n) no longer than
+    // `grain`, in parallel; returns when all are done. At most one thread
+    // uses a given slot at a time. Rethrows the first exception a body threw
+    // (the remaining pieces are skipped).
+    template<typename Body>
+    void run(size_t n, size_t grain, const Body& body) {
+        if (n == 0) return;
+        Job job;
+        job.invoke = [](const void* b, size_t begin, size_t end, size_t slot) {
+            (*static_cast<const Body*>(b))(begin, end, slot);
+        };
+        job.body = &body;
+        job.grain = std::max<size_t>(grain, 1);
+        job.remaining.store(n, std::memory_order_relaxed);
+
+        const size_t slot = current_slot();
+        execute({&job, 0, n}, slot);
+        while (true) {
+            // Read before checking, so a task pushed or finished after the
+            // check changes events_ and the wait returns at once.
+            const std::uint32_t seen = events_.load(std::memory_order_acquire);
+            if (job.remaining.load(std::memory_order_acquire) == 0) break;
+            Task task;
+            if (take(slot, &job, task)) execute(task, slot);
+            else events_.wait(seen, std::memory_order_acquire);
+        }
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    struct Job {
+        void (*invoke)(const void*, size_t, size_t, size_t) = nullptr;
+        const void* body = nullptr;
+        size_t grain = 1;
+        std::atomic<size_t> remaining{0};       // elements not processed yet
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+    };
+
+    struct Task {
+        Job* job = nullptr;
+        size_t begin = 0, end = 0;
+    };
+
+    struct alignas(kCacheLine) Queue {
+        std::mutex mutex;
+        MyRingVector<Task> tasks;
+    };
+
+    size_t queue_count_;
+    std::unique_ptr<Queue[]> queues_;   // the last one is shared by outside callers
+    MyVector<std::thread> workers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> sleeping_{0};
+    // Bumped whenever a task is pushed or finished; callers of run() with
+    // nothing left to take block on it. The pool owns it because a job may
+    // be gone as soon as its last task is finished.
+    std::atomic<std::uint32_t> events_{0};
+    bool stop_ = false;
+
+    struct WorkerId {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerId& worker_id() noexcept {
+        thread_local WorkerId id;
+        return id;
+    }
+
+    // Workers own their slot; every other thread (including workers of other
+    // pools) uses the last one. That is safe because outside callers only run
+    // tasks of their own loop, and a loop has a single caller.
+    size_t current_slot() const noexcept {
+        const WorkerId& id = worker_id();
+        return id.pool == this ? id.index : queue_count_ - 1;
+    }
+
+    void push(size_t slot, const Task& task) {
+        {
+            std::lock_guard<std::mutex> lock(queues_[slot].mutex);
+            queues_[slot].tasks.push_back(task);
+        }
+        // Store-then-load on both sides (see worker_loop): seq_cst, so at
+        // least one side sees the other's store and no task is slept on.
+        queued_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_seq_cst) != 0) {
+            { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+            wake_.notify_one();
+        }
+        signal_event();
+    }
+
+    // Own deque from the back, then the others from the front. With `only`
+    // set, takes the newest task of that job wherever it sits in a deque.
+    bool take(size_t slot, const Job* only, Task& out) {
+        auto try_queue = [&](size_t q, bool back) {
+            Queue& queue = queues_[q];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks;
+            if (tasks.is_empty()) return false;
+            if (only) {
+                size_t i = tasks.size();
+                while (i > 0 && tasks[i - 1].job != only) --i;
+                if (i == 0) return false;
+                out = tasks[i - 1];
+                tasks[i - 1] = tasks.back();
+                tasks.pop_back();
+            } else if (back) {
+                out = tasks.back();
+                tasks.pop_back();
+            } else {
+                out = tasks.front();
+                tasks.pop_front();
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        };
+        if (try_queue(slot, true)) return true;
+        for (size_t i = 1; i < queue_count_; ++i)
+            if (try_queue((slot + i) % queue_count_, false)) return true;
+        return false;
+    }
+
+    void execute(Task task, size_t slot) {
+        Job& job = *task.job;
+        while (task.end - task.begin > job.grain) {
+            const size_t mid = task.begin + (task.end - task.begin) / 2;
+            push(slot, {&job, mid, task.end});
+            task.end = mid;
+        }
+        if (!job.failed.load(std::memory_order_relaxed)) {
+            try {
+                job.invoke(job.body, task.begin, task.end, slot);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.error_mutex);
+                if (!job.error) job.error = std::current_exception();
+                job.failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        job.remaining.fetch_sub(task.end - task.begin, std::memory_order_acq_rel);
+        signal_event();
+    }
+
+    void signal_event() noexcept {
+        events_.fetch_add(1, std::memory_order_release);
+        events_.notify_all();
+    }
+
+    void worker_loop(size_t w) {
+        worker_id() = {this, w};
+        while (true) {
+            Task task;
+            if (take(w, nullptr, task)) {
+                execute(task, w);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_seq_cst) != 0; });
+            sleeping_.fetch_sub(1, std::memory_order_acq_rel);
+            if (stop_) return;
+        }
+    }
+};
+
+// Data-parallel algorithms over MyVector, MyArray and MySpan, run on
+// ThreadPool::global() unless a pool is given. Elements are split into
+// tasks of ThreadPool::grain_for(n) elements. for_each, transform and
+// reduce also take a MyStridedView; the scans, histogram and partitions
+// read raw memory and only compile for contiguous ranges.
+namespace parallel {
+
+namespace detail {
+
+template<typename T>
+struct alignas(ThreadPool::kCacheLine) Partial {
+    T value{};
+    bool used = false;
+};
+
+template<typename C>
+auto as_span(C& c) noexcept {
+    if constexpr (requires { typename C::element_type; c.data(); }) return c;
+    else return MySpan(c);
+}
+
+template<typename C>
+using span_t = decltype(as_span(std::declval<C&>()));
+
+} // namespace detail
+
+// f(x) for every element, in no particular order.
+template<typename C, typename F>
+void for_each(C&& range, F f, ThreadPool& pool = ThreadPool::global()) {
+    auto s = detail::as_span(range);
+    pool.run(s.size(), pool.grain_for(s.size()), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) f(s[i]);
+    });
+}
+
+// out[i] = f(in[i]); `out` must have in.size() elements and may be `in`.
+template<typename In, typename Out, typename F>
+void transform(const In& in, Out&& out, F f, ThreadPool& pool = ThreadPool::global()) {
+    auto src = detail::as_span(in);
+    auto dst = detail::as_span(out);
+    if (src.size() != dst.size()) throw std::invalid_argument("my::parallel::transform: sizes differ");
+    pool.run(src.size(), pool.grain_for(src.size()), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) dst[i] = f(src[i]);
+    });
+}
+
+// Folds the elements with `op` starting from `init`. Pieces are combined in
+// whatever order threads finish them, so `op` must be associative and
+// commutative (floating-point sums can differ from a serial loop in the
+// last bits). Each thread accumulates into its own cache-line slot.
+template<typename C, typename T, typename Op = std::plus<>>
+T reduce(const C& range, T init, Op op = Op(), ThreadPool& pool = ThreadPool::global()) {
+    auto s = detail::as_span(range);
+    MyVector<detail::Partial<T>> partials(pool.slots(), detail::Partial<T>{});
+    pool.run(s.size(), pool.grain_for(s.size()), [&](size_t begin, size_t end, size_t slot) {
+        T acc = s[begin];
+        for (size_t i = begin + 1; i < end; ++i) acc = op(acc, s[i]);
+        auto& p = partials[slot];
+        p.value = p.used ? op(p.value, acc) : acc;
+        p.used = true;
+    });
+    for (const auto& p : partials)
+        if (p.used) init = op(init, p.value);
+    return init;
+}
+
+// out[i] = in[0] op ... op in[i]; `out` must have in.size() elements and
+// may be `in`. Two passes over fixed blocks: block totals in parallel, a
+// serial scan of the totals, then each block scanned from its offset.
+// `op` must be associative.
+template<typename In, typename Out, typename Op = std::plus<>>
+    requires my::detail::contiguous_range<In> && my::detail::contiguous_range<Out>
+void inclusive_scan(const In& in, Out&& out, Op op = Op(), ThreadPool& pool = ThreadPool::global()) {
+    auto src = my::detail::const_span(in);
+    auto dst = my::detail::mutable_span(out);
+    using T = typename decltype(dst)::value_type;
+    const size_t n = src.size();
+    if (n != dst.size()) throw std::invalid_argument("my::parallel::inclusive_scan: sizes differ");
+    if (n == 0) return;
+
+    const size_t block = pool.grain_for(n, 4096);
+    const size_t blocks = (n + block - 1) / block;
+    MyVector<detail::Partial<T>> totals(blocks, detail::Partial<T>{});
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t end = std::min(n, (b + 1) * block);
+            T acc = src[b * block];
+            for (size_t i = b * block + 1; i < end; ++i) acc = op(acc, src[i]);
+            totals[b].value = acc;
+        }
+    });
+    // totals[b] becomes the prefix before block b (unused for b = 0).
+    T running = totals[0].value;
+    for (size_t b = 1; b < blocks; ++b) {
+        T next = op(running, totals[b].value);
+        totals[b].value = running;
+        running = next;
+    }
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t end = std::min(n, (b + 1) * block);
+            if constexpr (my::detail::is_simd_sum<typename decltype(src)::value_type, T, Op>) {
+                my::detail::scan_into<true>(src.data() + b * block, end - b * block, dst.data() + b * block,
+                                            b == 0 ? T() : totals[b].value, op);
+            } else {
+                T acc = b == 0 ? T(src[0]) : op(totals[b].value, src[b * block]);
+                dst[b * block] = acc;
+                for (size_t i = b * block + 1; i < end; ++i) dst[i] = acc = op(acc, src[i]);
+            }
+        }
+    });
+}
+
+// out[i] = init op in[0] op ... op in[i - 1], with the same two passes as
+// inclusive_scan(); returns init op (all elements). `out` may be `in`.
+template<typename In, typename Out, typename Op = std::plus<>>
+    requires my::detail::contiguous_range<In> && my::detail::contiguous_range<Out>
+auto exclusive_scan(const In& in, Out&& out, my::detail::value_t<Out> init, Op op = Op(),
+                    ThreadPool& pool = ThreadPool::global()) {
+    auto src = my::detail::const_span(in);
+    auto dst = my::detail::mutable_span(out);
+    using T = typename decltype(dst)::value_type;
+    const size_t n = src.size();
+    if (n != dst.size()) throw std::invalid_argument("my::parallel::exclusive_scan: sizes differ");
+    if (n == 0) return init;
+
+    const size_t block = pool.grain_for(n, 4096);
+    const size_t blocks = (n + block - 1) / block;
+    MyVector<detail::Partial<T>> totals(blocks, detail::Partial<T>{});
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t end = std::min(n, (b + 1) * block);
+            T acc = src[b * block];
+            for (size_t i = b * block + 1; i < end; ++i) acc = op(acc, src[i]);
+            totals[b].value = acc;
+        }
+    });
+    // totals[b] becomes the value block b starts from.
+    T running = std::move(init);
+    for (size_t b = 0; b < blocks; ++b) {
+        T next = op(running, totals[b].value);
+        totals[b].value = std::move(running);
+        running = std::move(next);
+    }
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t end = std::min(n, (b + 1) * block);
+            my::detail::scan_into<false>(src.data() + b * block, end - b * block, dst.data() + b * block,
+                                         totals[b].value, op);
+        }
+    });
+    return running;
+}
+
+// my::histogram() on several threads: each slot counts its pieces into its
+// own histogram, and the histograms are summed per bin. `key` is called
+// concurrently.
+template<typename In, typename Key = std::identity>
+    requires my::detail::contiguous_range<In>
+MyVector<size_t> histogram(const In& in, size_t bins, Key key = Key(), ThreadPool& pool = ThreadPool::global()) {
+    auto src = my::detail::const_span(in);
+    const size_t slots = pool.slots();
+    MyVector<size_t> partial(slots * bins, 0);
+    MyVector<detail::Partial<bool>> used(slots, detail::Partial<bool>{});
+    pool.run(src.size(), pool.grain_for(src.size(), 65536), [&](size_t begin, size_t end, size_t slot) {
+        Key k = key;
+        my::detail::count_into(src.data() + begin, end - begin, bins, k, partial.begin() + slot * bins);
+        used[slot].value = true;
+    });
+    MyVector<size_t> counts(bins, 0);
+    pool.run(bins, pool.grain_for(bins), [&](size_t begin, size_t end, size_t) {
+        for (size_t s = 0; s < slots; ++s) {
+            if (!used[s].value) continue;
+            for (size_t k = begin; k < end; ++k) counts[k] += partial[s * bins + k];
+        }
+    });
+    return counts;
+}
+
+// Stable partition of trivially copyable elements in two passes over
+// fixed blocks. First each block is partitioned branchlessly into a
+// scratch copy (matches from its front, the rest from its back) while its
+// matches are counted. Then every block copies both groups straight to
+// their final positions. Returns the number of matching elements; `pred`
+// is called once per element, concurrently.
+template<typename C, typename Pred>
+    requires my::detail::contiguous_range<C>
+size_t stable_partition(C&& range, Pred pred, ThreadPool& pool = ThreadPool::global()) {
+    auto s = my::detail::mutable_span(range);
+    using T = typename decltype(s)::value_type;
+    static_assert(std::is_trivially_copyable_v<T>, "my::parallel::stable_partition copies raw elements");
+    const size_t n = s.size();
+    if (n == 0) return 0;
+
+    const size_t block = pool.grain_for(n, 4096);
+    const size_t blocks = (n + block - 1) / block;
+    my::detail::RawBuffer<T> scratch(n);
+    T* tmp = scratch.data();
+    MyVector<detail::Partial<size_t>> kept(blocks, detail::Partial<size_t>{});
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t begin = b * block, end = std::min(n, begin + block);
+            size_t j = 0, k = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const T x = s[i];
+                const bool keep = static_cast<bool>(pred(x));
+                tmp[begin + j] = x;
+                tmp[end - 1 - k] = x;
+                j += keep;
+                k += !keep;
+            }
+            kept[b].value = j;
+        }
+    });
+    // kept[b] becomes the position of block b's first match.
+    size_t total = 0;
+    for (size_t b = 0; b < blocks; ++b) total += std::exchange(kept[b].value, total);
+    pool.run(blocks, 1, [&](size_t first, size_t last, size_t) {
+        for (size_t b = first; b < last; ++b) {
+            const size_t begin = b * block, end = std::min(n, begin + block);
+            const size_t to = kept[b].value;
+            const size_t matches = (b + 1 < blocks ? kept[b + 1].value : total) - to;
+            std::copy(tmp + begin, tmp + begin + matches, s.data() + to);
+            std::reverse_copy(tmp + begin + matches, tmp + end, s.data() + total + (begin - to));
+        }
+    });
+    return total;
+}
+
+// The parallel partition is the stable one: splitting into blocks needs the
+// scratch copy either way, and then keeping the order is free.
+template<typename C, typename Pred>
+    requires my::detail::contiguous_range<C>
+size_t partition(C&& range, Pred pred, ThreadPool& pool = ThreadPool::global()) {
+    return stable_partition(std::forward<C>(range), std::move(pred), pool);
+}
+
+} // namespace parallel
+
+} // namespace my
+
+#endif // MY_PARALLEL_H
@@ -0,0 +1,174 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_PER_THREAD_VECTOR_H
+#define MY_PER_THREAD_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "my_parallel.h"
+#include "my_vector.h"
+
+// Order of the shards in the result of MyPerThreadVector::gather().
+enum class GatherOrder {
+    registration,   // the order in which threads first called local()
+    // Ascending std::thread::id: the same for every gather() of the same
+    // threads in one run, whichever registered first. How ids compare is
+    // implementation-defined (on glibc, by pthread_t address), so the order
+    // is not reproducible across runs.
+    thread_id
+};
+
+// Collects elements from many threads without locking: each thread appends
+// to its own MyVector (local()), padded to a cache line so neighbouring
+// shards never share one. gather() then concatenates the shards with one
+// allocation, copying them into place in parallel.
+//
+//     MyPerThreadVector<Hit> hits;
+//     my::parallel::for_each(queries, [&](const Query& q) {
+//         if (matches(q)) hits.local().push_back(Hit{q});
+//     });
+//     MyVector<Hit> all = hits.gather();
+//
+// local() may be called from any number of threads at once; gather(),
+// size() and clear() must not run while threads are still appending.
+template<typename T>
+class MyPerThreadVector {
+private:
+    struct alignas(my::ThreadPool::kCacheLine) Shard {
+        MyVector<T> items;
+        std::thread::id owner;
+    };
+
+    // The shard the calling thread used last, and for which collector.
+    struct LocalCache {
+        std::uint64_t collector = 0;
+        Shard* shard = nullptr;
+    };
+
+    static std::uint64_t next_id() noexcept {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static LocalCache& local_cache() noexcept {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    const std::uint64_t id_ = next_id();   // never reused, unlike the address
+    mutable std::mutex mutex_;
+    MyVector<std::unique_ptr<Shard>> shards_;
+
+    Shard& find_or_register() {
+        const std::thread::id self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& shard : shards_)
+            if (shard->owner == self) return *shard;
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->owner = self;
+        return *shards_.back();
+    }
+
+    // Moves (or, if moving can throw, copies) the shards into dst, which has
+    // room for offsets.back() elements.
+    static void place(const MyVector<Shard*>& order, const MyVector<size_t>& offsets, T* dst,
+                      my::ThreadPool& pool) {
+        const size_t total = offsets.back();
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            // Split the output, not the shards, so one large shard is still
+            // copied by several threads.
+            pool.run(total, pool.grain_for(total, 16384), [&](size_t begin, size_t end, size_t) {
+                size_t s = size_t(std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin()) - 1;
+                for (; begin < end; ++s) {
+                    const size_t stop = std::min(end, offsets[s + 1]);
+                    T* src = order[s]->items.begin() + (begin - offsets[s]);
+                    std::uninitialized_move(src, src + (stop - begin), dst + begin);
+                    begin = stop;
+                }
+            });
+        } else {
+            size_t s = 0;
+            try {
+                for (; s < order.size(); ++s)
+                    std::uninitialized_copy(order[s]->items.begin(), order[s]->items.end(), dst + offsets[s]);
+            } catch (...) {
+                std::destroy(dst, dst + offsets[s]);
+                throw;
+            }
+        }
+    }
+
+public:
+    using value_type = T;
+
+    MyPerThreadVector() = default;
+    MyPerThreadVector(const MyPerThreadVector&) = delete;
+    MyPerThreadVector& operator=(const MyPerThreadVector&) = delete;
+
+    // The calling thread's shard. The first call from a thread registers it
+    // under a lock; later ones are a thread-local lookup.
+    MyVector<T>& local() {
+        LocalCache& cache = local_cache();
+        if (cache.collector != id_) {
+            cache.shard = &find_or_register();
+            cache.collector = id_;
+        }
+        return cache.shard->items;
+    }
+
+    // Threads that have called local().
+    size_t shard_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return shards_.size();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t total = 0;
+        for (const auto& shard : shards_) total += shard->items.size();
+        return total;
+    }
+
+    // Empties every shard; their capacity is kept for the next batch.
+    void clear() noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& shard : shards_) shard->items.clear();
+    }
+
+    // Concatenates the shards in `order` and leaves them empty (with their
+    // capacity). The total is counted first, so the result is allocated
+    // once; the elements are then moved into place on `pool`. If moving a T
+    // can throw, they are copied on this thread instead and an exception
+    // leaves the shards unchanged.
+    MyVector<T> gather(GatherOrder order = GatherOrder::registration,
+                       my::ThreadPool& pool = my::ThreadPool::global()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MyVector<Shard*> sorted;
+        sorted.reserve(shards_.size());
+        for (auto& shard : shards_) sorted.push_back(shard.get());
+        if (order == GatherOrder::thread_id)
+            std::sort(sorted.begin(), sorted.end(), [](const Shard* a, const Shard* b) { return a->owner < b->owner; });
+
+        MyVector<size_t> offsets;
+        offsets.reserve(sorted.size() + 1);
+        offsets.push_back(0);
+        for (const Shard* shard : sorted) offsets.push_back(offsets.back() + shard->items.size());
+
+        MyVector<T> out;
+        if (offsets.back() == 0) return out;
+        out.append_with(offsets.back(), [&](T* dst) { place(sorted, offsets, dst, pool); });
+        for (Shard* shard : sorted) shard->items.clear();
+        return out;
+    }
+};
+
+#endif // MY_PER_THREAD_VECTOR_H
@@ -0,0 +1,370 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_RING_VECTOR_H
+#define MY_RING_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_storage.h"
+
+// What push_back/push_front do when a ring created with a fixed capacity is full.
+enum class RingOverflow {
+    grow,       // reallocate to twice the capacity, like MyVector
+    overwrite   // drop the element at the opposite end (telemetry-style buffer)
+};
+
+// Circular buffer over one contiguous allocation. The storage capacity is
+// always a power of two, so logical index i lives at (head_ + i) & mask.
+template<typename T>
+class MyRingVector {
+private:
+    T* data_;
+    size_t capacity_;   // allocated slots, 0 or a power of two
+    size_t head_;       // physical index of front()
+    size_t size_;
+    size_t limit_;      // max size in overwrite mode
+    RingOverflow overflow_;
+
+    static size_t round_up_pow2(size_t n) noexcept {
+        size_t cap = 1;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    size_t mask() const noexcept { return capacity_ - 1; }
+    size_t physical(size_t index) const noexcept { return (head_ + index) & mask(); }
+
+    // Moves the elements into `dst`, front first.
+    void relocate_to(T* dst) {
+        size_t first = std::min(size_, capacity_ - head_);
+        if (size_) {
+            my_storage::relocate(data_ + head_, first, dst);
+            my_storage::relocate(data_, size_ - first, dst + first);
+        }
+    }
+
+    // Moves the elements into a fresh buffer of `new_cap` slots, front at slot 0.
+    void reallocate(size_t new_cap) {
+        T* new_data = my_storage::allocate<T>(new_cap);
+        relocate_to(new_data);
+        my_storage::deallocate(data_);
+        data_ = new_data;
+        capacity_ = new_cap;
+        head_ = 0;
+    }
+
+    bool has_room() const noexcept { return size_ < limit_ && size_ < capacity_; }
+
+    // Grows to twice the capacity with a new element before the front or
+    // after the back. The element is constructed before the old ones move,
+    // so `args` may refer to them.
+    template<typename... Args>
+    T& grow_emplace(bool at_front, Args&&... args) {
+        size_t new_cap = capacity_ ? capacity_ * 2 : 1;
+        T* new_data = my_storage::allocate<T>(new_cap);
+        T* slot = new_data + (at_front ? 0 : size_);
+        try {
+            new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            my_storage::deallocate(new_data);
+            throw;
+        }
+        relocate_to(new_data + (at_front ? 1 : 0));
+        my_storage::deallocate(data_);
+        data_ = new_data;
+        capacity_ = new_cap;
+        head_ = 0;
+        ++size_;
+        return *slot;
+    }
+
+    template<bool Const>
+    class Iterator {
+        using Ring = std::conditional_t<Const, const MyRingVector, MyRingVector>;
+        Ring* ring_ = nullptr;
+        size_t index_ = 0;
+
+        friend class MyRingVector;
+        template<bool> friend class Iterator;
+        Iterator(Ring* ring, size_t index) : ring_(ring), index_(index) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        operator Iterator<true>() const { return Iterator<true>(ring_, index_); }
+
+        reference operator*() const { return (*ring_)[index_]; }
+        pointer operator->() const { return &(*ring_)[index_]; }
+        reference operator[](difference_type n) const { return (*ring_)[index_ + n]; }
+
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+        Iterator& operator--() { --index_; return *this; }
+        Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+        Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(ring_, index_ + n); }
+        Iterator operator-(difference_type n) const { return Iterator(ring_, index_ - n); }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+        difference_type operator-(const Iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        auto operator<=>(const Iterator& other) const { return index_ <=> other.index_; }
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    MyRingVector() noexcept
+        : data_(nullptr), capacity_(0), head_(0), size_(0),
+          limit_(static_cast<size_t>(-1)), overflow_(RingOverflow::grow) {}
+
+    // In overwrite mode the ring never holds more than `capacity` elements.
+    explicit MyRingVector(size_t capacity, RingOverflow overflow = RingOverflow::grow)
+        : MyRingVector() {
+        overflow_ = overflow;
+        if (overflow == RingOverflow::overwrite) limit_ = capacity;
+        reserve(capacity);
+    }
+
+    MyRingVector(std::initializer_list<T> init) : MyRingVector() {
+        reserve(init.size());
+        for (const auto& item : init)
+            push_back(item);
+    }
+
+    MyRingVector(const MyRingVector& other)
+        : data_(nullptr), capacity_(0), head_(0), size_(0),
+          limit_(other.limit_), overflow_(other.overflow_) {
+        reserve(other.capacity_);
+        for (const auto& item : other)
+            push_back(item);
+    }
+
+    MyRingVector(MyRingVector&& other) noexcept
+        : data_(other.data_), capacity_(other.capacity_), head_(other.head_),
+          size_(other.size_), limit_(other.limit_), overflow_(other.overflow_) {
+        other.data_ = nullptr;
+        other.capacity_ = other.head_ = other.size_ = 0;
+    }
+
+    ~MyRingVector() {
+        clear();
+        my_storage::deallocate(data_);
+    }
+
+    MyRingVector& operator=(const MyRingVector& other) {
+        if (this != &other) {
+            MyRingVector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    MyRingVector& operator=(MyRingVector&& other) noexcept {
+        if (this != &other) {
+            MyRingVector temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    T& operator[](size_t index) noexcept { return data_[physical(index)]; }
+    const T& operator[](size_t index) const noexcept { return data_[physical(index)]; }
+
+    T& at(size_t index) {
+        if (index >= size_) throw std::out_of_range("MyRingVector::at");
+        return (*this)[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MyRingVector::at");
+        return (*this)[index];
+    }
+
+    T& front() {
+        if (is_empty()) throw std::out_of_range("MyRingVector::front");
+        return data_[head_];
+    }
+    const T& front() const {
+        if (is_empty()) throw std::out_of_range("MyRingVector::front");
+        return data_[head_];
+    }
+
+    T& back() {
+        if (is_empty()) throw std::out_of_range("MyRingVector::back");
+        return (*this)[size_ - 1];
+    }
+    const T& back() const {
+        if (is_empty()) throw std::out_of_range("MyRingVector::back");
+        return (*this)[size_ - 1];
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool is_empty() const noexcept { return size_ == 0; }
+    bool is_full() const noexcept { return size_ == std::min(limit_, capacity_); }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return std::min(limit_, capacity_); }
+    RingOverflow overflow() const noexcept { return overflow_; }
+
+    void reserve(size_t new_cap) {
+        if (new_cap <= capacity_) return;
+        reallocate(round_up_pow2(new_cap));
+    }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < size_; ++i)
+            data_[physical(i)].~T();
+        size_ = 0;
+        head_ = 0;
+    }
+
+    void swap(MyRingVector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(limit_, other.limit_);
+        std::swap(overflow_, other.overflow_);
+    }
+
+    // In overwrite mode a full ring evicts the element at the opposite end
+    // only after the new one is built, so `args` may refer to it.
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (has_room()) {
+            T* slot = data_ + physical(size_);
+            new (slot) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+        if (overflow_ == RingOverflow::grow) return grow_emplace(false, std::forward<Args>(args)...);
+        if (limit_ == 0) throw std::length_error("MyRingVector::emplace_back");
+        T value(std::forward<Args>(args)...);
+        pop_front();
+        T* slot = data_ + physical(size_);
+        new (slot) T(std::move(value));
+        ++size_;
+        return *slot;
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (has_room()) {
+            size_t slot = (head_ - 1) & mask();
+            new (&data_[slot]) T(std::forward<Args>(args)...);
+            head_ = slot;
+            ++size_;
+            return data_[slot];
+        }
+        if (overflow_ == RingOverflow::grow) return grow_emplace(true, std::forward<Args>(args)...);
+        if (limit_ == 0) throw std::length_error("MyRingVector::emplace_front");
+        T value(std::forward<Args>(args)...);
+        pop_back();
+        size_t slot = (head_ - 1) & mask();
+        new (&data_[slot]) T(std::move(value));
+        head_ = slot;
+        ++size_;
+        return data_[slot];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    void pop_back() {
+        if (is_empty()) throw std::out_of_range("MyRingVector::pop_back");
+        data_[physical(--size_)].~T();
+    }
+
+    void pop_front() {
+        if (is_empty()) throw std::out_of_range("MyRingVector::pop_front");
+        data_[head_].~T();
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    // Live elements in order, as at most two contiguous pieces.
+    std::pair<std::span<T>, std::span<T>> data_spans() noexcept {
+        if (!size_) return {};
+        size_t first = std::min(size_, capacity_ - head_);
+        return {std::span<T>(data_ + head_, first), std::span<T>(data_, size_ - first)};
+    }
+    std::pair<std::span<const T>, std::span<const T>> data_spans() const noexcept {
+        if (!size_) return {};
+        size_t first = std::min(size_, capacity_ - head_);
+        return {std::span<const T>(data_ + head_, first), std::span<const T>(data_, size_ - first)};
+    }
+
+    // Free slots after back(), as at most two pieces, for zero-copy bulk writes.
+    // Fill a prefix of them and publish it with commit_back(count).
+    std::pair<std::span<T>, std::span<T>> free_spans() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "free_spans() exposes raw storage");
+        size_t free = capacity() - size_;
+        if (!free) return {};
+        size_t tail = physical(size_);
+        size_t first = std::min(free, capacity_ - tail);
+        return {std::span<T>(data_ + tail, first), std::span<T>(data_, free - first)};
+    }
+
+    void commit_back(size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "commit_back() publishes raw storage");
+        if (count > capacity() - size_) throw std::out_of_range("MyRingVector::commit_back");
+        size_ += count;
+    }
+
+    // Pops `count` elements from the front, e.g. after a bulk read of data_spans().
+    void consume_front(size_t count) {
+        if (count > size_) throw std::out_of_range("MyRingVector::consume_front");
+        for (size_t i = 0; i < count; ++i)
+            pop_front();
+    }
+
+    // Rearranges the elements in place so they occupy one contiguous range
+    // and returns a pointer to front(). No allocation; O(size) moves if wrapped.
+    T* as_contiguous() {
+        if (head_ + size_ <= capacity_) return data_ + head_;
+
+        // Layout is [B | free | A]: slide A down next to B, then rotate A in front of B.
+        size_t tail_part = size_ - (capacity_ - head_);
+        size_t head_part = size_ - tail_part;
+        if (head_ != tail_part) {
+            for (size_t i = 0; i < head_part; ++i) {
+                new (&data_[tail_part + i]) T(std::move(data_[head_ + i]));
+                data_[head_ + i].~T();
+            }
+        }
+        std::rotate(data_, data_ + tail_part, data_ + size_);
+        head_ = 0;
+        return data_;
+    }
+
+    bool operator==(const MyRingVector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+};
+
+#endif // MY_RING_VECTOR_H
@@ -0,0 +1,452 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SHM_VECTOR_H
+#define MY_SHM_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "my_span.h"
+#include "my_vector.h"
+
+// Vector of trivially copyable values in a shared memory segment, so other
+// processes can map it and read the elements where they are:
+//
+//     MyShmVector<Tick> out = MyShmVector<Tick>::create("/ticks", 1 << 20);   // writer
+//     out.push_back(t); ...; out.publish();
+//
+//     MyShmReader<Tick> in("/ticks");                                        // reader process
+//     for (std::uint32_t seen = 0;;) {
+//         seen = in.wait(seen);
+//         in.read([](MySpan<const Tick> batch) { ... });
+//     }
+//
+// One writer, any number of readers. The segment starts with a header that
+// refers to the elements by offset, never by address, since every process
+// maps the segment somewhere else. The header also carries a sequence
+// number: odd while the writer is changing the contents, even once
+// publish() has made them consistent (a seqlock). Readers never block the
+// writer. read() retries until it sees a published state from start to
+// end, so callbacks may see torn data that is then thrown away and must
+// not act on it before they return. Growth enlarges the segment and remaps
+// it; readers remap when they notice.
+//
+// POSIX only (Linux for memfd, mremap and futex wakeups). System call
+// failures throw std::system_error, foreign segments std::runtime_error.
+namespace my_shm {
+
+inline constexpr std::uint64_t kMagic = 0x4d7953686d566563;   // "MyShmVec"
+inline constexpr size_t kCacheLine = 64;
+
+[[noreturn]] inline void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Pointer stored as a distance from the segment start, valid in every
+// process that maps the segment.
+template<typename T>
+struct OffsetPtr {
+    std::uint64_t offset = 0;
+
+    T* get(void* base) const noexcept { return reinterpret_cast<T*>(static_cast<unsigned char*>(base) + offset); }
+    const T* get(const void* base) const noexcept {
+        return reinterpret_cast<const T*>(static_cast<const unsigned char*>(base) + offset);
+    }
+};
+
+struct alignas(kCacheLine) Header {
+    std::uint64_t magic;
+    std::uint64_t element_size;
+    OffsetPtr<unsigned char> data;
+    std::atomic<std::uint64_t> segment_bytes;   // current file size
+    std::atomic<std::uint64_t> size;            // published element count
+    alignas(kCacheLine) std::atomic<std::uint32_t> seq;   // odd while writing; futex word
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared atomics must be lock-free to work across processes");
+
+namespace detail {
+
+inline size_t page_size() noexcept {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+constexpr size_t round_up(size_t n, size_t to) noexcept { return (n + to - 1) / to * to; }
+
+// Shared (not process-private) futex calls on a word in the segment.
+inline void futex_wait(const std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                       std::chrono::nanoseconds timeout) {
+#ifdef __linux__
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts{static_cast<time_t>(secs.count()), static_cast<long>((timeout - secs).count())};
+    syscall(SYS_futex, reinterpret_cast<const std::uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+#else
+    (void)word, (void)expected, (void)timeout;
+    usleep(50);
+#endif
+}
+
+inline void futex_wake_all(std::atomic<std::uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+// An fd and its current mapping.
+class Mapping {
+private:
+    int fd_ = -1;
+    void* base_ = nullptr;
+    size_t bytes_ = 0;
+    int prot_ = PROT_READ;
+
+public:
+    Mapping() = default;
+    Mapping(int fd, size_t bytes, int prot) : fd_(fd), prot_(prot) {
+        remap(bytes);
+    }
+
+    Mapping(Mapping&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)), base_(std::exchange(other.base_, nullptr)),
+          bytes_(std::exchange(other.bytes_, 0)), prot_(other.prot_) {}
+
+    Mapping& operator=(Mapping&& other) noexcept {
+        if (this != &other) {
+            reset();
+            fd_ = std::exchange(other.fd_, -1);
+            base_ = std::exchange(other.base_, nullptr);
+            bytes_ = std::exchange(other.bytes_, 0);
+            prot_ = other.prot_;
+        }
+        return *this;
+    }
+
+    ~Mapping() { reset(); }
+
+    void reset() noexcept {
+        if (base_) ::munmap(base_, bytes_);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr;
+        bytes_ = 0;
+        fd_ = -1;
+    }
+
+    // Maps the first `bytes` of the file, moving the mapping if needed.
+    void remap(size_t bytes) {
+        void* p;
+#ifdef __linux__
+        p = base_ ? ::mremap(base_, bytes_, bytes, MREMAP_MAYMOVE)
+                  : ::mmap(nullptr, bytes, prot_, MAP_SHARED, fd_, 0);
+#else
+        p = ::mmap(nullptr, bytes, prot_, MAP_SHARED, fd_, 0);
+        if (p != MAP_FAILED && base_) ::munmap(base_, bytes_);
+#endif
+        if (p == MAP_FAILED) throw_errno("my_shm: map");
+        base_ = p;
+        bytes_ = bytes;
+    }
+
+    int fd() const noexcept { return fd_; }
+    void* base() const noexcept { return base_; }
+    size_t bytes() const noexcept { return bytes_; }
+    Header& header() const noexcept { return *static_cast<Header*>(base_); }
+};
+
+inline int open_checked(const std::string& name, int flags, mode_t mode = 0600) {
+    int fd = ::shm_open(name.c_str(), flags, mode);
+    if (fd < 0) throw_errno("my_shm: shm_open " + name);
+    return fd;
+}
+
+inline size_t file_size(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) throw_errno("my_shm: stat");
+    return static_cast<size_t>(st.st_size);
+}
+
+} // namespace detail
+
+} // namespace my_shm
+
+// The writing side; owns the segment and, if it created a name, unlinks it
+// when destroyed (mapped readers keep working).
+template<typename T>
+class MyShmVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MyShmVector holds raw bytes shared between processes");
+
+private:
+    static constexpr size_t kDataOffset = my_shm::detail::round_up(sizeof(my_shm::Header),
+                                                                   std::max(alignof(T), my_shm::kCacheLine));
+
+    my_shm::detail::Mapping map_;
+    std::string name_;      // empty for anonymous segments
+    size_t size_ = 0;       // writer's size, published by publish()
+    size_t capacity_ = 0;
+
+    MyShmVector(int fd, std::string name, size_t capacity) : name_(std::move(name)) {
+        try {
+            const size_t bytes = segment_bytes(capacity);
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) my_shm::throw_errno("my_shm: resize");
+            map_ = my_shm::detail::Mapping(fd, bytes, PROT_READ | PROT_WRITE);
+        } catch (...) {
+            if (!map_.base()) ::close(fd);
+            if (!name_.empty()) ::shm_unlink(name_.c_str());
+            throw;
+        }
+        capacity_ = capacity_for(map_.bytes());
+        my_shm::Header* h = new (map_.base()) my_shm::Header{};
+        h->magic = my_shm::kMagic;
+        h->element_size = sizeof(T);
+        h->data.offset = kDataOffset;
+        h->segment_bytes.store(map_.bytes(), std::memory_order_relaxed);
+        h->size.store(0, std::memory_order_relaxed);
+        h->seq.store(0, std::memory_order_release);
+    }
+
+    static size_t segment_bytes(size_t capacity) {
+        return my_shm::detail::round_up(kDataOffset + std::max<size_t>(capacity, 1) * sizeof(T),
+                                        my_shm::detail::page_size());
+    }
+    static size_t capacity_for(size_t bytes) noexcept { return (bytes - kDataOffset) / sizeof(T); }
+
+    my_shm::Header& header() noexcept { return map_.header(); }
+    T* elements() noexcept { return reinterpret_cast<T*>(header().data.get(map_.base())); }
+    const T* elements() const noexcept { return reinterpret_cast<const T*>(map_.header().data.get(map_.base())); }
+
+    // Readers must not trust the contents until the next publish().
+    void begin_write() noexcept {
+        auto& seq = header().seq;
+        const std::uint32_t s = seq.load(std::memory_order_relaxed);
+        if (s % 2 == 0) {
+            seq.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+    }
+
+public:
+    using value_type = T;
+
+    // New segment under a shm_open name ("/something"); fails if it exists.
+    static MyShmVector create(const std::string& name, size_t capacity = 0) {
+        int fd = my_shm::detail::open_checked(name, O_CREAT | O_EXCL | O_RDWR);
+        return MyShmVector(fd, name, capacity);
+    }
+
+#ifdef __linux__
+    // Unnamed segment; hand fd() to readers (inherited over fork, or sent
+    // through a Unix socket).
+    static MyShmVector create_anonymous(size_t capacity = 0) {
+        int fd = ::memfd_create("my_shm_vector", MFD_CLOEXEC);
+        if (fd < 0) my_shm::throw_errno("my_shm: memfd_create");
+        return MyShmVector(fd, std::string(), capacity);
+    }
+#endif
+
+    MyShmVector(MyShmVector&& other) noexcept
+        : map_(std::move(other.map_)), name_(std::exchange(other.name_, std::string())),
+          size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+    MyShmVector(const MyShmVector&) = delete;
+    MyShmVector& operator=(const MyShmVector&) = delete;
+
+    ~MyShmVector() {
+        if (!name_.empty()) ::shm_unlink(name_.c_str());
+    }
+
+    const std::string& name() const noexcept { return name_; }
+    int fd() const noexcept { return map_.fd(); }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool is_empty() const noexcept { return size_ == 0; }
+
+    // Non-const access counts as writing: readers retry until publish().
+    T& operator[](size_t index) noexcept {
+        begin_write();
+        return elements()[index];
+    }
+    const T& operator[](size_t index) const noexcept { return elements()[index]; }
+
+    T* begin() noexcept {
+        begin_write();
+        return elements();
+    }
+    T* end() noexcept { return begin() + size_; }
+    const T* begin() const noexcept { return elements(); }
+    const T* end() const noexcept { return elements() + size_; }
+
+    // Grows the segment and remaps it; readers follow on their next read.
+    void reserve(size_t new_cap) {
+        if (new_cap <= capacity_) return;
+        begin_write();
+        const size_t bytes = segment_bytes(new_cap);
+        if (::ftruncate(map_.fd(), static_cast<off_t>(bytes)) != 0) my_shm::throw_errno("my_shm: resize");
+        map_.remap(bytes);
+        capacity_ = capacity_for(bytes);
+        header().segment_bytes.store(bytes, std::memory_order_relaxed);
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy(value);   // `value` may be in the segment, which can move
+            reserve(std::max<size_t>(capacity_ * 2, 1));
+            elements()[size_++] = copy;
+            return;
+        }
+        begin_write();
+        elements()[size_++] = value;
+    }
+
+    // Appends `values`, which must not point into the segment.
+    void append(MySpan<const T> values) {
+        if (size_ + values.size() > capacity_) reserve(std::max(capacity_ * 2, size_ + values.size()));
+        begin_write();
+        if (!values.is_empty()) std::memcpy(static_cast<void*>(elements() + size_), values.data(), values.size_bytes());
+        size_ += values.size();
+    }
+
+    void resize(size_t count, const T& value = T()) {
+        if (count > capacity_) reserve(count);
+        begin_write();
+        if (count > size_) std::fill(elements() + size_, elements() + count, value);
+        size_ = count;
+    }
+
+    void clear() noexcept {
+        begin_write();
+        size_ = 0;
+    }
+
+    // Makes the current contents visible to readers and wakes them; returns
+    // the new (even) sequence number. Readers map the segment read-only and
+    // cannot register as waiters, so the wake-up system call is always made.
+    std::uint32_t publish() noexcept {
+        my_shm::Header& h = header();
+        begin_write();
+        h.size.store(size_, std::memory_order_relaxed);
+        const std::uint32_t seq = h.seq.load(std::memory_order_relaxed) + 1;
+        h.seq.store(seq, std::memory_order_release);
+        my_shm::detail::futex_wake_all(h.seq);
+        return seq;
+    }
+};
+
+// The reading side: maps a segment by name or fd, read-only.
+template<typename T>
+class MyShmReader {
+    static_assert(std::is_trivially_copyable_v<T>, "MyShmVector holds raw bytes shared between processes");
+
+private:
+    my_shm::detail::Mapping map_;
+
+    const my_shm::Header& header() const noexcept { return map_.header(); }
+
+    void attach(int fd) {
+        try {
+            const size_t bytes = my_shm::detail::file_size(fd);
+            if (bytes < sizeof(my_shm::Header)) throw std::runtime_error("my_shm: segment too small");
+            map_ = my_shm::detail::Mapping(fd, bytes, PROT_READ);
+        } catch (...) {
+            if (!map_.base()) ::close(fd);
+            throw;
+        }
+        if (header().magic != my_shm::kMagic) throw std::runtime_error("my_shm: not a MyShmVector segment");
+        if (header().element_size != sizeof(T)) throw std::runtime_error("my_shm: element size mismatch");
+    }
+
+public:
+    explicit MyShmReader(const std::string& name) { attach(my_shm::detail::open_checked(name, O_RDONLY)); }
+
+    // Uses its own duplicate of `fd`.
+    static MyShmReader from_fd(int fd) {
+        int own = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        if (own < 0) my_shm::throw_errno("my_shm: dup");
+        MyShmReader reader;
+        reader.attach(own);
+        return reader;
+    }
+
+    // Current sequence number; even values mean a published state.
+    std::uint32_t sequence() const noexcept { return header().seq.load(std::memory_order_acquire); }
+
+    // Waits until a publication newer than `seen` exists (or `timeout`
+    // passes) and returns the sequence number then current.
+    std::uint32_t wait(std::uint32_t seen, std::chrono::nanoseconds timeout = std::chrono::seconds(1)) {
+        const my_shm::Header& h = header();
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (int spin = 0;; ++spin) {
+            const std::uint32_t s = h.seq.load(std::memory_order_acquire);
+            if (s != seen && s % 2 == 0) return s;
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) return s;
+            // The futex only sleeps while seq still equals s, so a publish
+            // between the load and the call is not missed.
+            if (spin >= 64) my_shm::detail::futex_wait(h.seq, s, deadline - now);
+        }
+    }
+
+    // Calls f(MySpan<const T>) on a consistent published state, retrying if
+    // the writer changed it meanwhile; returns that state's sequence number.
+    template<typename F>
+    std::uint32_t read(F f) {
+        while (true) {
+            const my_shm::Header& h = header();
+            const std::uint32_t s1 = h.seq.load(std::memory_order_acquire);
+            if (s1 % 2 != 0) {
+                sched_yield();
+                continue;
+            }
+            const size_t bytes = h.segment_bytes.load(std::memory_order_relaxed);
+            const size_t count = h.size.load(std::memory_order_relaxed);
+            const size_t offset = h.data.offset;
+            if (bytes > map_.bytes()) {
+                map_.remap(bytes);
+                continue;
+            }
+            if (offset + count * sizeof(T) > map_.bytes()) continue;   // stale size, seq changed
+            f(MySpan<const T>(reinterpret_cast<const T*>(h.data.get(map_.base())), count));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header().seq.load(std::memory_order_relaxed) == s1) return s1;
+        }
+    }
+
+    // Copies out a consistent published state.
+    MyVector<T> copy() {
+        MyVector<T> out;
+        read([&](MySpan<const T> data) {
+            out.clear();
+            out.insert(out.end(), data.begin(), data.end());
+        });
+        return out;
+    }
+
+private:
+    MyShmReader() = default;
+};
+
+#endif // MY_SHM_VECTOR_H
@@ -0,0 +1,754 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SIMD_H
+#define MY_SIMD_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+// Small SIMD kernels used by the containers. Each vector version is compiled
+// with a function-level target attribute and picked at run time from the
+// detected ISA level, so one binary runs on any x86-64 (the headers also
+// build on non-x86, where only the scalar versions exist).
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MY_SIMD_X86 1
+#include <immintrin.h>
+#define MY_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define MY_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define MY_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,popcnt")))
+#else
+#define MY_SIMD_X86 0
+#define MY_TARGET_SSE42
+#define MY_TARGET_AVX2
+#define MY_TARGET_AVX512
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MY_PREFETCH(addr) __builtin_prefetch(addr)
+#define MY_PREFETCH_WRITE(addr) __builtin_prefetch(addr, 1)
+#else
+#define MY_PREFETCH(addr) ((void)0)
+#define MY_PREFETCH_WRITE(addr) ((void)0)
+#endif
+
+namespace my_simd {
+
+// Instruction set levels, each including the ones before it.
+enum class Level : int { scalar, sse42, avx2, avx512 };
+
+inline const char* level_name(Level level) noexcept {
+    switch (level) {
+    case Level::sse42: return "sse42";
+    case Level::avx2: return "avx2";
+    case Level::avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+inline bool parse_level(std::string_view name, Level& level) noexcept {
+    for (Level l : {Level::scalar, Level::sse42, Level::avx2, Level::avx512}) {
+        if (name == level_name(l)) {
+            level = l;
+            return true;
+        }
+    }
+    return false;
+}
+
+// The highest level this CPU (and OS) supports.
+inline Level detected_level() noexcept {
+#if MY_SIMD_X86
+    static const Level detected = []() {
+        __builtin_cpu_init();
+        if (!__builtin_cpu_supports("sse4.2") || !__builtin_cpu_supports("popcnt")) return Level::scalar;
+        if (!__builtin_cpu_supports("avx2")) return Level::sse42;
+        if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512bw")) return Level::avx2;
+        return Level::avx512;
+    }();
+    return detected;
+#else
+    return Level::scalar;
+#endif
+}
+
+namespace detail {
+
+// MY_SIMD_LEVEL=scalar|sse42|avx2|avx512 caps the level for the whole
+// process; unknown values are ignored.
+inline Level initial_level() noexcept {
+    Level level = detected_level();
+    Level wanted;
+    if (const char* env = std::getenv("MY_SIMD_LEVEL"); env && parse_level(env, wanted))
+        level = std::min(level, wanted);
+    return level;
+}
+
+inline std::atomic<Level>& active_level() noexcept {
+    static std::atomic<Level> level{initial_level()};
+    return level;
+}
+
+} // namespace detail
+
+// The level the dispatchers below use.
+inline Level level() noexcept { return detail::active_level().load(std::memory_order_relaxed); }
+
+// Switches every dispatcher to `wanted`, lowered to detected_level() if the
+// CPU lacks it; returns the level now in use. Meant for tests and
+// benchmarks, not for calling while other threads run kernels.
+inline Level set_level(Level wanted) noexcept {
+    const Level level = std::min(wanted, detected_level());
+    detail::active_level().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+// The kernels below that only have an AVX2 version use it from level avx2 up.
+inline bool has_avx2() noexcept { return level() >= Level::avx2; }
+
+// Number of elements of [data, data + n) that are less than `key`.
+template<typename T>
+size_t count_less_scalar(const T* data, size_t n, T key) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        count += data[i] < key;
+    return count;
+}
+
+#if MY_SIMD_X86
+MY_TARGET_AVX2 inline size_t count_less_avx2(const std::int32_t* data, size_t n, std::int32_t key) noexcept {
+    const __m256i k = _mm256_set1_epi32(key);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v)))));
+    }
+    return count + count_less_scalar(data + i, n - i, key);
+}
+
+MY_TARGET_AVX2 inline size_t count_less_avx2(const std::uint32_t* data, size_t n, std::uint32_t key) noexcept {
+    // Flip the sign bit so the signed compare orders unsigned values.
+    const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+    const __m256i k = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(key)), bias);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), bias);
+        count += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v)))));
+    }
+    return count + count_less_scalar(data + i, n - i, key);
+}
+
+MY_TARGET_AVX2 inline size_t count_less_avx2(const float* data, size_t n, float key) noexcept {
+    const __m256 k = _mm256_set1_ps(key);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        count += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(v, k, _CMP_LT_OQ))));
+    }
+    return count + count_less_scalar(data + i, n - i, key);
+}
+#endif
+
+template<typename T>
+inline constexpr bool has_simd_count_less =
+    std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t> || std::is_same_v<T, float>;
+
+template<typename T>
+size_t count_less(const T* data, size_t n, T key) noexcept {
+#if MY_SIMD_X86
+    if constexpr (has_simd_count_less<T>) {
+        if (has_avx2()) return count_less_avx2(data, n, key);
+    }
+#endif
+    return count_less_scalar(data, n, key);
+}
+
+// Set bits in n 64-bit words (and in the word-wise AND of two arrays).
+inline size_t popcount_scalar(const std::uint64_t* words, size_t n) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        count += static_cast<size_t>(std::popcount(words[i]));
+    return count;
+}
+
+inline size_t popcount_and_scalar(const std::uint64_t* a, const std::uint64_t* b, size_t n) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        count += static_cast<size_t>(std::popcount(a[i] & b[i]));
+    return count;
+}
+
+#if MY_SIMD_X86
+// Per-byte popcount through a nibble lookup table (vpshufb).
+MY_TARGET_AVX2 inline __m256i popcount_bytes_avx2(__m256i v) noexcept {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+                           _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+}
+
+MY_TARGET_AVX2 inline size_t horizontal_sum_epi64(__m256i v) noexcept {
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+// Byte counters gain at most 8 per step, so they are flushed every 31 steps.
+MY_TARGET_AVX2 inline size_t popcount_avx2(const std::uint64_t* words, size_t n) noexcept {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 4 <= n) {
+        __m256i bytes = _mm256_setzero_si256();
+        for (size_t step = 0; step < 31 && i + 4 <= n; ++step, i += 4)
+            bytes = _mm256_add_epi8(bytes, popcount_bytes_avx2(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    size_t count = horizontal_sum_epi64(total);
+    for (; i < n; ++i) count += static_cast<size_t>(_mm_popcnt_u64(words[i]));
+    return count;
+}
+
+MY_TARGET_AVX2 inline size_t popcount_and_avx2(const std::uint64_t* a, const std::uint64_t* b, size_t n) noexcept {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 4 <= n) {
+        __m256i bytes = _mm256_setzero_si256();
+        for (size_t step = 0; step < 31 && i + 4 <= n; ++step, i += 4)
+            bytes = _mm256_add_epi8(bytes, popcount_bytes_avx2(_mm256_and_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)))));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    size_t count = horizontal_sum_epi64(total);
+    for (; i < n; ++i) count += static_cast<size_t>(_mm_popcnt_u64(a[i] & b[i]));
+    return count;
+}
+#endif
+
+inline size_t popcount(const std::uint64_t* words, size_t n) noexcept {
+#if MY_SIMD_X86
+    if (has_avx2()) return popcount_avx2(words, n);
+#endif
+    return popcount_scalar(words, n);
+}
+
+inline size_t popcount_and(const std::uint64_t* a, const std::uint64_t* b, size_t n) noexcept {
+#if MY_SIMD_X86
+    if (has_avx2()) return popcount_and_avx2(a, b, n);
+#endif
+    return popcount_and_scalar(a, b, n);
+}
+
+// Unpacks `count` fixed-width values starting at bit `first_bit` of a
+// little-endian bit stream. The stream must be followed by one readable
+// padding word, so each value can be read with a single unaligned load.
+inline void unpack_bits_scalar(const std::uint64_t* words, size_t first_bit, unsigned width,
+                               size_t count, std::uint64_t* out) noexcept {
+    const std::uint64_t mask = width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+    size_t bit = first_bit;
+    if (std::endian::native == std::endian::little && width <= 56) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(words);
+        for (size_t i = 0; i < count; ++i, bit += width) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + bit / 8, sizeof(word));
+            out[i] = (word >> (bit % 8)) & mask;
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; ++i, bit += width) {
+        const size_t w = bit / 64, off = bit % 64;
+        out[i] = ((words[w] >> off) | ((words[w + 1] << 1) << (63 - off))) & mask;
+    }
+}
+
+#if MY_SIMD_X86
+// Four values per step: gather the 8 bytes holding each value, then apply
+// per-lane shifts. Widths above 56 can straddle 9 bytes and go scalar.
+MY_TARGET_AVX2 inline void unpack_bits_avx2(const std::uint64_t* words, size_t first_bit, unsigned width,
+                                            size_t count, std::uint64_t* out) noexcept {
+    if (width > 56) return unpack_bits_scalar(words, first_bit, width, count, out);
+    const auto* base = reinterpret_cast<const long long*>(words);
+    const long long w = static_cast<long long>(width);
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>((std::uint64_t(1) << width) - 1));
+    const __m256i step = _mm256_set1_epi64x(4 * w);
+    const __m256i seven = _mm256_set1_epi64x(7);
+    __m256i bit = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(first_bit)),
+                                   _mm256_setr_epi64x(0, w, 2 * w, 3 * w));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_i64gather_epi64(base, _mm256_srli_epi64(bit, 3), 1);
+        v = _mm256_and_si256(_mm256_srlv_epi64(v, _mm256_and_si256(bit, seven)), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        bit = _mm256_add_epi64(bit, step);
+    }
+    unpack_bits_scalar(words, first_bit + i * width, width, count - i, out + i);
+}
+#endif
+
+inline void unpack_bits(const std::uint64_t* words, size_t first_bit, unsigned width,
+                        size_t count, std::uint64_t* out) noexcept {
+#if MY_SIMD_X86
+    if (has_avx2()) return unpack_bits_avx2(words, first_bit, width, count, out);
+#endif
+    unpack_bits_scalar(words, first_bit, width, count, out);
+}
+
+// out[i] = src[idx[i]] for i < n. With `prefetch` > 0 the element needed
+// `prefetch` iterations ahead is prefetched, which hides cache misses when
+// the source is much larger than the cache and the indices are random.
+template<typename T, typename I>
+void gather_scalar(const T* src, const I* idx, size_t n, T* out, size_t prefetch = 0) noexcept {
+    size_t i = 0;
+    if (prefetch && n > prefetch) {
+        for (; i < n - prefetch; ++i) {
+            MY_PREFETCH(src + idx[i + prefetch]);
+            out[i] = src[idx[i]];
+        }
+    }
+    for (; i < n; ++i) out[i] = src[idx[i]];
+}
+
+// dst[idx[i]] = values[i] for i < n; later duplicates win.
+template<typename T, typename I>
+void scatter_scalar(T* dst, const I* idx, size_t n, const T* values, size_t prefetch = 0) noexcept {
+    size_t i = 0;
+    if (prefetch && n > prefetch) {
+        for (; i < n - prefetch; ++i) {
+            MY_PREFETCH_WRITE(dst + idx[i + prefetch]);
+            dst[idx[i]] = values[i];
+        }
+    }
+    for (; i < n; ++i) dst[idx[i]] = values[i];
+}
+
+// Element and index sizes the AVX2 gather instructions handle.
+template<typename T, typename I>
+inline constexpr bool has_simd_gather = std::is_trivially_copyable_v<T> && std::is_integral_v<I>
+                                        && (sizeof(T) == 4 || sizeof(T) == 8) && (sizeof(I) == 4 || sizeof(I) == 8);
+
+#if MY_SIMD_X86
+// vpgatherdd/dq/qd/qq on the raw bits of T: 8 (32-bit indices, 32-bit
+// elements) or 4 lanes per step. Indices are read as signed, so 32-bit
+// ones must stay below 2^31 (the dispatcher checks the source size).
+template<typename T, typename I>
+MY_TARGET_AVX2 void gather_avx2(const T* src, const I* idx, size_t n, T* out, size_t prefetch = 0) noexcept {
+    static_assert(has_simd_gather<T, I>);
+    constexpr size_t lanes = sizeof(T) == 4 && sizeof(I) == 4 ? 8 : 4;
+    const size_t ahead = prefetch ? (prefetch + lanes - 1) / lanes * lanes : 0;
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        if (ahead && i + ahead + lanes <= n)
+            for (size_t k = 0; k < lanes; ++k) MY_PREFETCH(src + idx[i + ahead + k]);
+        if constexpr (sizeof(T) == 4 && sizeof(I) == 4) {
+            __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), vi, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        } else if constexpr (sizeof(T) == 4) {
+            __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            __m128i v = _mm256_i64gather_epi32(reinterpret_cast<const int*>(src), vi, 4);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        } else if constexpr (sizeof(I) == 4) {
+            __m128i vi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + i));
+            __m256i v = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src), vi, 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        } else {
+            __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(src), vi, 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        }
+    }
+    gather_scalar(src, idx + i, n - i, out + i);
+}
+#endif
+
+// `src_size` is the number of source elements; every index must be below it.
+template<typename T, typename I>
+void gather(const T* src, size_t src_size, const I* idx, size_t n, T* out, size_t prefetch = 0) noexcept {
+#if MY_SIMD_X86
+    if constexpr (has_simd_gather<T, I>) {
+        const bool fits = sizeof(I) == 8 || src_size <= size_t(std::numeric_limits<std::int32_t>::max());
+        if (fits && has_avx2()) return gather_avx2(src, idx, n, out, prefetch);
+    }
+#endif
+    (void)src_size;
+    gather_scalar(src, idx, n, out, prefetch);
+}
+
+// Container kernels: byte-wise comparison, fill and search. There is one
+// implementation per level, reached through a table of function pointers
+// (kernels()), and they work on raw bytes so a single table covers every
+// element type. Each vector loop leaves its tail to the scalar version.
+//
+// Copies are not here: the containers use std::memcpy, which glibc already
+// dispatches on the CPU in the same way.
+struct Kernels {
+    // Index of the first byte where a and b differ, or n.
+    size_t (*mismatch)(const void* a, const void* b, size_t n) noexcept;
+    // Fills n bytes with `pattern` repeated; n is a multiple of the element size.
+    void (*fill)(void* dst, size_t n, std::uint64_t pattern) noexcept;
+    // Index of the first of n elements equal to the low bytes of `pattern`,
+    // or n; one entry per element size 1, 2, 4 and 8.
+    size_t (*find[4])(const void* data, size_t n, std::uint64_t pattern) noexcept;
+};
+
+inline size_t mismatch_scalar(const void* a, const void* b, size_t n) noexcept {
+    const auto* p = static_cast<const unsigned char*>(a);
+    const auto* q = static_cast<const unsigned char*>(b);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t x, y;
+        std::memcpy(&x, p + i, 8);
+        std::memcpy(&y, q + i, 8);
+        if (x != y) break;
+    }
+    for (; i < n; ++i)
+        if (p[i] != q[i]) return i;
+    return n;
+}
+
+inline void fill_scalar(void* dst, size_t n, std::uint64_t pattern) noexcept {
+    auto* p = static_cast<unsigned char*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) std::memcpy(p + i, &pattern, 8);
+    if (i < n) std::memcpy(p + i, &pattern, n - i);
+}
+
+template<typename U>
+size_t find_scalar(const void* data, size_t n, std::uint64_t pattern) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    U value;
+    std::memcpy(&value, &pattern, sizeof(U));
+    for (size_t i = 0; i < n; ++i) {
+        U x;
+        std::memcpy(&x, p + i * sizeof(U), sizeof(U));
+        if (x == value) return i;
+    }
+    return n;
+}
+
+#if MY_SIMD_X86
+MY_TARGET_SSE42 inline size_t mismatch_sse42(const void* a, const void* b, size_t n) noexcept {
+    const auto* p = static_cast<const unsigned char*>(a);
+    const auto* q = static_cast<const unsigned char*>(b);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i));
+        const unsigned same = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        if (same != 0xffff) return i + static_cast<size_t>(std::countr_zero(~same));
+    }
+    return i + mismatch_scalar(p + i, q + i, n - i);
+}
+
+MY_TARGET_SSE42 inline void fill_sse42(void* dst, size_t n, std::uint64_t pattern) noexcept {
+    auto* p = static_cast<unsigned char*>(dst);
+    const __m128i v = _mm_set1_epi64x(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), v);
+    fill_scalar(p + i, n - i, pattern);
+}
+
+template<typename U>
+MY_TARGET_SSE42 size_t find_sse42(const void* data, size_t n, std::uint64_t pattern) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    constexpr size_t lanes = 16 / sizeof(U);
+    const __m128i v = _mm_set1_epi64x(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * sizeof(U)));
+        __m128i eq;
+        if constexpr (sizeof(U) == 1) eq = _mm_cmpeq_epi8(x, v);
+        else if constexpr (sizeof(U) == 2) eq = _mm_cmpeq_epi16(x, v);
+        else if constexpr (sizeof(U) == 4) eq = _mm_cmpeq_epi32(x, v);
+        else eq = _mm_cmpeq_epi64(x, v);
+        const unsigned hits = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        if (hits) return i + static_cast<size_t>(std::countr_zero(hits)) / sizeof(U);
+    }
+    return i + find_scalar<U>(p + i * sizeof(U), n - i, pattern);
+}
+
+MY_TARGET_AVX2 inline size_t mismatch_avx2(const void* a, const void* b, size_t n) noexcept {
+    const auto* p = static_cast<const unsigned char*>(a);
+    const auto* q = static_cast<const unsigned char*>(b);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+        const unsigned same = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (same != 0xffffffffu) return i + static_cast<size_t>(std::countr_zero(~same));
+    }
+    return i + mismatch_scalar(p + i, q + i, n - i);
+}
+
+MY_TARGET_AVX2 inline void fill_avx2(void* dst, size_t n, std::uint64_t pattern) noexcept {
+    auto* p = static_cast<unsigned char*>(dst);
+    const __m256i v = _mm256_set1_epi64x(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), v);
+    fill_scalar(p + i, n - i, pattern);
+}
+
+template<typename U>
+MY_TARGET_AVX2 size_t find_avx2(const void* data, size_t n, std::uint64_t pattern) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    constexpr size_t lanes = 32 / sizeof(U);
+    const __m256i v = _mm256_set1_epi64x(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * sizeof(U)));
+        __m256i eq;
+        if constexpr (sizeof(U) == 1) eq = _mm256_cmpeq_epi8(x, v);
+        else if constexpr (sizeof(U) == 2) eq = _mm256_cmpeq_epi16(x, v);
+        else if constexpr (sizeof(U) == 4) eq = _mm256_cmpeq_epi32(x, v);
+        else eq = _mm256_cmpeq_epi64(x, v);
+        const unsigned hits = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+        if (hits) return i + static_cast<size_t>(std::countr_zero(hits)) / sizeof(U);
+    }
+    return i + find_scalar<U>(p + i * sizeof(U), n - i, pattern);
+}
+
+MY_TARGET_AVX512 inline size_t mismatch_avx512(const void* a, const void* b, size_t n) noexcept {
+    const auto* p = static_cast<const unsigned char*>(a);
+    const auto* q = static_cast<const unsigned char*>(b);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __m512i x = _mm512_loadu_si512(p + i);
+        const __m512i y = _mm512_loadu_si512(q + i);
+        const std::uint64_t differ = _mm512_cmpneq_epi8_mask(x, y);
+        if (differ) return i + static_cast<size_t>(std::countr_zero(differ));
+    }
+    return i + mismatch_scalar(p + i, q + i, n - i);
+}
+
+MY_TARGET_AVX512 inline void fill_avx512(void* dst, size_t n, std::uint64_t pattern) noexcept {
+    auto* p = static_cast<unsigned char*>(dst);
+    const __m512i v = _mm512_set1_epi64(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) _mm512_storeu_si512(p + i, v);
+    fill_scalar(p + i, n - i, pattern);
+}
+
+// Compare masks have one bit per element, so no scaling by the size.
+template<typename U>
+MY_TARGET_AVX512 size_t find_avx512(const void* data, size_t n, std::uint64_t pattern) noexcept {
+    const auto* p = static_cast<const unsigned char*>(data);
+    constexpr size_t lanes = 64 / sizeof(U);
+    const __m512i v = _mm512_set1_epi64(static_cast<long long>(pattern));
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m512i x = _mm512_loadu_si512(p + i * sizeof(U));
+        std::uint64_t hits;
+        if constexpr (sizeof(U) == 1) hits = _mm512_cmpeq_epi8_mask(x, v);
+        else if constexpr (sizeof(U) == 2) hits = _mm512_cmpeq_epi16_mask(x, v);
+        else if constexpr (sizeof(U) == 4) hits = _mm512_cmpeq_epi32_mask(x, v);
+        else hits = _mm512_cmpeq_epi64_mask(x, v);
+        if (hits) return i + static_cast<size_t>(std::countr_zero(hits));
+    }
+    return i + find_scalar<U>(p + i * sizeof(U), n - i, pattern);
+}
+#endif
+
+inline constexpr Kernels kScalarKernels{
+    mismatch_scalar, fill_scalar,
+    {find_scalar<std::uint8_t>, find_scalar<std::uint16_t>, find_scalar<std::uint32_t>, find_scalar<std::uint64_t>}};
+
+#if MY_SIMD_X86
+inline constexpr Kernels kSse42Kernels{
+    mismatch_sse42, fill_sse42,
+    {find_sse42<std::uint8_t>, find_sse42<std::uint16_t>, find_sse42<std::uint32_t>, find_sse42<std::uint64_t>}};
+
+inline constexpr Kernels kAvx2Kernels{
+    mismatch_avx2, fill_avx2,
+    {find_avx2<std::uint8_t>, find_avx2<std::uint16_t>, find_avx2<std::uint32_t>, find_avx2<std::uint64_t>}};
+
+inline constexpr Kernels kAvx512Kernels{
+    mismatch_avx512, fill_avx512,
+    {find_avx512<std::uint8_t>, find_avx512<std::uint16_t>, find_avx512<std::uint32_t>, find_avx512<std::uint64_t>}};
+#endif
+
+inline const Kernels& kernels_for(Level level) noexcept {
+#if MY_SIMD_X86
+    switch (level) {
+    case Level::avx512: return kAvx512Kernels;
+    case Level::avx2: return kAvx2Kernels;
+    case Level::sse42: return kSse42Kernels;
+    default: break;
+    }
+#endif
+    (void)level;
+    return kScalarKernels;
+}
+
+inline const Kernels& kernels() noexcept { return kernels_for(level()); }
+
+// Types whose == compares exactly their bytes: no padding, no floating-point
+// rules (NaN, -0.0) and no user-defined operator==.
+template<typename T>
+inline constexpr bool is_bitwise_comparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template<typename T>
+inline constexpr bool has_simd_find =
+    is_bitwise_comparable<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template<typename T>
+inline constexpr bool has_simd_fill = std::is_trivially_copyable_v<T>
+                                      && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// The bytes of `value` repeated to fill 8 bytes.
+template<typename T>
+std::uint64_t repeat_bytes(const T& value) noexcept {
+    unsigned char bytes[8];
+    for (size_t i = 0; i < 8; i += sizeof(T)) std::memcpy(bytes + i, &value, sizeof(T));
+    std::uint64_t pattern;
+    std::memcpy(&pattern, bytes, 8);
+    return pattern;
+}
+
+// Index of the first i with a[i] != b[i], or n.
+template<typename T>
+size_t mismatch(const T* a, const T* b, size_t n) noexcept {
+    static_assert(is_bitwise_comparable<T>);
+    return kernels().mismatch(a, b, n * sizeof(T)) / sizeof(T);
+}
+
+template<typename T>
+bool equal(const T* a, const T* b, size_t n) noexcept {
+    return mismatch(a, b, n) == n;
+}
+
+// Index of the first element equal to `value`, or n.
+template<typename T>
+size_t find(const T* data, size_t n, const T& value) noexcept {
+    static_assert(has_simd_find<T>);
+    return kernels().find[std::countr_zero(sizeof(T))](data, n, repeat_bytes(value));
+}
+
+// Sets n elements, which may be uninitialized, to `value`.
+template<typename T>
+void fill(T* data, size_t n, const T& value) noexcept {
+    static_assert(has_simd_fill<T>);
+    kernels().fill(data, n * sizeof(T), repeat_bytes(value));
+}
+
+// Prefix sums of 32- and 64-bit integers, wrapping on overflow: out[i] is
+// init + in[0] + ... + in[i] (inclusive) or init + in[0] + ... + in[i - 1]
+// (exclusive). `out` may be `in`. Both return init plus the sum of all n.
+// The vector versions scan each register in log2(lanes) shift-and-add
+// steps and carry the running total from one register to the next.
+template<typename T>
+inline constexpr bool has_simd_scan = std::is_integral_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+template<bool Inclusive, typename T>
+T scan_scalar(const T* in, size_t n, T* out, T init) noexcept {
+    using U = std::make_unsigned_t<T>;
+    U acc = static_cast<U>(init);
+    for (size_t i = 0; i < n; ++i) {
+        const U x = static_cast<U>(in[i]);
+        if constexpr (Inclusive) {
+            acc += x;
+            out[i] = static_cast<T>(acc);
+        } else {
+            out[i] = static_cast<T>(acc);
+            acc += x;
+        }
+    }
+    return static_cast<T>(acc);
+}
+
+#if MY_SIMD_X86
+template<bool Inclusive, typename T>
+MY_TARGET_SSE42 T scan_sse42(const T* in, size_t n, T* out, T init) noexcept {
+    constexpr size_t lanes = 16 / sizeof(T);
+    __m128i carry = sizeof(T) == 4 ? _mm_set1_epi32(static_cast<int>(init))
+                                   : _mm_set1_epi64x(static_cast<long long>(init));
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i sum, total;
+        if constexpr (sizeof(T) == 4) {
+            sum = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+            total = _mm_shuffle_epi32(sum, 0xff);
+        } else {
+            sum = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+            total = _mm_unpackhi_epi64(sum, sum);
+        }
+        if constexpr (!Inclusive) sum = sizeof(T) == 4 ? _mm_sub_epi32(sum, x) : _mm_sub_epi64(sum, x);
+        const __m128i r = sizeof(T) == 4 ? _mm_add_epi32(sum, carry) : _mm_add_epi64(sum, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+        carry = sizeof(T) == 4 ? _mm_add_epi32(carry, total) : _mm_add_epi64(carry, total);
+    }
+    alignas(16) T lane[lanes];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lane), carry);
+    return scan_scalar<Inclusive>(in + i, n - i, out + i, lane[0]);
+}
+
+template<bool Inclusive, typename T>
+MY_TARGET_AVX2 T scan_avx2(const T* in, size_t n, T* out, T init) noexcept {
+    constexpr size_t lanes = 32 / sizeof(T);
+    __m256i carry = sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(init))
+                                   : _mm256_set1_epi64x(static_cast<long long>(init));
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i sum, total;
+        if constexpr (sizeof(T) == 4) {
+            // Scan each 128-bit half, then add the low half's total to the high half.
+            sum = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+            sum = _mm256_add_epi32(sum, _mm256_slli_si256(sum, 8));
+            const __m256i low = _mm256_shuffle_epi32(sum, 0xff);
+            sum = _mm256_add_epi32(sum, _mm256_permute2x128_si256(low, low, 0x08));
+            total = _mm256_permutevar8x32_epi32(sum, _mm256_set1_epi32(7));
+        } else {
+            sum = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+            const __m256i low = _mm256_permute4x64_epi64(sum, _MM_SHUFFLE(1, 1, 1, 1));
+            sum = _mm256_add_epi64(sum, _mm256_blend_epi32(_mm256_setzero_si256(), low, 0xf0));
+            total = _mm256_permute4x64_epi64(sum, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        if constexpr (!Inclusive) sum = sizeof(T) == 4 ? _mm256_sub_epi32(sum, x) : _mm256_sub_epi64(sum, x);
+        const __m256i r = sizeof(T) == 4 ? _mm256_add_epi32(sum, carry) : _mm256_add_epi64(sum, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        carry = sizeof(T) == 4 ? _mm256_add_epi32(carry, total) : _mm256_add_epi64(carry, total);
+    }
+    alignas(32) T lane[lanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane), carry);
+    return scan_scalar<Inclusive>(in + i, n - i, out + i, lane[0]);
+}
+#endif
+
+// AVX-512 hosts use the AVX2 version: the wider shuffles cost as much as
+// they save, and the loop is bound by the carry chain.
+template<bool Inclusive, typename T>
+T scan(const T* in, size_t n, T* out, T init) noexcept {
+    static_assert(has_simd_scan<T>);
+#if MY_SIMD_X86
+    const Level l = level();
+    if (l >= Level::avx2) return scan_avx2<Inclusive>(in, n, out, init);
+    if (l >= Level::sse42) return scan_sse42<Inclusive>(in, n, out, init);
+#endif
+    return scan_scalar<Inclusive>(in, n, out, init);
+}
+
+template<typename T>
+T inclusive_scan(const T* in, size_t n, T* out, T init = T()) noexcept {
+    return scan<true>(in, n, out, init);
+}
+
+template<typename T>
+T exclusive_scan(const T* in, size_t n, T* out, T init = T()) noexcept {
+    return scan<false>(in, n, out, init);
+}
+
+} // namespace my_simd
+
+#endif // MY_SIMD_H
@@ -0,0 +1,293 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SNAPSHOT_VECTOR_H
+#define MY_SNAPSHOT_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "my_span.h"
+#include "my_vector.h"
+
+// Epoch-based reclamation (a userspace RCU) shared by every snapshot
+// container. A reader announces the global epoch while it holds a snapshot;
+// an object retired at epoch E is freed once no reader announces anything
+// older than E, i.e. once nobody who might have seen it is still reading.
+//
+// Readers never lock or wait; writers pay for the bookkeeping. Reader
+// records are cache-line padded, one per thread, and reused after the
+// thread exits.
+namespace my_rcu {
+
+inline constexpr size_t kCacheLine = 64;
+
+class Domain {
+public:
+    // The process-wide domain. It is never destroyed, so threads that exit
+    // during static destruction (pool workers, say) can still release their
+    // records; whatever is still retired at exit is left to the OS.
+    static Domain& instance() {
+        static Domain* domain = new Domain();
+        return *domain;
+    }
+
+    Domain(const Domain&) = delete;
+    Domain& operator=(const Domain&) = delete;
+
+    // Marks the calling thread as reading until the matching exit_read().
+    // Sections nest; only the outermost one announces an epoch.
+    void enter_read() {
+        Record& r = local();
+        if (r.nesting++ == 0) r.epoch.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+
+    void exit_read() noexcept {
+        Record& r = local();
+        if (--r.nesting == 0) r.epoch.store(0, std::memory_order_release);
+    }
+
+    bool in_read() { return local().nesting != 0; }
+
+    // Hands `p` over to the domain, which calls destroy(p) once no reader
+    // can still see it. The object must already be unreachable for new
+    // readers (unpublished) when this is called.
+    void retire(void* p, void (*destroy)(void*)) {
+        const std::uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            retired_.push_back({p, destroy, epoch});
+        }
+        reclaim();
+    }
+
+    template<typename T>
+    void retire(const T* p) {
+        retire(const_cast<T*>(p), [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    // Frees every retired object no reader can see; returns how many.
+    size_t reclaim() {
+        const std::uint64_t safe = oldest_reader();
+        MyVector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            size_t kept = 0;
+            for (size_t i = 0; i < retired_.size(); ++i) {
+                if (retired_[i].epoch <= safe) ready.push_back(retired_[i]);
+                else retired_[kept++] = retired_[i];
+            }
+            retired_.resize(kept, Retired{});
+        }
+        for (const Retired& r : ready) r.destroy(r.ptr);
+        return ready.size();
+    }
+
+    // Waits until every read section that was open on entry has closed, then
+    // reclaims. Calling it from inside a read section would wait forever.
+    void synchronize() {
+        if (in_read()) throw std::logic_error("my_rcu::synchronize: called inside a read section");
+        const std::uint64_t target = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        while (oldest_reader() < target) std::this_thread::yield();
+        reclaim();
+    }
+
+    // Retired objects not freed yet.
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        return retired_.size();
+    }
+
+private:
+    struct alignas(kCacheLine) Record {
+        std::atomic<std::uint64_t> epoch{0};   // announced epoch, 0 outside read sections
+        std::atomic<bool> in_use{false};
+        size_t nesting = 0;                    // touched by the owning thread only
+        Record* next = nullptr;                // records are never unlinked
+    };
+
+    struct Retired {
+        void* ptr = nullptr;
+        void (*destroy)(void*) = nullptr;
+        std::uint64_t epoch = 0;
+    };
+
+    std::atomic<std::uint64_t> epoch_{1};
+    std::atomic<Record*> records_{nullptr};
+    std::mutex retired_mutex_;
+    MyVector<Retired> retired_;
+
+    Domain() = default;
+
+    Record* acquire_record() {
+        for (Record* r = records_.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed)
+                && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return r;
+        }
+        auto* r = new Record();
+        r->in_use.store(true, std::memory_order_relaxed);
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return r;
+    }
+
+    Record& local() {
+        struct Owner {
+            Record* record;
+            ~Owner() { record->in_use.store(false, std::memory_order_release); }
+        };
+        thread_local Owner owner{acquire_record()};
+        return *owner.record;
+    }
+
+    // Smallest epoch announced by a reader, or the maximum if none reads.
+    std::uint64_t oldest_reader() const noexcept {
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (Record* r = records_.load(std::memory_order_acquire); r; r = r->next) {
+            const std::uint64_t e = r->epoch.load(std::memory_order_seq_cst);
+            if (e != 0) oldest = std::min(oldest, e);
+        }
+        return oldest;
+    }
+};
+
+inline Domain& domain() { return Domain::instance(); }
+inline void synchronize() { domain().synchronize(); }
+inline size_t reclaim() { return domain().reclaim(); }
+
+// Read section for the lifetime of the guard; must end on the thread that
+// started it.
+class ReadGuard {
+private:
+    bool active_ = true;
+
+public:
+    ReadGuard() { domain().enter_read(); }
+    ReadGuard(ReadGuard&& other) noexcept : active_(std::exchange(other.active_, false)) {}
+    ReadGuard& operator=(ReadGuard&&) = delete;
+    ~ReadGuard() {
+        if (active_) domain().exit_read();
+    }
+};
+
+} // namespace my_rcu
+
+// Read-mostly vector: readers take an immutable snapshot without locking,
+// writers copy the current contents, change the copy and publish it with a
+// single pointer store. Replaced versions are reclaimed through my_rcu once
+// the last snapshot that could see them is gone.
+//
+//     MySnapshotVector<Route> routes(load_routes());
+//     auto snap = routes.snapshot();      // stays unchanged while held
+//     for (const Route& r : snap) ...;
+//     routes.update([](MyVector<Route>& v) { v.push_back(extra); });
+//
+// Every update copies the whole vector, so this suits data that is read
+// far more often than it is written. Writers are serialized by a mutex.
+template<typename T>
+class MySnapshotVector {
+private:
+    struct Version {
+        MyVector<T> data;
+        std::uint64_t number;
+    };
+
+    std::atomic<const Version*> current_;
+    std::mutex write_mutex_;
+
+    std::uint64_t install(std::unique_ptr<Version> next) {
+        const Version* old = current_.exchange(next.release(), std::memory_order_seq_cst);
+        const std::uint64_t number = old->number + 1;
+        my_rcu::domain().retire(old);
+        return number;
+    }
+
+public:
+    // Immutable view of one version. Holding it keeps that version alive
+    // (and delays reclamation of later ones), so keep snapshots short-lived
+    // and release them on the thread that took them.
+    class Snapshot {
+    private:
+        my_rcu::ReadGuard guard_;
+        const Version* version_;
+
+    public:
+        explicit Snapshot(const std::atomic<const Version*>& current)
+            : version_(current.load(std::memory_order_seq_cst)) {}
+
+        Snapshot(Snapshot&&) noexcept = default;
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        const T& operator[](size_t index) const noexcept { return version_->data[index]; }
+        const T& at(size_t index) const {
+            if (index >= size()) throw std::out_of_range("MySnapshotVector::Snapshot::at");
+            return version_->data[index];
+        }
+
+        const T* begin() const noexcept { return version_->data.begin(); }
+        const T* end() const noexcept { return version_->data.end(); }
+        size_t size() const noexcept { return version_->data.size(); }
+        bool is_empty() const noexcept { return version_->data.is_empty(); }
+
+        const MyVector<T>& vector() const noexcept { return version_->data; }
+        MySpan<const T> span() const noexcept { return MySpan<const T>(begin(), size()); }
+
+        // Number of updates published before this version.
+        std::uint64_t version() const noexcept { return version_->number; }
+    };
+
+    MySnapshotVector() : MySnapshotVector(MyVector<T>()) {}
+    explicit MySnapshotVector(MyVector<T> init) : current_(new Version{std::move(init), 0}) {}
+    MySnapshotVector(std::initializer_list<T> init) : MySnapshotVector(MyVector<T>(init)) {}
+
+    MySnapshotVector(const MySnapshotVector&) = delete;
+    MySnapshotVector& operator=(const MySnapshotVector&) = delete;
+
+    // Snapshots may outlive the vector; the last version is retired, not freed.
+    ~MySnapshotVector() { my_rcu::domain().retire(current_.load(std::memory_order_relaxed)); }
+
+    Snapshot snapshot() const { return Snapshot(current_); }
+
+    // Copies out the current contents.
+    MyVector<T> copy() const { return snapshot().vector(); }
+
+    // Calls f on a copy of the current contents and publishes the result.
+    // If f throws, nothing is published. Returns the new version number.
+    template<typename F>
+    std::uint64_t update(F f) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const Version* old = current_.load(std::memory_order_relaxed);
+        auto next = std::make_unique<Version>(Version{old->data, old->number + 1});
+        f(next->data);
+        return install(std::move(next));
+    }
+
+    // Replaces the contents without copying the old ones.
+    std::uint64_t publish(MyVector<T> contents) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const Version* old = current_.load(std::memory_order_relaxed);
+        return install(std::make_unique<Version>(Version{std::move(contents), old->number + 1}));
+    }
+
+    void push_back(const T& value) {
+        update([&](MyVector<T>& v) { v.push_back(value); });
+    }
+
+    std::uint64_t version() const { return snapshot().version(); }
+    size_t size() const { return snapshot().size(); }
+};
+
+#endif // MY_SNAPSHOT_VECTOR_H
@@ -0,0 +1,359 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SORT_H
+#define MY_SORT_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "my_span.h"
+#include "my_storage.h"
+#include "my_vector.h"
+
+// Sorting for MyVector and MySpan (v below is either):
+//  - my::sort(v)               integral, float or double T: LSD radix sort, otherwise
+//                              parallel merge sort (long double included)
+//  - my::sort(v, comp)         parallel merge sort with a custom comparator
+//  - my::sort_by_key(v, key)   radix sort on an integral, float or double key
+//                              (trivially copyable T), otherwise merge sort
+// Small inputs fall back to std::sort. Scratch space comes from my_storage.
+// Comparators and key extractors must not throw.
+namespace my {
+
+inline size_t default_sort_threads() noexcept {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+namespace detail {
+
+// Below this size every path is plain std::sort.
+inline constexpr size_t kSortSmall = 256;
+// Minimum elements per thread before another thread is worth starting.
+inline constexpr size_t kSortPerThread = 1 << 15;
+
+// Uninitialized buffer owned through the MyVector storage layer.
+template<typename T>
+class ScratchBuffer {
+    T* data_;
+
+public:
+    explicit ScratchBuffer(size_t count) : data_(my_storage::allocate<T>(count)) {}
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+    ~ScratchBuffer() { my_storage::deallocate(data_); }
+    T* get() const noexcept { return data_; }
+};
+
+// Runs f(0) ... f(tasks - 1), each on its own thread (task 0 on the caller).
+template<typename F>
+void parallel_tasks(size_t tasks, F f) {
+    if (tasks <= 1) {
+        if (tasks == 1) f(size_t(0));
+        return;
+    }
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    MyVector<std::thread> workers;
+    workers.reserve(tasks - 1);
+    for (size_t t = 1; t < tasks; ++t) {
+        workers.emplace_back([&f, &error, &error_mutex, t]() {
+            try {
+                f(t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        });
+    }
+    f(size_t(0));
+    for (auto& w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+}
+
+inline size_t useful_threads(size_t n, size_t threads) noexcept {
+    return std::max<size_t>(1, std::min(threads, n / kSortPerThread));
+}
+
+// Types radix_key() can map; long double has no fixed-width integer image.
+template<typename K>
+inline constexpr bool has_radix_key =
+    std::is_integral_v<K> || std::is_same_v<K, float> || std::is_same_v<K, double>;
+
+// Maps a key to an unsigned integer with the same ordering.
+template<typename K>
+    requires has_radix_key<K>
+auto radix_key(K key) noexcept {
+    if constexpr (std::is_same_v<K, bool>) {
+        return static_cast<std::uint8_t>(key);
+    } else if constexpr (std::is_floating_point_v<K>) {
+        using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+        static_assert(sizeof(K) == sizeof(U), "only float and double keys are supported");
+        U bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+        return (bits & sign) ? U(~bits) : U(bits | sign);
+    } else {
+        using U = std::make_unsigned_t<K>;
+        if constexpr (std::is_signed_v<K>)
+            return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+        else
+            return static_cast<U>(key);
+    }
+}
+
+// LSD radix sort with 8-bit digits; stable. Each pass splits the input into
+// per-thread chunks, counts digits per chunk, then scatters every chunk to
+// its precomputed offsets. Passes where all keys share a digit are skipped.
+template<typename T, typename KeyFn>
+void radix_sort(T* data, size_t n, KeyFn key, size_t threads) {
+    static_assert(std::is_trivially_copyable_v<T>, "radix sort moves elements bytewise");
+    using U = decltype(radix_key(key(data[0])));
+    constexpr size_t passes = sizeof(U);
+    if (n < kSortSmall) {
+        std::stable_sort(data, data + n, [&](const T& a, const T& b) { return radix_key(key(a)) < radix_key(key(b)); });
+        return;
+    }
+
+    threads = useful_threads(n, threads);
+    const size_t chunk = (n + threads - 1) / threads;
+    ScratchBuffer<T> scratch(n);
+    T* src = data;
+    T* dst = scratch.get();
+
+    // One parallel pass counts every digit of every chunk. The summed totals
+    // decide which passes can be skipped, and the first pass that runs
+    // reuses its per-chunk counts instead of counting again.
+    const size_t stride = passes * 256;
+    MyVector<size_t> chunk_counts(threads * stride, 0);
+    parallel_tasks(threads, [&](size_t t) {
+        size_t* count = chunk_counts.begin() + t * stride;
+        for (size_t i = t * chunk, end = std::min(n, i + chunk); i < end; ++i) {
+            U k = radix_key(key(src[i]));
+            for (size_t p = 0; p < passes; ++p)
+                ++count[p * 256 + ((k >> (8 * p)) & 0xff)];
+        }
+    });
+    MyVector<size_t> totals(stride, 0);
+    for (size_t t = 0; t < threads; ++t)
+        for (size_t j = 0; j < stride; ++j) totals[j] += chunk_counts[t * stride + j];
+
+    MyVector<size_t> offsets(threads * 256, 0);
+    bool scattered = false;
+    for (size_t p = 0; p < passes; ++p) {
+        const size_t shift = 8 * p;
+        if (std::find(totals.begin() + p * 256, totals.begin() + (p + 1) * 256, n) != totals.begin() + (p + 1) * 256)
+            continue;
+
+        if (!scattered) {
+            for (size_t t = 0; t < threads; ++t)
+                std::copy_n(chunk_counts.begin() + t * stride + p * 256, 256, offsets.begin() + t * 256);
+        } else {
+            std::fill(offsets.begin(), offsets.end(), 0);
+            parallel_tasks(threads, [&](size_t t) {
+                size_t* count = offsets.begin() + t * 256;
+                for (size_t i = t * chunk, end = std::min(n, i + chunk); i < end; ++i)
+                    ++count[(radix_key(key(src[i])) >> shift) & 0xff];
+            });
+        }
+        size_t running = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            for (size_t t = 0; t < threads; ++t) {
+                size_t c = offsets[t * 256 + d];
+                offsets[t * 256 + d] = running;
+                running += c;
+            }
+        }
+        parallel_tasks(threads, [&](size_t t) {
+            size_t* pos = offsets.begin() + t * 256;
+            for (size_t i = t * chunk, end = std::min(n, i + chunk); i < end; ++i)
+                std::memcpy(static_cast<void*>(dst + pos[(radix_key(key(src[i])) >> shift) & 0xff]++),
+                            static_cast<const void*>(src + i), sizeof(T));
+        });
+        std::swap(src, dst);
+        scattered = true;
+    }
+    if (src != data) std::memcpy(static_cast<void*>(data), static_cast<const void*>(src), n * sizeof(T));
+}
+
+// Merges two sorted runs into uninitialized `out`, destroying the sources.
+template<typename T, typename Compare>
+void merge_relocate(T* a, T* a_end, T* b, T* b_end, T* out, Compare& comp) {
+    auto take = [&](T*& from) {
+        new (out++) T(std::move_if_noexcept(*from));
+        from->~T();
+        ++from;
+    };
+    while (a != a_end && b != b_end) {
+        if (comp(*b, *a)) take(b);
+        else take(a);
+    }
+    while (a != a_end) take(a);
+    while (b != b_end) take(b);
+}
+
+// Sorts `threads` chunks in parallel with std::sort, then merges runs pairwise
+// between the vector storage and a scratch buffer. Each pair merge is cut into
+// independent pieces (split on the longer run, matched by binary search in
+// the other one), so late rounds with few pairs still use every thread.
+template<typename T, typename Compare>
+void merge_sort(T* data, size_t n, Compare comp, size_t threads) {
+    threads = useful_threads(n, threads);
+    if (n < kSortSmall || threads == 1) {
+        std::sort(data, data + n, comp);
+        return;
+    }
+
+    MyVector<size_t> bounds;
+    for (size_t t = 0; t <= threads; ++t) bounds.push_back(n * t / threads);
+    parallel_tasks(threads, [&](size_t t) {
+        std::sort(data + bounds[t], data + bounds[t + 1], comp);
+    });
+
+    ScratchBuffer<T> scratch(n);
+    T* src = data;
+    T* dst = scratch.get();
+
+    struct Piece { size_t a, a_end, b, b_end, out; };
+    while (bounds.size() > 2) {
+        const size_t runs = bounds.size() - 1;
+        const size_t pairs = runs / 2;
+        const size_t pieces_per_pair = std::max<size_t>(1, threads / std::max<size_t>(pairs, 1));
+
+        MyVector<Piece> pieces;
+        for (size_t r = 0; r + 1 < runs; r += 2) {
+            size_t a0 = bounds[r], a1 = bounds[r + 1], b0 = bounds[r + 1], b1 = bounds[r + 2];
+            size_t prev_a = a0, prev_b = b0;
+            for (size_t k = 1; k <= pieces_per_pair; ++k) {
+                size_t cut_a = a1, cut_b = b1;
+                if (k < pieces_per_pair) {
+                    if (a1 - a0 >= b1 - b0) {
+                        cut_a = a0 + (a1 - a0) * k / pieces_per_pair;
+                        cut_b = static_cast<size_t>(std::lower_bound(src + b0, src + b1, src[cut_a], comp) - src);
+                    } else {
+                        cut_b = b0 + (b1 - b0) * k / pieces_per_pair;
+                        cut_a = static_cast<size_t>(std::upper_bound(src + a0, src + a1, src[cut_b], comp) - src);
+                    }
+                    cut_a = std::max(cut_a, prev_a);
+                    cut_b = std::max(cut_b, prev_b);
+                }
+                pieces.push_back({prev_a, cut_a, prev_b, cut_b, a0 + (prev_a - a0) + (prev_b - b0)});
+                prev_a = cut_a;
+                prev_b = cut_b;
+            }
+        }
+        if (runs % 2) {
+            size_t last = bounds[runs - 1];
+            pieces.push_back({last, bounds[runs], bounds[runs], bounds[runs], last});
+        }
+
+        // The piece list is usually longer than the thread count: stride over it.
+        const size_t workers = std::min(threads, pieces.size());
+        parallel_tasks(workers, [&](size_t t) {
+            for (size_t i = t; i < pieces.size(); i += workers) {
+                const Piece& p = pieces[i];
+                merge_relocate(src + p.a, src + p.a_end, src + p.b, src + p.b_end, dst + p.out, comp);
+            }
+        });
+
+        MyVector<size_t> next;
+        for (size_t r = 0; r < runs; r += 2) next.push_back(bounds[r]);
+        next.push_back(n);
+        bounds = std::move(next);
+        std::swap(src, dst);
+    }
+    if (src != data) my_storage::relocate(src, n, data);
+}
+
+template<typename T>
+struct identity_key {
+    const T& operator()(const T& value) const noexcept { return value; }
+};
+
+} // namespace detail
+
+// Stable LSD radix sort of integral, float and double elements.
+template<typename T>
+    requires detail::has_radix_key<T>
+void radix_sort(MySpan<T> s, size_t threads = default_sort_threads()) {
+    detail::radix_sort(s.data(), s.size(), detail::identity_key<T>(), threads);
+}
+
+template<typename T, typename Compare>
+void merge_sort(MySpan<T> s, Compare comp, size_t threads = default_sort_threads()) {
+    detail::merge_sort(s.data(), s.size(), comp, threads);
+}
+
+template<typename T, typename Compare>
+    requires std::predicate<Compare&, const T&, const T&>
+void sort(MySpan<T> s, Compare comp, size_t threads = default_sort_threads()) {
+    merge_sort(s, comp, threads);
+}
+
+template<typename T>
+void sort(MySpan<T> s, size_t threads = default_sort_threads()) {
+    if constexpr (detail::has_radix_key<T>)
+        radix_sort(s, threads);
+    else
+        merge_sort(s, std::less<T>(), threads);
+}
+
+// Sorts by key(element), which must return an arithmetic value. Stable when
+// T is trivially copyable and the key is integral, float or double (radix
+// path), otherwise falls back to merge sort.
+template<typename T, typename KeyFn>
+void sort_by_key(MySpan<T> s, KeyFn key, size_t threads = default_sort_threads()) {
+    using K = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+    static_assert(std::is_arithmetic_v<K>, "sort_by_key needs an arithmetic key");
+    if constexpr (std::is_trivially_copyable_v<T> && detail::has_radix_key<K>) {
+        detail::radix_sort(s.data(), s.size(), key, threads);
+    } else if constexpr (detail::has_radix_key<K>) {
+        merge_sort(s, [&](const T& a, const T& b) {
+            return detail::radix_key(key(a)) < detail::radix_key(key(b));
+        }, threads);
+    } else {
+        merge_sort(s, [&](const T& a, const T& b) { return key(a) < key(b); }, threads);
+    }
+}
+
+// Whole-vector forms of the above.
+template<typename T>
+    requires detail::has_radix_key<T>
+void radix_sort(MyVector<T>& v, size_t threads = default_sort_threads()) {
+    radix_sort(MySpan<T>(v), threads);
+}
+
+template<typename T, typename Compare>
+void merge_sort(MyVector<T>& v, Compare comp, size_t threads = default_sort_threads()) {
+    merge_sort(MySpan<T>(v), comp, threads);
+}
+
+template<typename T, typename Compare>
+    requires std::predicate<Compare&, const T&, const T&>
+void sort(MyVector<T>& v, Compare comp, size_t threads = default_sort_threads()) {
+    merge_sort(MySpan<T>(v), comp, threads);
+}
+
+template<typename T>
+void sort(MyVector<T>& v, size_t threads = default_sort_threads()) {
+    sort(MySpan<T>(v), threads);
+}
+
+template<typename T, typename KeyFn>
+void sort_by_key(MyVector<T>& v, KeyFn key, size_t threads = default_sort_threads()) {
+    sort_by_key(MySpan<T>(v), key, threads);
+}
+
+} // namespace my
+
+#endif // MY_SORT_H
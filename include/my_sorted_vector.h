@@ -0,0 +1,244 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SORTED_VECTOR_H
+#define MY_SORTED_VECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_simd.h"
+#include "my_span.h"
+#include "my_vector.h"
+
+// How MySortedVector searches its keys.
+enum class SortedLayout {
+    sorted,     // branchless binary search over the sorted keys, SIMD scan of the last block
+    eytzinger   // extra BFS-ordered copy of the keys: cache-friendly descent with deep prefetch
+};
+
+// Read-mostly sorted sequence (duplicates allowed) built on MyVector storage.
+// Iteration and operator[] are always in sorted order; the Eytzinger layout
+// only adds a search index next to the sorted keys.
+template<typename T, typename Compare = std::less<T>>
+class MySortedVector {
+private:
+    MyVector<T> keys_;
+    MyVector<T> eytzinger_;        // 1-based, slot 0 unused
+    MyVector<size_t> rank_;        // eytzinger slot -> sorted index
+    SortedLayout layout_;
+    Compare comp_;
+
+    // Below this many candidates the search switches to a linear (SIMD) count.
+    static constexpr size_t kBlock = 16;
+    // Queries advanced in lockstep by the batched search.
+    static constexpr size_t kBatch = 16;
+
+    static constexpr bool simd_block = my_simd::has_simd_count_less<T>
+                                       && std::is_same_v<Compare, std::less<T>>;
+
+    size_t count_less(const T* first, size_t n, const T& key) const {
+        if constexpr (simd_block) {
+            return my_simd::count_less(first, n, key);
+        } else {
+            size_t count = 0;
+            for (size_t i = 0; i < n; ++i)
+                count += comp_(first[i], key);
+            return count;
+        }
+    }
+
+    void build_index() {
+        eytzinger_.clear();
+        rank_.clear();
+        if (layout_ != SortedLayout::eytzinger) return;
+        size_t n = keys_.size();
+        eytzinger_.resize(n + 1, keys_.is_empty() ? T() : keys_[0]);
+        rank_.resize(n + 1, n);
+        size_t next = 0;
+        fill_eytzinger(next, 1);
+    }
+
+    // In-order walk of the implicit tree assigns the keys in sorted order.
+    void fill_eytzinger(size_t& next, size_t k) {
+        if (k > keys_.size()) return;
+        fill_eytzinger(next, 2 * k);
+        eytzinger_[k] = keys_[next];
+        rank_[k] = next++;
+        fill_eytzinger(next, 2 * k + 1);
+    }
+
+    // Eytzinger slot k after the descent -> sorted index of the lower bound.
+    size_t eytzinger_result(size_t k) const {
+        // Undo the trailing right turns (1 bits) plus the final left turn.
+        k >>= std::countr_one(k) + 1;
+        return k == 0 ? keys_.size() : rank_[k];
+    }
+
+    size_t lower_bound_sorted(const T& key) const {
+        const T* base = keys_.begin();
+        size_t n = keys_.size();
+        while (n > kBlock) {
+            size_t half = n / 2;
+            MY_PREFETCH(base + half / 2);
+            MY_PREFETCH(base + half + half / 2);
+            base = comp_(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - keys_.begin()) + count_less(base, n, key);
+    }
+
+    size_t lower_bound_eytzinger(const T& key) const {
+        const T* tree = eytzinger_.begin();
+        size_t n = keys_.size();
+        size_t k = 1;
+        while (k <= n) {
+            // The 16 descendants four levels down are adjacent: fetch them early.
+            if (k * 16 <= n) MY_PREFETCH(tree + k * 16);
+            k = 2 * k + comp_(tree[k], key);
+        }
+        return eytzinger_result(k);
+    }
+
+public:
+    using value_type = T;
+
+    explicit MySortedVector(SortedLayout layout = SortedLayout::sorted, Compare comp = Compare())
+        : layout_(layout), comp_(comp) {}
+
+    // Bulk build: sorts once.
+    explicit MySortedVector(MyVector<T> values, SortedLayout layout = SortedLayout::sorted,
+                            Compare comp = Compare())
+        : keys_(std::move(values)), layout_(layout), comp_(comp) {
+        std::sort(keys_.begin(), keys_.end(), comp_);
+        build_index();
+    }
+
+    MySortedVector(std::initializer_list<T> init, SortedLayout layout = SortedLayout::sorted)
+        : MySortedVector(MyVector<T>(init), layout) {}
+
+    const T& operator[](size_t index) const noexcept { return keys_[index]; }
+    const T& at(size_t index) const { return keys_.at(index); }
+
+    const T* begin() const noexcept { return keys_.begin(); }
+    const T* end() const noexcept { return keys_.end(); }
+
+    bool is_empty() const noexcept { return keys_.is_empty(); }
+    size_t size() const noexcept { return keys_.size(); }
+    SortedLayout layout() const noexcept { return layout_; }
+    const MyVector<T>& keys() const noexcept { return keys_; }
+
+    void set_layout(SortedLayout layout) {
+        layout_ = layout;
+        build_index();
+    }
+
+    void reserve(size_t new_cap) { keys_.reserve(new_cap); }
+
+    // Index of the first element not less than `key`, or size().
+    size_t lower_bound(const T& key) const {
+        if (layout_ == SortedLayout::eytzinger) return lower_bound_eytzinger(key);
+        return lower_bound_sorted(key);
+    }
+
+    size_t upper_bound(const T& key) const {
+        return static_cast<size_t>(std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+
+    // Index of an element equal to `key`, or size().
+    size_t find(const T& key) const {
+        size_t i = lower_bound(key);
+        return (i < keys_.size() && !comp_(key, keys_[i])) ? i : keys_.size();
+    }
+
+    bool contains(const T& key) const { return find(key) != keys_.size(); }
+
+    // lower_bound for `count` keys at once; `out[i]` receives the index for keys[i].
+    // Searches are advanced in lockstep in groups so their cache misses overlap.
+    void lower_bound_many(const T* keys, size_t count, size_t* out) const {
+        const size_t n = keys_.size();
+        for (size_t start = 0; start < count; start += kBatch) {
+            const size_t batch = std::min(kBatch, count - start);
+            const T* q = keys + start;
+            if (layout_ == SortedLayout::eytzinger) {
+                const T* tree = eytzinger_.begin();
+                size_t k[kBatch];
+                for (size_t j = 0; j < batch; ++j) k[j] = 1;
+                for (bool active = n > 0; active;) {
+                    active = false;
+                    for (size_t j = 0; j < batch; ++j) {
+                        if (k[j] > n) continue;
+                        k[j] = 2 * k[j] + comp_(tree[k[j]], q[j]);
+                        if (k[j] <= n) {
+                            MY_PREFETCH(tree + k[j]);
+                            active = true;
+                        }
+                    }
+                }
+                for (size_t j = 0; j < batch; ++j) out[start + j] = eytzinger_result(k[j]);
+            } else {
+                const T* base[kBatch];
+                for (size_t j = 0; j < batch; ++j) base[j] = keys_.begin();
+                size_t len = n;
+                while (len > kBlock) {
+                    size_t half = len / 2;
+                    size_t next_half = (len - half) / 2;
+                    for (size_t j = 0; j < batch; ++j) {
+                        base[j] = comp_(base[j][half], q[j]) ? base[j] + half : base[j];
+                        MY_PREFETCH(base[j] + next_half);
+                    }
+                    len -= half;
+                }
+                for (size_t j = 0; j < batch; ++j)
+                    out[start + j] = static_cast<size_t>(base[j] - keys_.begin()) + count_less(base[j], len, q[j]);
+            }
+        }
+    }
+
+    void lower_bound_many(MySpan<const T> keys, MySpan<size_t> out) const {
+        if (out.size() < keys.size()) throw std::out_of_range("MySortedVector::lower_bound_many");
+        lower_bound_many(keys.data(), keys.size(), out.data());
+    }
+
+    MyVector<size_t> lower_bound_many(const MyVector<T>& keys) const {
+        MyVector<size_t> out(keys.size(), 0);
+        lower_bound_many(keys.begin(), keys.size(), out.begin());
+        return out;
+    }
+
+    // O(n) single-element updates; returns the index of the new element.
+    size_t insert(const T& value) {
+        size_t i = static_cast<size_t>(std::upper_bound(keys_.begin(), keys_.end(), value, comp_) - keys_.begin());
+        keys_.insert(keys_.begin() + i, value);
+        build_index();
+        return i;
+    }
+
+    void erase_at(size_t index) {
+        if (index >= keys_.size()) throw std::out_of_range("MySortedVector::erase_at");
+        keys_.erase(keys_.begin() + index);
+        build_index();
+    }
+
+    // Erases one element equal to `key`; returns false if there is none.
+    bool erase(const T& key) {
+        size_t i = find(key);
+        if (i == keys_.size()) return false;
+        erase_at(i);
+        return true;
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        eytzinger_.clear();
+        rank_.clear();
+    }
+};
+
+#endif // MY_SORTED_VECTOR_H
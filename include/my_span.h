@@ -0,0 +1,228 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_SPAN_H
+#define MY_SPAN_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "my_array.h"
+#include "my_vector.h"
+
+template<typename T>
+class MyStridedView;
+
+// Non-owning view of a contiguous range. MyVector and MyArray convert to it
+// implicitly (MySpan<const T> from const containers); the view is invalidated
+// by anything that reallocates the container.
+template<typename T>
+class MySpan {
+private:
+    T* data_;
+    size_t size_;
+
+    using value_t = std::remove_const_t<T>;
+
+public:
+    using element_type = T;
+    using value_type = value_t;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    MySpan() noexcept : data_(nullptr), size_(0) {}
+    MySpan(T* data, size_t count) noexcept : data_(data), size_(count) {}
+    MySpan(T* first, T* last) noexcept : data_(first), size_(static_cast<size_t>(last - first)) {}
+
+    MySpan(MyVector<value_t>& v) noexcept : data_(v.begin()), size_(v.size()) {}
+    MySpan(const MyVector<value_t>& v) noexcept
+        requires std::is_const_v<T>
+        : data_(v.begin()), size_(v.size()) {}
+
+    template<size_t N>
+    MySpan(MyArray<value_t, N>& a) noexcept : data_(a.begin()), size_(N) {}
+    template<size_t N>
+    MySpan(const MyArray<value_t, N>& a) noexcept
+        requires std::is_const_v<T>
+        : data_(a.begin()), size_(N) {}
+
+    // MySpan<T> -> MySpan<const T>.
+    template<typename U>
+        requires std::is_const_v<T> && std::is_same_v<U, value_t>
+    MySpan(MySpan<U> other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    T& operator[](size_t index) const noexcept { return data_[index]; }
+    T& at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MySpan::at");
+        return data_[index];
+    }
+
+    T& front() const {
+        if (size_ == 0) throw std::out_of_range("MySpan::front");
+        return data_[0];
+    }
+    T& back() const {
+        if (size_ == 0) throw std::out_of_range("MySpan::back");
+        return data_[size_ - 1];
+    }
+
+    T* data() const noexcept { return data_; }
+    T* begin() const noexcept { return data_; }
+    T* end() const noexcept { return data_ + size_; }
+
+    bool is_empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t size_bytes() const noexcept { return size_ * sizeof(T); }
+
+    // [offset, offset + count); count = npos means "to the end".
+    MySpan subspan(size_t offset, size_t count = npos) const {
+        if (offset > size_) throw std::out_of_range("MySpan::subspan");
+        if (count == npos) count = size_ - offset;
+        if (count > size_ - offset) throw std::out_of_range("MySpan::subspan");
+        return MySpan(data_ + offset, count);
+    }
+
+    MySpan first(size_t count) const {
+        if (count > size_) throw std::out_of_range("MySpan::first");
+        return MySpan(data_, count);
+    }
+    MySpan last(size_t count) const {
+        if (count > size_) throw std::out_of_range("MySpan::last");
+        return MySpan(data_ + size_ - count, count);
+    }
+
+    // Every `stride`-th element starting at `offset`; for a row-major matrix
+    // with `cols` columns, strided(cols, j) is column j.
+    MyStridedView<T> strided(size_t stride, size_t offset = 0) const {
+        if (stride == 0) throw std::invalid_argument("MySpan::strided: zero stride");
+        if (offset > size_) throw std::out_of_range("MySpan::strided");
+        return MyStridedView<T>(data_ + offset, (size_ - offset + stride - 1) / stride, stride);
+    }
+
+    // Splits the span into `parts` contiguous pieces whose sizes differ by at
+    // most one (empty pieces when parts > size()), e.g. one per worker thread.
+    MyVector<MySpan> chunks(size_t parts) const {
+        if (parts == 0) throw std::invalid_argument("MySpan::chunks: zero parts");
+        MyVector<MySpan> out;
+        out.reserve(parts);
+        size_t offset = 0;
+        for (size_t p = 0; p < parts; ++p) {
+            size_t count = size_ / parts + (p < size_ % parts);
+            out.push_back(MySpan(data_ + offset, count));
+            offset += count;
+        }
+        return out;
+    }
+};
+
+template<typename T>
+MySpan(MyVector<T>&) -> MySpan<T>;
+template<typename T>
+MySpan(const MyVector<T>&) -> MySpan<const T>;
+template<typename T, size_t N>
+MySpan(MyArray<T, N>&) -> MySpan<T>;
+template<typename T, size_t N>
+MySpan(const MyArray<T, N>&) -> MySpan<const T>;
+
+// Non-owning view of `size` elements spaced `stride` apart.
+template<typename T>
+class MyStridedView {
+private:
+    T* data_;
+    size_t size_;
+    size_t stride_;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+
+    // Keeps an index rather than a pointer, so end() never points past the range.
+    class iterator {
+        T* base_;
+        std::ptrdiff_t index_;
+        size_t stride_;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() noexcept : base_(nullptr), index_(0), stride_(1) {}
+        iterator(T* base, difference_type index, size_t stride) noexcept
+            : base_(base), index_(index), stride_(stride) {}
+
+        reference operator*() const noexcept { return base_[size_t(index_) * stride_]; }
+        pointer operator->() const noexcept { return &**this; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        iterator& operator++() noexcept { ++index_; return *this; }
+        iterator operator++(int) noexcept { iterator tmp = *this; ++index_; return tmp; }
+        iterator& operator--() noexcept { --index_; return *this; }
+        iterator operator--(int) noexcept { iterator tmp = *this; --index_; return tmp; }
+        iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+        iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+        friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b) noexcept { return a.index_ - b.index_; }
+
+        bool operator==(const iterator& other) const noexcept { return index_ == other.index_; }
+        auto operator<=>(const iterator& other) const noexcept { return index_ <=> other.index_; }
+    };
+
+    MyStridedView() noexcept : data_(nullptr), size_(0), stride_(1) {}
+    MyStridedView(T* data, size_t count, size_t stride) noexcept : data_(data), size_(count), stride_(stride) {}
+
+    T& operator[](size_t index) const noexcept { return data_[index * stride_]; }
+    T& at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MyStridedView::at");
+        return (*this)[index];
+    }
+
+    iterator begin() const noexcept { return iterator(data_, 0, stride_); }
+    iterator end() const noexcept { return iterator(data_, std::ptrdiff_t(size_), stride_); }
+
+    T* data() const noexcept { return data_; }
+    bool is_empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t stride() const noexcept { return stride_; }
+};
+
+// Views of the MyVector / MyArray / MySpan arguments of the my:: algorithms.
+namespace my::detail {
+
+// Containers whose elements are data()[0, size()). MyStridedView has data()
+// and element_type too, but reading it as one block would skip the stride.
+template<typename C>
+inline constexpr bool is_contiguous_v = false;
+template<typename T>
+inline constexpr bool is_contiguous_v<MySpan<T>> = true;
+template<typename T>
+inline constexpr bool is_contiguous_v<MyVector<T>> = true;
+template<typename T, size_t N>
+inline constexpr bool is_contiguous_v<MyArray<T, N>> = true;
+
+template<typename C>
+concept contiguous_range = is_contiguous_v<std::remove_cvref_t<C>>;
+
+template<contiguous_range C>
+auto const_span(const C& c) noexcept {
+    if constexpr (requires { typename C::element_type; }) {
+        return MySpan<const typename C::value_type>(c.data(), c.size());
+    } else {
+        return MySpan(c);
+    }
+}
+
+template<contiguous_range C>
+auto mutable_span(C& c) noexcept {
+    if constexpr (requires { typename C::element_type; }) return c;
+    else return MySpan(c);
+}
+
+} // namespace my::detail
+
+#endif // MY_SPAN_H
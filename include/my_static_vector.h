@@ -0,0 +1,335 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_STATIC_VECTOR_H
+#define MY_STATIC_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// What MyStaticVector does when an insertion would exceed its capacity.
+enum class StaticOverflow {
+    throw_error,   // std::length_error, nothing is changed
+    terminate,     // std::terminate(); for code built without exception handling paths
+    unchecked      // caller guarantees it never happens (asserted in debug builds)
+};
+
+// Vector with room for N elements inside the object itself: no heap, ever.
+// Storage is uninitialized until elements are pushed, unlike MyArray, which
+// always holds N constructed elements. The API follows MyVector; anything
+// that would grow past N goes through the overflow policy, and try_push_back
+// / try_emplace_back report a full vector instead.
+//
+// With a trivially copyable T the whole object is trivially copyable (it
+// can be memcpy'd or sent over a queue as bytes); copies then take all N
+// slots, not just size() of them.
+template<typename T, size_t N, StaticOverflow Overflow = StaticOverflow::throw_error>
+class MyStaticVector {
+private:
+    static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+    alignas(T) unsigned char storage_[N > 0 ? N * sizeof(T) : 1];
+    size_t size_ = 0;
+
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+    // Applies the overflow policy if `extra` more elements do not fit.
+    void require(size_t extra, const char* what) const {
+        if (extra <= N - size_) return;
+        if constexpr (Overflow == StaticOverflow::throw_error) throw std::length_error(what);
+        else if constexpr (Overflow == StaticOverflow::terminate) std::terminate();
+        else assert(false && "MyStaticVector overflow");
+    }
+
+    // Shifting relocates elements one by one, so a move that throws halfway
+    // would leave raw slots inside [0, size_). Types without a nothrow move
+    // are appended and rotated into place instead (see emplace/insert/erase).
+    static constexpr bool kShiftSafe = kTrivial || std::is_nothrow_move_constructible_v<T>;
+
+    // Moves [idx, size_) up by `count` slots, leaving a gap of raw storage.
+    void shift_right(size_t idx, size_t count) noexcept {
+        static_assert(kShiftSafe);
+        T* d = data();
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(d + idx + count), static_cast<const void*>(d + idx),
+                         (size_ - idx) * sizeof(T));
+        } else {
+            for (size_t i = size_; i > idx; --i) {
+                new (d + i + count - 1) T(std::move_if_noexcept(d[i - 1]));
+                d[i - 1].~T();
+            }
+        }
+    }
+
+    // Moves [from, end) down by `count` slots onto raw storage.
+    void shift_left(size_t from, size_t end, size_t count) noexcept {
+        static_assert(kShiftSafe);
+        T* d = data();
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(d + from - count), static_cast<const void*>(d + from),
+                         (end - from) * sizeof(T));
+        } else {
+            for (size_t i = from; i < end; ++i) {
+                new (d + i - count) T(std::move_if_noexcept(d[i]));
+                d[i].~T();
+            }
+        }
+    }
+
+    void copy_from(const MyStaticVector& other) {
+        std::uninitialized_copy(other.begin(), other.end(), data());
+        size_ = other.size_;
+    }
+
+public:
+    using value_type = T;
+    static constexpr StaticOverflow overflow_policy = Overflow;
+
+    MyStaticVector() noexcept {}
+
+    MyStaticVector(size_t count, const T& value) {
+        require(count, "MyStaticVector: count exceeds capacity");
+        std::uninitialized_fill_n(data(), std::min(count, N), value);
+        size_ = std::min(count, N);
+    }
+
+    template<std::input_iterator InputIt>
+    MyStaticVector(InputIt first, InputIt last) {
+        try {
+            for (; first != last; ++first) emplace_back(*first);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    MyStaticVector(std::initializer_list<T> init) : MyStaticVector(init.begin(), init.end()) {}
+
+    MyStaticVector(const MyStaticVector&) requires kTrivial = default;
+    MyStaticVector(const MyStaticVector& other) { copy_from(other); }
+
+    MyStaticVector(MyStaticVector&&) requires kTrivial = default;
+    MyStaticVector(MyStaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move(other.begin(), other.end(), data());
+        size_ = other.size_;
+        other.clear();
+    }
+
+    MyStaticVector& operator=(const MyStaticVector&) requires kTrivial = default;
+    MyStaticVector& operator=(const MyStaticVector& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    MyStaticVector& operator=(MyStaticVector&&) requires kTrivial = default;
+    MyStaticVector& operator=(MyStaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            std::uninitialized_move(other.begin(), other.end(), data());
+            size_ = other.size_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~MyStaticVector() requires std::is_trivially_destructible_v<T> = default;
+    ~MyStaticVector() { clear(); }
+
+    T& operator[](size_t index) noexcept { return data()[index]; }
+    const T& operator[](size_t index) const noexcept { return data()[index]; }
+
+    T& at(size_t index) {
+        if (index >= size_) throw std::out_of_range("MyStaticVector::at");
+        return data()[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= size_) throw std::out_of_range("MyStaticVector::at");
+        return data()[index];
+    }
+
+    T& front() {
+        if (is_empty()) throw std::out_of_range("MyStaticVector::front");
+        return data()[0];
+    }
+    const T& front() const {
+        if (is_empty()) throw std::out_of_range("MyStaticVector::front");
+        return data()[0];
+    }
+
+    T& back() {
+        if (is_empty()) throw std::out_of_range("MyStaticVector::back");
+        return data()[size_ - 1];
+    }
+    const T& back() const {
+        if (is_empty()) throw std::out_of_range("MyStaticVector::back");
+        return data()[size_ - 1];
+    }
+
+    T* begin() noexcept { return data(); }
+    T* end() noexcept { return data() + size_; }
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + size_; }
+    const T* cbegin() const noexcept { return begin(); }
+    const T* cend() const noexcept { return end(); }
+
+    auto rbegin() noexcept { return std::reverse_iterator<T*>(end()); }
+    auto rend() noexcept { return std::reverse_iterator<T*>(begin()); }
+    auto rbegin() const noexcept { return std::reverse_iterator<const T*>(end()); }
+    auto rend() const noexcept { return std::reverse_iterator<const T*>(begin()); }
+
+    bool is_empty() const noexcept { return size_ == 0; }
+    bool is_full() const noexcept { return size_ == N; }
+    size_t size() const noexcept { return size_; }
+    static constexpr size_t capacity() noexcept { return N; }
+
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    void resize(size_t count, const T& value = T()) {
+        if (count < size_) {
+            std::destroy(begin() + count, end());
+        } else if (count > size_) {
+            require(count - size_, "MyStaticVector::resize");
+            count = std::min(count, N);
+            std::uninitialized_fill(end(), begin() + count, value);
+        }
+        size_ = count;
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        require(1, "MyStaticVector::emplace_back");
+        T* slot = new (data() + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Pointer to the new element, or nullptr (and no change) when full,
+    // whatever the overflow policy.
+    template<typename... Args>
+    T* try_emplace_back(Args&&... args) {
+        if (size_ == N) return nullptr;
+        T* slot = new (data() + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return slot;
+    }
+
+    bool try_push_back(const T& value) { return try_emplace_back(value) != nullptr; }
+    bool try_push_back(T&& value) { return try_emplace_back(std::move(value)) != nullptr; }
+
+    void pop_back() {
+        if (is_empty()) throw std::out_of_range("MyStaticVector::pop_back");
+        data()[--size_].~T();
+    }
+
+    // Constructs an element from `args` before `pos`; the arguments may
+    // refer to elements of *this. If T's move can throw, a failure after the
+    // element is built leaves every element valid and counted, in an
+    // unspecified order.
+    template<typename... Args>
+    T* emplace(T* pos, Args&&... args) {
+        if (pos < begin() || pos > end()) throw std::out_of_range("MyStaticVector::emplace");
+        require(1, "MyStaticVector::emplace");
+        const size_t idx = static_cast<size_t>(pos - begin());
+        if (idx == size_) return &emplace_back(std::forward<Args>(args)...);
+        T value(std::forward<Args>(args)...);
+        if constexpr (kShiftSafe) {
+            shift_right(idx, 1);
+            new (data() + idx) T(std::move(value));
+            ++size_;
+        } else {
+            new (data() + size_) T(std::move(value));
+            ++size_;
+            std::rotate(data() + idx, data() + size_ - 1, data() + size_);
+        }
+        return data() + idx;
+    }
+
+    T* insert(T* pos, const T& value) { return emplace(pos, value); }
+    T* insert(T* pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    // Inserts [first, last), which must not point into *this.
+    template<std::forward_iterator ForwardIt>
+    T* insert(T* pos, ForwardIt first, ForwardIt last) {
+        if (pos < begin() || pos > end()) throw std::out_of_range("MyStaticVector::insert");
+        const size_t idx = static_cast<size_t>(pos - begin());
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        require(count, "MyStaticVector::insert");
+        count = std::min(count, N - size_);
+        if constexpr (kShiftSafe) {
+            shift_right(idx, count);
+            try {
+                std::uninitialized_copy_n(first, count, data() + idx);
+            } catch (...) {
+                shift_left(idx + count, size_ + count, count);
+                throw;
+            }
+            size_ += count;
+        } else {
+            // A throwing copy leaves *this unchanged; only the rotation can
+            // fail after the new elements are counted.
+            std::uninitialized_copy_n(first, count, data() + size_);
+            const size_t old_size = size_;
+            size_ += count;
+            std::rotate(data() + idx, data() + old_size, data() + size_);
+        }
+        return data() + idx;
+    }
+
+    T* erase(T* pos) {
+        if (pos < begin() || pos >= end()) throw std::out_of_range("MyStaticVector::erase");
+        return erase(pos, pos + 1);
+    }
+
+    T* erase(T* first, T* last) {
+        if (first < begin() || last > end() || first > last) throw std::out_of_range("MyStaticVector::erase");
+        const size_t idx = static_cast<size_t>(first - begin());
+        const size_t count = static_cast<size_t>(last - first);
+        if constexpr (kShiftSafe) {
+            std::destroy(first, last);
+            shift_left(idx + count, size_, count);
+        } else {
+            std::move(last, end(), first);
+            std::destroy(end() - count, end());
+        }
+        size_ -= count;
+        return data() + idx;
+    }
+
+    void swap(MyStaticVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        MyStaticVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    auto operator<=>(const MyStaticVector& other) const {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+
+    bool operator==(const MyStaticVector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+};
+
+#endif // MY_STATIC_VECTOR_H
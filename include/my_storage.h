@@ -0,0 +1,64 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_STORAGE_H
+#define MY_STORAGE_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Raw storage management shared by MyVector and the containers built on it:
+// uninitialized allocation, destruction and relocation of element ranges.
+namespace my_storage {
+
+// Over-aligned types (e.g. alignas(64) per-thread slots) get the aligned
+// forms of operator new/delete.
+template<typename T>
+inline constexpr bool over_aligned_v = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+template<typename T>
+T* allocate(std::size_t count) {
+    if (count == 0) return nullptr;
+    if (count > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+    if constexpr (over_aligned_v<T>)
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+    else
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+}
+
+template<typename T>
+void deallocate(T* data) noexcept {
+    if constexpr (over_aligned_v<T>)
+        ::operator delete(data, std::align_val_t(alignof(T)));
+    else
+        ::operator delete(data);
+}
+
+template<typename T>
+void destroy(T* first, T* last) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (; first != last; ++first)
+            first->~T();
+    }
+}
+
+// Moves (or copies, if the move may throw) `count` elements from `src` into
+// uninitialized `dst` and destroys the sources. Ranges must not overlap.
+template<typename T>
+void relocate(T* src, std::size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (count) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            new (&dst[i]) T(std::move_if_noexcept(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+} // namespace my_storage
+
+#endif // MY_STORAGE_H
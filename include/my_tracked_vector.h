@@ -0,0 +1,380 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef MY_TRACKED_VECTOR_H
+#define MY_TRACKED_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "my_vector.h"
+
+namespace my_memory {
+
+// Buffers at least this large are trimmed by handing whole pages back with
+// madvise instead of reallocating and copying. glibc usually serves them with
+// mmap, but its threshold adapts at run time, so that is not guaranteed;
+// madvise works on heap pages too.
+inline constexpr size_t kMadviseBytes = size_t(1) << 20;
+
+inline size_t page_size() noexcept {
+#ifdef __linux__
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+class Registry;
+
+// What the registry needs from a tracked container. The registry links
+// entries through prev_/next_, so registering one never allocates.
+class Tracked {
+public:
+    // Bytes of storage currently held (capacity minus pages given back).
+    virtual size_t resident_bytes() const noexcept = 0;
+    // Bytes a trim would give back.
+    virtual size_t slack_bytes() const noexcept = 0;
+    // Gives the slack back; returns the bytes released.
+    virtual size_t release_slack() = 0;
+
+protected:
+    Tracked() noexcept = default;
+    // Links belong to the object, not its value.
+    Tracked(const Tracked&) noexcept {}
+    Tracked& operator=(const Tracked&) noexcept { return *this; }
+    ~Tracked() = default;
+
+private:
+    friend class Registry;
+    Tracked* prev_ = nullptr;
+    Tracked* next_ = nullptr;
+};
+
+// Process-wide accounting of MyTrackedVector storage. The byte total is an
+// atomic kept up to date by the vectors themselves, so reading it is cheap;
+// the mutex only guards the intrusive list of vectors.
+class Registry {
+private:
+    mutable std::mutex mutex_;
+    Tracked* head_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> bytes_{0};
+
+public:
+    void add(Tracked* entry) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry->prev_ = nullptr;
+        entry->next_ = head_;
+        if (head_) head_->prev_ = entry;
+        head_ = entry;
+        ++count_;
+    }
+
+    void remove(Tracked* entry) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entry->prev_) entry->prev_->next_ = entry->next_;
+        else if (head_ == entry) head_ = entry->next_;
+        else return;   // not registered
+        if (entry->next_) entry->next_->prev_ = entry->prev_;
+        entry->prev_ = entry->next_ = nullptr;
+        --count_;
+    }
+
+    void adjust(size_t added, size_t removed) noexcept {
+        if (added >= removed) bytes_.fetch_add(added - removed, std::memory_order_relaxed);
+        else bytes_.fetch_sub(removed - added, std::memory_order_relaxed);
+    }
+
+    size_t total_bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    // Releases slack, largest first, until the total is at most `target_bytes`
+    // or nothing is left to release. Returns the bytes released. The vectors
+    // must not be modified concurrently (call it from the thread that owns
+    // them, or at a point where their users are quiescent).
+    size_t trim_all(size_t target_bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (total_bytes() <= target_bytes) return 0;
+        MyVector<std::pair<size_t, Tracked*>> order;
+        order.reserve(count_);
+        for (Tracked* e = head_; e; e = e->next_)
+            if (size_t slack = e->slack_bytes()) order.push_back({slack, e});
+        std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        size_t released = 0;
+        for (auto& [slack, e] : order) {
+            released += e->release_slack();
+            if (total_bytes() <= target_bytes) break;
+        }
+        return released;
+    }
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+inline size_t total_bytes() noexcept { return registry().total_bytes(); }
+inline size_t trim_all(size_t target_bytes) { return registry().trim_all(target_bytes); }
+
+// Opt-in auto-shrink for MyTrackedVector: once size() has stayed below
+// `low_water` * capacity() for `patience` consecutive modifications, the
+// capacity drops to twice the size. The streak requirement keeps a vector
+// that oscillates around the threshold from reallocating on every pop.
+struct ShrinkPolicy {
+    double low_water = 0.25;
+    size_t patience = 64;
+    size_t min_slack_bytes = 64 * 1024;   // smaller gains are not worth a reallocation
+};
+
+} // namespace my_memory
+
+// MyVector that reports its storage to my_memory::registry() and can give
+// memory back, either on its own (with a ShrinkPolicy) or when something
+// calls my_memory::trim_all() under memory pressure. Buffers of at least
+// my_memory::kMadviseBytes are trimmed in place with madvise(MADV_DONTNEED):
+// capacity() is unchanged, but the unused tail pages stop counting against
+// the process until they are written again.
+template<typename T>
+class MyTrackedVector final : private my_memory::Tracked {
+private:
+    MyVector<T> data_;
+    bool auto_shrink_ = false;
+    my_memory::ShrinkPolicy policy_;
+    size_t low_streak_ = 0;
+    size_t accounted_ = 0;          // bytes last reported to the registry
+    const T* advised_data_ = nullptr;
+    size_t advised_from_ = 0;       // byte range [from, to) handed back with madvise
+    size_t advised_to_ = 0;
+
+    size_t capacity_bytes() const noexcept { return data_.capacity() * sizeof(T); }
+    size_t advised_bytes() const noexcept { return advised_to_ - advised_from_; }
+
+    size_t page_up(size_t bytes) const noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(data_.begin());
+        const size_t page = my_memory::page_size();
+        return ((base + bytes + page - 1) & ~(page - 1)) - base;
+    }
+
+    size_t page_down(size_t bytes) const noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(data_.begin());
+        return ((base + bytes) & ~(my_memory::page_size() - 1)) - base;
+    }
+
+    // Brings the advised range and the registry total up to date after any
+    // change to the underlying vector.
+    void sync() noexcept {
+        if (data_.begin() != advised_data_ || capacity_bytes() < advised_to_) {
+            advised_from_ = advised_to_ = 0;
+        } else if (advised_to_ != 0 && data_.size() * sizeof(T) > advised_from_) {
+            // Growth touched the first advised pages again.
+            advised_from_ = std::min(page_up(data_.size() * sizeof(T)), advised_to_);
+        }
+        const size_t now = resident_bytes();
+        if (now != accounted_) {
+            my_memory::registry().adjust(now, accounted_);
+            accounted_ = now;
+        }
+    }
+
+    // Keeps room for `keep` elements and gives the rest back.
+    size_t release(size_t keep) {
+        const size_t before = resident_bytes();
+#ifdef __linux__
+        if (capacity_bytes() >= my_memory::kMadviseBytes) {
+            const size_t from = page_up(keep * sizeof(T));
+            const size_t to = page_down(capacity_bytes());
+            const bool grows = advised_to_ == 0 || from < advised_from_;
+            if (from < to && grows && madvise(reinterpret_cast<char*>(data_.begin()) + from, to - from, MADV_DONTNEED) == 0) {
+                advised_data_ = data_.begin();
+                advised_from_ = from;
+                advised_to_ = to;
+            }
+            sync();
+            return before - resident_bytes();
+        }
+#endif
+        data_.shrink_to(keep);
+        sync();
+        return before - resident_bytes();
+    }
+
+    // Called after every modification.
+    void touched() {
+        sync();
+        if (!auto_shrink_) return;
+        if (double(data_.size()) >= policy_.low_water * double(data_.capacity())) {
+            low_streak_ = 0;
+            return;
+        }
+        if (++low_streak_ < policy_.patience) return;
+        low_streak_ = 0;
+        const size_t keep = data_.size() * 2;
+        if (resident_bytes() > keep * sizeof(T) + policy_.min_slack_bytes) release(keep);
+    }
+
+    void attach() noexcept {
+        my_memory::registry().add(this);
+        sync();
+    }
+
+public:
+    using value_type = T;
+
+    MyTrackedVector() { attach(); }
+
+    explicit MyTrackedVector(my_memory::ShrinkPolicy policy) : auto_shrink_(true), policy_(policy) { attach(); }
+
+    MyTrackedVector(size_t count, const T& value) : data_(count, value) { attach(); }
+
+    MyTrackedVector(std::initializer_list<T> init) : data_(init) { attach(); }
+
+    MyTrackedVector(const MyTrackedVector& other)
+        : Tracked(), data_(other.data_), auto_shrink_(other.auto_shrink_), policy_(other.policy_) {
+        attach();
+    }
+
+    // The pages `other` handed back go with its buffer.
+    MyTrackedVector(MyTrackedVector&& other) noexcept
+        : data_(std::move(other.data_)), auto_shrink_(other.auto_shrink_), policy_(other.policy_),
+          advised_data_(std::exchange(other.advised_data_, nullptr)),
+          advised_from_(std::exchange(other.advised_from_, 0)),
+          advised_to_(std::exchange(other.advised_to_, 0)) {
+        attach();
+        other.sync();
+    }
+
+    // Like the constructors, assignment carries the shrink policy along
+    // with the elements.
+    MyTrackedVector& operator=(const MyTrackedVector& other) {
+        if (this != &other) {
+            data_ = other.data_;
+            auto_shrink_ = other.auto_shrink_;
+            policy_ = other.policy_;
+            low_streak_ = 0;
+            touched();
+        }
+        return *this;
+    }
+
+    MyTrackedVector& operator=(MyTrackedVector&& other) noexcept {
+        if (this != &other) {
+            data_ = std::move(other.data_);
+            auto_shrink_ = other.auto_shrink_;
+            policy_ = other.policy_;
+            low_streak_ = 0;
+            advised_data_ = std::exchange(other.advised_data_, nullptr);
+            advised_from_ = std::exchange(other.advised_from_, 0);
+            advised_to_ = std::exchange(other.advised_to_, 0);
+            sync();
+            other.sync();
+        }
+        return *this;
+    }
+
+    ~MyTrackedVector() {
+        my_memory::registry().remove(this);
+        my_memory::registry().adjust(0, accounted_);
+    }
+
+    T& operator[](size_t index) noexcept { return data_[index]; }
+    const T& operator[](size_t index) const noexcept { return data_[index]; }
+    T& at(size_t index) { return data_.at(index); }
+    const T& at(size_t index) const { return data_.at(index); }
+    T& front() { return data_.front(); }
+    const T& front() const { return data_.front(); }
+    T& back() { return data_.back(); }
+    const T& back() const { return data_.back(); }
+
+    T* begin() noexcept { return data_.begin(); }
+    const T* begin() const noexcept { return data_.begin(); }
+    T* end() noexcept { return data_.end(); }
+    const T* end() const noexcept { return data_.end(); }
+
+    bool is_empty() const noexcept { return data_.is_empty(); }
+    size_t size() const noexcept { return data_.size(); }
+    size_t capacity() const noexcept { return data_.capacity(); }
+
+    size_t resident_bytes() const noexcept override { return capacity_bytes() - advised_bytes(); }
+    size_t slack_bytes() const noexcept override {
+        const size_t used = data_.size() * sizeof(T);
+        const size_t resident = resident_bytes();
+        return resident > used ? resident - used : 0;
+    }
+    size_t release_slack() override { return release(data_.size()); }
+
+    bool auto_shrink() const noexcept { return auto_shrink_; }
+    const my_memory::ShrinkPolicy& policy() const noexcept { return policy_; }
+
+    void reserve(size_t new_cap) {
+        data_.reserve(new_cap);
+        sync();
+    }
+    void shrink_to_fit() { release(data_.size()); }
+
+    void clear() {
+        data_.clear();
+        touched();
+    }
+
+    void resize(size_t count, const T& value = T()) {
+        data_.resize(count, value);
+        touched();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        data_.emplace_back(std::forward<Args>(args)...);
+        touched();
+        return data_.back();
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        data_.pop_back();
+        touched();
+    }
+
+    T* insert(T* pos, const T& value) {
+        const size_t index = static_cast<size_t>(pos - data_.begin());
+        data_.insert(pos, value);
+        touched();
+        return data_.begin() + index;
+    }
+
+    T* erase(T* pos) {
+        const size_t index = static_cast<size_t>(pos - data_.begin());
+        data_.erase(pos);
+        touched();
+        return data_.begin() + index;
+    }
+
+    T* erase(T* first, T* last) {
+        const size_t index = static_cast<size_t>(first - data_.begin());
+        data_.erase(first, last);
+        touched();
+        return data_.begin() + index;
+    }
+
+    bool operator==(const MyTrackedVector& other) const { return data_ == other.data_; }
+};
+
+#endif // MY_TRACKED_VECTOR_H
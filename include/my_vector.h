@@ -6,6 +6,13 @@
 #include <iterator>
 #include <initializer_list>
 #include <compare>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "my_simd.h"
+#include "my_storage.h"
 
 template<typename T>
 class MyVector {
@@ -14,6 +21,28 @@ private:
     size_t size_;
     size_t capacity_;
 
+    // Moves [idx, size_) to [idx + count, size_ + count) in place, leaving
+    // the gap uninitialized. Capacity must already be sufficient.
+    void shift_right(size_t idx, size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(static_cast<void*>(data_ + idx + count), static_cast<const void*>(data_ + idx),
+                         (size_ - idx) * sizeof(T));
+        } else {
+            for (size_t i = size_; i > idx; --i) {
+                new (&data_[i + count - 1]) T(std::move_if_noexcept(data_[i - 1]));
+                data_[i - 1].~T();
+            }
+        }
+    }
+
+    // Inverse of shift_right: moves [from, size_ + count) back by `count`.
+    void shift_left(size_t from, size_t count) {
+        for (size_t i = from; i < size_ + count; ++i) {
+            new (&data_[i - count]) T(std::move_if_noexcept(data_[i]));
+            data_[i].~T();
+        }
+    }
+
 public:
     using value_type = T;
 
@@ -23,22 +52,54 @@ public:
     MyVector(size_t count, const T& value)
         : data_(nullptr), size_(0), capacity_(0) {
         reserve(count);
-        for (size_t i = 0; i < count; ++i)
-            new (&data_[i]) T(value);
+        if constexpr (my_simd::has_simd_fill<T>) {
+            my_simd::fill(data_, count, value);
+        } else {
+            for (size_t i = 0; i < count; ++i)
+                new (&data_[i]) T(value);
+        }
         size_ = count;
     }
 
-    template<typename InputIt>
+    // Constructs the elements in place; pass std::move_iterator to move them.
+    template<std::input_iterator InputIt>
     MyVector(InputIt first, InputIt last)
         : data_(nullptr), size_(0), capacity_(0) {
-        size_t count = std::distance(first, last);
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_t count = std::distance(first, last);
+            reserve(count);
+            try {
+                std::uninitialized_copy(first, last, data_);
+            } catch (...) {
+                my_storage::deallocate(data_);
+                throw;
+            }
+            size_ = count;
+        } else {
+            try {
+                for (; first != last; ++first) emplace_back(*first);
+            } catch (...) {
+                clear();
+                my_storage::deallocate(data_);
+                throw;
+            }
+        }
+    }
+
+    // One-pass evaluation of a lazy element-wise expression (see my_expr.h).
+    template<typename E>
+        requires requires { typename E::my_expression_tag; }
+    MyVector(const E& expr)
+        : data_(nullptr), size_(0), capacity_(0) {
+        const size_t count = expr.size();
         reserve(count);
-        std::copy(first, last, data_);
+        for (size_t i = 0; i < count; ++i)
+            new (&data_[i]) T(expr[i]);
         size_ = count;
     }
 
     MyVector(std::initializer_list<T> init)
-    : data_(static_cast<T*>(::operator new(init.size() * sizeof(T)))),
+    : data_(my_storage::allocate<T>(init.size())),
       size_(init.size()),
       capacity_(init.size())
     {
@@ -51,18 +112,22 @@ public:
             for (size_t j = 0; j < i; ++j) {
                 data_[j].~T();
             }
-            ::operator delete(data_);
+            my_storage::deallocate(data_);
             throw;
         }
     }
 
     MyVector(const MyVector& other)
-    : data_(static_cast<T*>(::operator new(other.capacity_ * sizeof(T)))),
+    : data_(my_storage::allocate<T>(other.capacity_)),
       size_(other.size_),
       capacity_(other.capacity_)
     {
-        for (size_t i = 0; i < size_; ++i) {
-            new (&data_[i]) T(other.data_[i]);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_) std::memcpy(static_cast<void*>(data_), static_cast<const void*>(other.data_), size_ * sizeof(T));
+        } else {
+            for (size_t i = 0; i < size_; ++i) {
+                new (&data_[i]) T(other.data_[i]);
+            }
         }
     }
 
@@ -78,7 +143,7 @@ public:
 
     ~MyVector() {
         clear();
-        ::operator delete(data_);
+        my_storage::deallocate(data_);
     }
 
     MyVector& operator=(const MyVector& other) {
@@ -92,7 +157,7 @@ public:
     MyVector& operator=(MyVector&& other) noexcept {
         if (this != &other) {
             clear();
-            ::operator delete(data_);
+            my_storage::deallocate(data_);
             data_ = other.data_;
             size_ = other.size_;
             capacity_ = other.capacity_;
@@ -102,6 +167,21 @@ public:
         return *this;
     }
 
+    // Element i of the result depends only on element i of the operands, so
+    // evaluating in place is safe when *this appears in the expression.
+    template<typename E>
+        requires requires { typename E::my_expression_tag; }
+    MyVector& operator=(const E& expr) {
+        if (expr.size() != size_) {
+            MyVector tmp(expr);
+            swap(tmp);
+            return *this;
+        }
+        for (size_t i = 0; i < size_; ++i)
+            data_[i] = expr[i];
+        return *this;
+    }
+
     T& operator[](size_t index) noexcept { return data_[index]; }
     const T& operator[](size_t index) const noexcept { return data_[index]; }
 
@@ -153,31 +233,24 @@ public:
     void reserve(size_t new_cap) {
         if (new_cap <= capacity_) return;
 
-        T* new_data = static_cast<T*>(::operator new(new_cap * sizeof(T)));
-
-        for (size_t i = 0; i < size_; ++i) {
-            new (&new_data[i]) T(std::move_if_noexcept(data_[i]));
-            data_[i].~T();
-        }
-
-        ::operator delete(data_);
+        T* new_data = my_storage::allocate<T>(new_cap);
+        my_storage::relocate(data_, size_, new_data);
+        my_storage::deallocate(data_);
         data_ = new_data;
         capacity_ = new_cap;
     }
 
-    void shrink_to_fit() {
-        if (size_ < capacity_) {
-            T* new_data = nullptr;
-            if (size_) {
-                new_data = static_cast<T*>(::operator new(size_ * sizeof(T)));
-                for (size_t i = 0; i < size_; ++i) {
-                    new (&new_data[i]) T(std::move_if_noexcept(data_[i]));
-                    data_[i].~T();
-                }
-            }
-            ::operator delete(data_);
+    void shrink_to_fit() { shrink_to(size_); }
+
+    // Reallocates to max(new_cap, size()) if that is below capacity().
+    void shrink_to(size_t new_cap) {
+        new_cap = std::max(new_cap, size_);
+        if (new_cap < capacity_) {
+            T* new_data = my_storage::allocate<T>(new_cap);
+            my_storage::relocate(data_, size_, new_data);
+            my_storage::deallocate(data_);
             data_ = new_data;
-            capacity_ = size_;
+            capacity_ = new_cap;
         }
     }
 
@@ -192,47 +265,113 @@ public:
             for (size_t i = count; i < size_; ++i)
                 data_[i].~T();
         } else if (count > size_) {
+            const T copy(value);   // `value` may live in the old buffer
             reserve(count);
-            for (size_t i = size_; i < count; ++i)
-                new (&data_[i]) T(value);
+            if constexpr (my_simd::has_simd_fill<T>) {
+                my_simd::fill(data_ + size_, count - size_, copy);
+            } else {
+                for (size_t i = size_; i < count; ++i)
+                    new (&data_[i]) T(copy);
+            }
         }
         size_ = count;
     }
 
+    // Appends `count` elements that init(first) constructs in the raw
+    // storage [first, first + count), possibly from several threads. init
+    // must construct all of them, or throw with none of them alive.
+    template<typename Init>
+    void append_with(size_t count, Init&& init) {
+        if (size_ + count > capacity_) reserve(std::max(capacity_ * 2, size_ + count));
+        init(data_ + size_);
+        size_ += count;
+    }
+
     void swap(MyVector& other) noexcept {
         std::swap(data_, other.data_);
         std::swap(size_, other.size_);
         std::swap(capacity_, other.capacity_);
     }
 
-    T* insert(T* pos, const T& value) {
+    T* insert(T* pos, const T& value) { return emplace(pos, value); }
+    T* insert(T* pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    // Inserts [first, last), which must not point into *this. Pass
+    // std::move_iterator to move the elements in.
+    template<std::input_iterator InputIt>
+    T* insert(T* pos, InputIt first, InputIt last) {
+        if (pos < data_ || pos > end()) throw std::out_of_range("insert range");
         size_t idx = pos - data_;
-        if (pos < data_ || pos > end()) throw std::out_of_range("insert");
-        if (size_ == capacity_) reserve(capacity_ ? capacity_ * 2 : 1);
-        pos = data_ + idx;
-        for (size_t i = size_; i > idx; --i) {
-            new (&data_[i]) T(std::move_if_noexcept(data_[i - 1]));
-            data_[i - 1].~T();
+        if constexpr (!std::forward_iterator<InputIt>) {
+            for (size_t i = idx; first != last; ++first, ++i)
+                emplace(data_ + i, *first);
+            return data_ + idx;
+        } else {
+            size_t count = std::distance(first, last);
+            if (count == 0) return data_ + idx;
+            if (size_ + count > capacity_) {
+                size_t new_cap = std::max(capacity_ * 2, size_ + count);
+                T* new_data = my_storage::allocate<T>(new_cap);
+                try {
+                    std::uninitialized_copy(first, last, new_data + idx);
+                } catch (...) {
+                    my_storage::deallocate(new_data);
+                    throw;
+                }
+                my_storage::relocate(data_, idx, new_data);
+                my_storage::relocate(data_ + idx, size_ - idx, new_data + idx + count);
+                my_storage::deallocate(data_);
+                data_ = new_data;
+                capacity_ = new_cap;
+            } else {
+                shift_right(idx, count);
+                try {
+                    std::uninitialized_copy(first, last, data_ + idx);
+                } catch (...) {
+                    shift_left(idx + count, count);
+                    throw;
+                }
+            }
+            size_ += count;
+            return data_ + idx;
         }
-        new (&data_[idx]) T(value);
-        ++size_;
-        return data_ + idx;
     }
 
-    template<typename InputIt>
-    T* insert(T* pos, InputIt first, InputIt last) {
+    // Constructs an element from `args` before `pos`. The arguments may refer
+    // to elements of *this.
+    template<typename... Args>
+    T* emplace(T* pos, Args&&... args) {
+        if (pos < data_ || pos > end()) throw std::out_of_range("emplace");
         size_t idx = pos - data_;
-        size_t count = std::distance(first, last);
-        if (pos < data_ || pos > end()) throw std::out_of_range("insert range");
-        if (size_ + count > capacity_) reserve(std::max(capacity_ * 2, size_ + count));
-        pos = data_ + idx;
-        for (size_t i = size_; i > idx; --i) {
-            new (&data_[i + count - 1]) T(std::move_if_noexcept(data_[i - 1]));
-            data_[i - 1].~T();
+        if (idx == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return data_ + idx;
         }
-        for (size_t i = 0; i < count; ++i)
-            new (&data_[idx + i]) T(*std::next(first, i));
-        size_ += count;
+        T value(std::forward<Args>(args)...);
+        if (size_ == capacity_) {
+            size_t new_cap = capacity_ * 2;
+            T* new_data = my_storage::allocate<T>(new_cap);
+            try {
+                new (new_data + idx) T(std::move(value));
+            } catch (...) {
+                my_storage::deallocate(new_data);
+                throw;
+            }
+            my_storage::relocate(data_, idx, new_data);
+            my_storage::relocate(data_ + idx, size_ - idx, new_data + idx + 1);
+            my_storage::deallocate(data_);
+            data_ = new_data;
+            capacity_ = new_cap;
+        } else {
+            shift_right(idx, 1);
+            try {
+                new (data_ + idx) T(std::move(value));
+            } catch (...) {
+                shift_left(idx + 1, 1);
+                throw;
+            }
+        }
+        ++size_;
         return data_ + idx;
     }
 
@@ -262,35 +401,55 @@ public:
         return data_ + idx;
     }
 
-    void push_back(const T& value) {
-        if (size_ == capacity_) {
-            T value_copy = value;
-            reserve(capacity_ ? capacity_ * 2 : 1);
-            new (&data_[size_++]) T(std::move(value_copy));
-        } else {
-            new (&data_[size_++]) T(value);
-        }
-    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
 
     void pop_back() {
         if (is_empty()) throw std::out_of_range("pop_back");
-        data_[--size_ - 1].~T();
+        data_[--size_].~T();
     }
 
+    // On growth the new element is built in the new buffer before the old
+    // ones are relocated, so `args` may refer to elements of *this.
     template<typename... Args>
-    void emplace_back(Args&&... args) {
-        if (size_ == capacity_)
-            reserve(capacity_ ? capacity_ * 2 : 1);
-        new (&data_[size_++]) T(std::forward<Args>(args)...);
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            size_t new_cap = capacity_ ? capacity_ * 2 : 1;
+            T* new_data = my_storage::allocate<T>(new_cap);
+            try {
+                new (new_data + size_) T(std::forward<Args>(args)...);
+            } catch (...) {
+                my_storage::deallocate(new_data);
+                throw;
+            }
+            my_storage::relocate(data_, size_, new_data);
+            my_storage::deallocate(data_);
+            data_ = new_data;
+            capacity_ = new_cap;
+        } else {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
     }
 
+    // Integral, enum and pointer elements are compared with the run-time
+    // dispatched kernels from my_simd.h.
     auto operator<=>(const MyVector& other) const {
-        return std::lexicographical_compare_three_way(
-            begin(), end(), other.begin(), other.end());
+        if constexpr (my_simd::is_bitwise_comparable<T>) {
+            const size_t common = std::min(size_, other.size_);
+            const size_t i = common ? my_simd::mismatch(data_, other.data_, common) : 0;
+            if (i < common) return data_[i] <=> other.data_[i];
+            return size_ <=> other.size_;
+        } else {
+            return std::lexicographical_compare_three_way(
+                begin(), end(), other.begin(), other.end());
+        }
     }
 
     bool operator==(const MyVector& other) const {
         if (size_ != other.size_) return false;
+        if constexpr (my_simd::is_bitwise_comparable<T>)
+            return size_ == 0 || my_simd::equal(data_, other.data_, size_);
         for (size_t i = 0; i < size_; ++i)
             if (!(data_[i] == other.data_[i]))
                 return false;
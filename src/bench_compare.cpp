@@ -0,0 +1,399 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+// bench_compare: compares two benchmark result files and exits non-zero when
+// the current one is significantly slower than the baseline.
+//
+// Accepted inputs:
+//  - results.csv written by `compare` (container,operation,size,run,time_us[,counters...])
+//  - Google Benchmark JSON (--benchmark_format=json), non-aggregate entries only
+//
+// For every (container, operation, size) present in both files it reports the
+// medians, their ratio and a bootstrap confidence interval of that ratio.
+// A row is a regression when the lower bound of the interval is above
+// 1 + threshold, i.e. the slowdown is both larger than the threshold and
+// statistically significant.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Key {
+    std::string container;
+    std::string operation;
+    std::size_t size = 0;
+
+    bool operator<(const Key& other) const {
+        return std::tie(container, operation, size) < std::tie(other.container, other.operation, other.size);
+    }
+};
+
+using Samples = std::map<Key, std::vector<double>>;
+
+struct Options {
+    std::string baseline;
+    std::string current;
+    double threshold = 0.05;
+    double confidence = 0.95;
+    int resamples = 2000;
+    double min_time_us = 10.0; // time_us has 1 us resolution, shorter rows are noise
+    unsigned seed = 42;
+};
+
+std::vector<std::string> split_csv_line(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream in(line);
+    while (std::getline(in, field, ',')) fields.push_back(field);
+    if (!line.empty() && line.back() == ',') fields.emplace_back();
+    return fields;
+}
+
+Samples read_csv(std::istream& in, const std::string& path) {
+    std::string line;
+    if (!std::getline(in, line)) throw std::runtime_error(path + ": empty file");
+    auto header = split_csv_line(line);
+    auto column = [&](const std::string& name) {
+        auto it = std::find(header.begin(), header.end(), name);
+        if (it == header.end()) throw std::runtime_error(path + ": missing column " + name);
+        return static_cast<std::size_t>(it - header.begin());
+    };
+    const std::size_t c_container = column("container");
+    const std::size_t c_operation = column("operation");
+    const std::size_t c_size = column("size");
+    const std::size_t c_time = column("time_us");
+    const std::size_t needed = std::max({c_container, c_operation, c_size, c_time}) + 1;
+
+    Samples samples;
+    std::size_t line_no = 1;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        auto fields = split_csv_line(line);
+        if (fields.size() < needed)
+            throw std::runtime_error(path + ":" + std::to_string(line_no) + ": too few fields");
+        Key key{fields[c_container], fields[c_operation], std::stoul(fields[c_size])};
+        samples[key].push_back(std::stod(fields[c_time]));
+    }
+    return samples;
+}
+
+// Just enough JSON to read Google Benchmark output.
+class JsonReader {
+public:
+    struct Value {
+        enum class Type { null, boolean, number, string, array, object } type = Type::null;
+        double number = 0;
+        bool boolean = false;
+        std::string string;
+        std::vector<Value> array;
+        std::vector<std::pair<std::string, Value>> object;
+
+        const Value* find(const std::string& key) const {
+            for (const auto& [k, v] : object)
+                if (k == key) return &v;
+            return nullptr;
+        }
+    };
+
+    explicit JsonReader(std::string text) : text_(std::move(text)) {}
+
+    Value parse() {
+        Value v = value();
+        skip_ws();
+        if (pos_ != text_.size()) fail("trailing characters");
+        return v;
+    }
+
+private:
+    std::string text_;
+    std::size_t pos_ = 0;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("JSON parse error at offset " + std::to_string(pos_) + ": " + what);
+    }
+
+    void skip_ws() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    char peek() {
+        skip_ws();
+        if (pos_ >= text_.size()) fail("unexpected end");
+        return text_[pos_];
+    }
+
+    void expect(char c) {
+        if (peek() != c) fail(std::string("expected '") + c + "'");
+        ++pos_;
+    }
+
+    bool consume(const char* word) {
+        std::string w(word);
+        if (text_.compare(pos_, w.size(), w) != 0) return false;
+        pos_ += w.size();
+        return true;
+    }
+
+    Value value() {
+        Value v;
+        char c = peek();
+        if (c == '{') {
+            v.type = Value::Type::object;
+            ++pos_;
+            if (peek() == '}') { ++pos_; return v; }
+            do {
+                std::string key = string();
+                expect(':');
+                v.object.emplace_back(std::move(key), value());
+            } while (peek() == ',' && ++pos_);
+            expect('}');
+        } else if (c == '[') {
+            v.type = Value::Type::array;
+            ++pos_;
+            if (peek() == ']') { ++pos_; return v; }
+            do {
+                v.array.push_back(value());
+            } while (peek() == ',' && ++pos_);
+            expect(']');
+        } else if (c == '"') {
+            v.type = Value::Type::string;
+            v.string = string();
+        } else if (consume("true")) {
+            v.type = Value::Type::boolean;
+            v.boolean = true;
+        } else if (consume("false")) {
+            v.type = Value::Type::boolean;
+        } else if (consume("null")) {
+            v.type = Value::Type::null;
+        } else {
+            v.type = Value::Type::number;
+            const char* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            v.number = std::strtod(begin, &end);
+            if (end == begin) fail("invalid value");
+            pos_ += static_cast<std::size_t>(end - begin);
+        }
+        return v;
+    }
+
+    std::string string() {
+        expect('"');
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (pos_ >= text_.size()) fail("bad escape");
+                char e = text_[pos_++];
+                switch (e) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': pos_ += 4; out += '?'; break; // names are ASCII in practice
+                default: out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        expect('"');
+        return out;
+    }
+};
+
+double to_microseconds(double value, const std::string& unit) {
+    if (unit == "ns") return value / 1e3;
+    if (unit == "us") return value;
+    if (unit == "ms") return value * 1e3;
+    if (unit == "s") return value * 1e6;
+    throw std::runtime_error("unknown time_unit " + unit);
+}
+
+// "BM_PushBack<MyVector<int>>/1000/repeats:5" -> container "BM_PushBack<MyVector<int>>",
+// operation = the remaining non-numeric parts, size = the first numeric argument.
+Key key_from_benchmark_name(const std::string& name) {
+    Key key;
+    std::istringstream in(name);
+    std::string part;
+    bool first = true;
+    bool have_size = false;
+    while (std::getline(in, part, '/')) {
+        if (first) {
+            key.container = part;
+            first = false;
+        } else if (!have_size && !part.empty()
+                   && std::all_of(part.begin(), part.end(), [](unsigned char ch) { return std::isdigit(ch); })) {
+            key.size = std::stoul(part);
+            have_size = true;
+        } else {
+            key.operation += key.operation.empty() ? part : "/" + part;
+        }
+    }
+    if (key.operation.empty()) key.operation = "run";
+    return key;
+}
+
+Samples read_json(const std::string& text, const std::string& path) {
+    auto root = JsonReader(text).parse();
+    const auto* benchmarks = root.find("benchmarks");
+    if (!benchmarks || benchmarks->type != JsonReader::Value::Type::array)
+        throw std::runtime_error(path + ": no \"benchmarks\" array");
+
+    Samples samples;
+    for (const auto& b : benchmarks->array) {
+        const auto* run_type = b.find("run_type");
+        if (run_type && run_type->string == "aggregate") continue;
+        const auto* name = b.find("run_name");
+        if (!name) name = b.find("name");
+        const auto* time = b.find("real_time");
+        const auto* unit = b.find("time_unit");
+        if (!name || !time) throw std::runtime_error(path + ": benchmark entry without name/real_time");
+        samples[key_from_benchmark_name(name->string)].push_back(
+            to_microseconds(time->number, unit ? unit->string : "ns"));
+    }
+    return samples;
+}
+
+Samples read_results(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    auto first = text.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && text[first] == '{') return read_json(text, path);
+    std::istringstream csv(text);
+    return read_csv(csv, path);
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    std::size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+
+double quantile(std::vector<double>& sorted, double q) {
+    double idx = q * static_cast<double>(sorted.size() - 1);
+    auto lo = static_cast<std::size_t>(idx);
+    std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (idx - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]);
+}
+
+// Percentile bootstrap of median(current) / median(baseline).
+std::pair<double, double> bootstrap_ratio_ci(const std::vector<double>& base, const std::vector<double>& cur,
+                                             const Options& opts, std::mt19937& gen) {
+    std::vector<double> ratios;
+    ratios.reserve(static_cast<std::size_t>(opts.resamples));
+    std::vector<double> b(base.size()), c(cur.size());
+    std::uniform_int_distribution<std::size_t> pick_b(0, base.size() - 1), pick_c(0, cur.size() - 1);
+    for (int r = 0; r < opts.resamples; ++r) {
+        for (auto& x : b) x = base[pick_b(gen)];
+        for (auto& x : c) x = cur[pick_c(gen)];
+        double mb = median(b);
+        if (mb > 0) ratios.push_back(median(c) / mb);
+    }
+    if (ratios.empty()) return {0, 0};
+    std::sort(ratios.begin(), ratios.end());
+    double alpha = (1.0 - opts.confidence) / 2.0;
+    return {quantile(ratios, alpha), quantile(ratios, 1.0 - alpha)};
+}
+
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    std::vector<std::string> positional;
+    auto value = [&](int& i) -> std::string {
+        if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + argv[i]);
+        return argv[++i];
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threshold") opts.threshold = std::stod(value(i));
+        else if (arg == "--confidence") opts.confidence = std::stod(value(i));
+        else if (arg == "--resamples") opts.resamples = std::stoi(value(i));
+        else if (arg == "--min-time") opts.min_time_us = std::stod(value(i));
+        else if (arg == "--seed") opts.seed = static_cast<unsigned>(std::stoul(value(i)));
+        else if (!arg.empty() && arg[0] == '-') throw std::invalid_argument("unknown option " + arg);
+        else positional.push_back(arg);
+    }
+    if (positional.size() != 2) throw std::invalid_argument("expected BASELINE and CURRENT files");
+    if (opts.confidence <= 0 || opts.confidence >= 1) throw std::invalid_argument("--confidence must be in (0, 1)");
+    if (opts.resamples < 1) throw std::invalid_argument("--resamples must be positive");
+    opts.baseline = positional[0];
+    opts.current = positional[1];
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    Samples base, cur;
+    try {
+        opts = parse_options(argc, argv);
+        base = read_results(opts.baseline);
+        cur = read_results(opts.current);
+    } catch (const std::exception& e) {
+        std::cerr << "bench_compare: " << e.what() << "\n"
+                  << "usage: bench_compare BASELINE CURRENT [--threshold 0.05] [--confidence 0.95]"
+                     " [--resamples 2000] [--min-time 10] [--seed 42]\n";
+        return 2;
+    }
+
+    std::mt19937 gen(opts.seed);
+    int regressions = 0, improvements = 0, compared = 0;
+
+    std::cout << std::left << std::setw(28) << "container" << std::setw(20) << "operation"
+              << std::right << std::setw(10) << "size" << std::setw(12) << "base_us"
+              << std::setw(12) << "cur_us" << std::setw(9) << "ratio" << std::setw(20) << "ci"
+              << "  verdict\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const auto& [key, base_samples] : base) {
+        auto it = cur.find(key);
+        if (it == cur.end()) continue;
+        const auto& cur_samples = it->second;
+        double mb = median(base_samples), mc = median(cur_samples);
+
+        std::cout << std::left << std::setw(28) << key.container << std::setw(20) << key.operation
+                  << std::right << std::setw(10) << key.size << std::setw(12) << mb << std::setw(12) << mc;
+        if (mb <= 0 || std::max(mb, mc) < opts.min_time_us) {
+            std::cout << std::setw(9) << "-" << std::setw(20) << "-" << "  too fast to compare\n";
+            continue;
+        }
+        ++compared;
+        auto [lo, hi] = bootstrap_ratio_ci(base_samples, cur_samples, opts, gen);
+        std::ostringstream ci;
+        ci << std::fixed << std::setprecision(2) << "[" << lo << ", " << hi << "]";
+
+        const char* verdict = "ok";
+        if (lo > 1.0 + opts.threshold) {
+            verdict = "REGRESSION";
+            ++regressions;
+        } else if (hi < 1.0 / (1.0 + opts.threshold)) {
+            verdict = "improvement";
+            ++improvements;
+        }
+        std::cout << std::setw(9) << mc / mb << std::setw(20) << ci.str() << "  " << verdict << "\n";
+    }
+
+    std::cout << compared << " compared, " << regressions << " regressions, "
+              << improvements << " improvements (threshold " << opts.threshold * 100 << "%, "
+              << opts.confidence * 100 << "% CI)\n";
+    return regressions ? 1 : 0;
+}
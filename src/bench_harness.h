@@ -0,0 +1,236 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "perf_counters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+struct BenchOptions {
+    int runs = 5;
+    int warmup = 1;
+    int cpu = -1;          // -1 = do not pin
+    bool perf = false;     // collect hardware counters
+    std::string out = "results.csv";
+    std::string filter;    // run only rows whose "container,operation" contains it
+    bool large = false;    // include the largest sizes (10^8 elements and up)
+};
+
+// Parses the common benchmark flags on top of `opts`; throws std::invalid_argument.
+inline BenchOptions parse_bench_options(int argc, char** argv, BenchOptions opts = {}) {
+    auto value = [&](int& i) -> std::string {
+        if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + argv[i]);
+        return argv[++i];
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--runs") opts.runs = std::stoi(value(i));
+        else if (arg == "--warmup") opts.warmup = std::stoi(value(i));
+        else if (arg == "--cpu") opts.cpu = std::stoi(value(i));
+        else if (arg == "--perf") opts.perf = true;
+        else if (arg == "--out") opts.out = value(i);
+        else if (arg == "--filter") opts.filter = value(i);
+        else if (arg == "--large") opts.large = true;
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opts.runs < 1) throw std::invalid_argument("--runs must be positive");
+    if (opts.warmup < 0) throw std::invalid_argument("--warmup must be non-negative");
+    return opts;
+}
+
+inline bool pin_to_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Keeps the optimizer from discarding a benchmark's result.
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    volatile const T* sink = &value;
+    (void)sink;
+#endif
+}
+
+template<typename F>
+long long time_us(F fn) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    fn();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+}
+
+// Runs each benchmark `warmup` times untimed, then `runs` times timed,
+// writes one CSV row per timed run and keeps the samples for the summary.
+class BenchHarness {
+public:
+    BenchHarness(const BenchOptions& opts, std::ostream* csv)
+        : opts_(opts), csv_(csv) {
+        if (opts_.cpu >= 0 && !pin_to_cpu(opts_.cpu))
+            std::cerr << "warning: could not pin to CPU " << opts_.cpu << "\n";
+        if (opts_.perf && !counters_.open()) {
+            std::cerr << "warning: perf_event_open failed, counter columns stay empty\n";
+            opts_.perf = false;
+        }
+        if (csv_) {
+            *csv_ << "container,operation,size,run,time_us";
+            for (auto name : PerfCounters::names) *csv_ << "," << name;
+            *csv_ << "\n";
+        }
+    }
+
+    const BenchOptions& options() const noexcept { return opts_; }
+
+    bool selected(const std::string& container, const std::string& operation) const {
+        return opts_.filter.empty()
+            || (container + "," + operation).find(opts_.filter) != std::string::npos;
+    }
+
+    // True if any of the rows would run; lets suites skip expensive preparation.
+    bool selected_any(std::initializer_list<const char*> containers,
+                      std::initializer_list<const char*> operations) const {
+        for (auto c : containers)
+            for (auto o : operations)
+                if (selected(c, o)) return true;
+        return false;
+    }
+
+    // `setup` runs before every repetition (warm-up included) and is not timed.
+    template<typename Setup, typename Body>
+    void run(const std::string& container, const std::string& operation, std::size_t size,
+             Setup setup, Body body) {
+        if (!selected(container, operation)) return;
+        for (int i = 0; i < opts_.warmup; ++i) {
+            setup();
+            body();
+        }
+        Series series{container, operation, size, {}};
+        for (int run = 1; run <= opts_.runs; ++run) {
+            setup();
+            Sample sample;
+            if (opts_.perf) counters_.start();
+            sample.time_us = time_us(body);
+            sample.counters = opts_.perf ? counters_.stop() : empty_counters();
+            write_row(series, run, sample);
+            series.samples.push_back(sample);
+        }
+        series_.push_back(std::move(series));
+    }
+
+    template<typename Body>
+    void run(const std::string& container, const std::string& operation, std::size_t size,
+             Body body) {
+        run(container, operation, size, [] {}, body);
+    }
+
+    // Median wall time of a finished row, or -1 if it did not run.
+    long long median_us(const std::string& container, const std::string& operation, std::size_t size) const {
+        for (const auto& s : series_) {
+            if (s.container != container || s.operation != operation || s.size != size) continue;
+            std::vector<long long> times;
+            for (const auto& sample : s.samples) times.push_back(sample.time_us);
+            return percentile(times, 50);
+        }
+        return -1;
+    }
+
+    // Prints median/p95/p99 of the wall time and the median of each counter.
+    void print_summary(std::ostream& os) const {
+        os << std::left << std::setw(28) << "container" << std::setw(20) << "operation"
+           << std::right << std::setw(10) << "size" << std::setw(10) << "median"
+           << std::setw(10) << "p95" << std::setw(10) << "p99";
+        if (opts_.perf)
+            for (auto name : PerfCounters::names) os << std::setw(15) << name;
+        os << "\n";
+
+        for (const auto& s : series_) {
+            std::vector<long long> times;
+            for (const auto& sample : s.samples) times.push_back(sample.time_us);
+            os << std::left << std::setw(28) << s.container << std::setw(20) << s.operation
+               << std::right << std::setw(10) << s.size
+               << std::setw(10) << percentile(times, 50)
+               << std::setw(10) << percentile(times, 95)
+               << std::setw(10) << percentile(times, 99);
+            if (opts_.perf) {
+                for (std::size_t e = 0; e < PerfCounters::kEventCount; ++e) {
+                    std::vector<long long> values;
+                    for (const auto& sample : s.samples)
+                        if (sample.counters[e] >= 0) values.push_back(sample.counters[e]);
+                    if (values.empty()) os << std::setw(15) << "-";
+                    else os << std::setw(15) << percentile(values, 50);
+                }
+            }
+            os << "\n";
+        }
+    }
+
+    // Nearest-rank percentile; `values` is taken by copy because it gets sorted.
+    static long long percentile(std::vector<long long> values, int p) {
+        if (values.empty()) return 0;
+        std::sort(values.begin(), values.end());
+        std::size_t rank = (static_cast<std::size_t>(p) * values.size() + 99) / 100;
+        return values[std::max<std::size_t>(rank, 1) - 1];
+    }
+
+private:
+    struct Sample {
+        long long time_us = 0;
+        PerfCounters::Values counters{};
+    };
+
+    struct Series {
+        std::string container;
+        std::string operation;
+        std::size_t size;
+        std::vector<Sample> samples;
+    };
+
+    BenchOptions opts_;
+    std::ostream* csv_;
+    PerfCounters counters_;
+    std::vector<Series> series_;
+
+    static PerfCounters::Values empty_counters() {
+        PerfCounters::Values values;
+        values.fill(-1);
+        return values;
+    }
+
+    void write_row(const Series& s, int run, const Sample& sample) {
+        if (!csv_) return;
+        *csv_ << s.container << "," << s.operation << "," << s.size << "," << run << ","
+              << sample.time_us;
+        for (long long v : sample.counters) {
+            *csv_ << ",";
+            if (v >= 0) *csv_ << v;
+        }
+        *csv_ << "\n";
+    }
+};
+
+#endif // BENCH_HARNESS_H
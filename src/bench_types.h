@@ -0,0 +1,82 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef BENCH_TYPES_H
+#define BENCH_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// Element types for the benchmark suite. Each "kind" names the element type,
+// gives it a CSV label and builds the i-th value, so one workload template
+// covers trivially copyable, heap-owning, move-only and throwing-move types.
+
+struct Pod64 {
+    std::uint64_t words[8];
+
+    bool operator==(const Pod64&) const = default;
+};
+static_assert(sizeof(Pod64) == 64 && std::is_trivially_copyable_v<Pod64>);
+
+// Move constructor is not noexcept, so move_if_noexcept falls back to copying
+// it on every relocation -- the expensive path containers have to handle.
+struct ThrowingMove {
+    std::string payload;
+
+    explicit ThrowingMove(std::string s) : payload(std::move(s)) {}
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove(ThrowingMove&& other) noexcept(false) : payload(std::move(other.payload)) {}
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&& other) noexcept(false) {
+        payload = std::move(other.payload);
+        return *this;
+    }
+};
+static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove>);
+
+struct IntKind {
+    using type = int;
+    static constexpr const char* name = "int";
+    static type make(std::size_t i) { return static_cast<int>(i); }
+};
+
+struct Pod64Kind {
+    using type = Pod64;
+    static constexpr const char* name = "pod64";
+    static type make(std::size_t i) {
+        Pod64 p{};
+        for (auto& w : p.words) w = i;
+        return p;
+    }
+};
+
+// 8 characters: stays in the small-string buffer of every major library.
+struct StringSsoKind {
+    using type = std::string;
+    static constexpr const char* name = "string_sso";
+    static type make(std::size_t i) { return std::string(8, static_cast<char>('a' + i % 26)); }
+};
+
+// 64 characters: always heap-allocated.
+struct StringHeapKind {
+    using type = std::string;
+    static constexpr const char* name = "string_heap";
+    static type make(std::size_t i) { return std::string(64, static_cast<char>('a' + i % 26)); }
+};
+
+struct UniquePtrKind {
+    using type = std::unique_ptr<int>;
+    static constexpr const char* name = "unique_ptr";
+    static type make(std::size_t i) { return std::make_unique<int>(static_cast<int>(i)); }
+};
+
+struct ThrowingMoveKind {
+    using type = ThrowingMove;
+    static constexpr const char* name = "throwing_move";
+    static type make(std::size_t i) { return ThrowingMove(std::string(64, static_cast<char>('a' + i % 26))); }
+};
+
+#endif // BENCH_TYPES_H
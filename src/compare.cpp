@@ -1,323 +1,1555 @@
 #include "../include/my_vector.h"
 #include "../include/my_array.h"
+#include "../include/my_ring_vector.h"
+#include "../include/my_gap_vector.h"
+#include "../include/my_sorted_vector.h"
+#include "../include/my_sort.h"
+#include "../include/my_bit_vector.h"
+#include "../include/my_packed_int_vector.h"
+#include "../include/my_expr.h"
+#include "../include/my_span.h"
+#include "../include/my_tracked_vector.h"
+#include "../include/my_numa.h"
+#include "../include/my_parallel.h"
+#include "../include/my_io.h"
+#include "../include/my_static_vector.h"
+#include "../include/my_gather.h"
+#include "../include/my_snapshot_vector.h"
+#include "../include/my_compact_vector.h"
+#include "../include/my_jagged_vector.h"
+#include "../include/my_shm_vector.h"
+#include "../include/my_simd.h"
+#include "../include/my_per_thread_vector.h"
+#include "../include/my_algorithm.h"
+#include "bench_harness.h"
+#include "bench_types.h"
 
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <fstream>
 #include <numeric>
+#include <random>
+#include <shared_mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 
-using us = std::chrono::microseconds;
+#include <sys/wait.h>
+#include <unistd.h>
 
-template<typename F>
-long long time_us(F fn) {
-    auto t0 = std::chrono::high_resolution_clock::now();
-    fn();
-    auto t1 = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<us>(t1 - t0).count();
-}
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 template <size_t N>
-void bench_myarray(std::ofstream& csv, int runs) {
+void bench_myarray(BenchHarness& h) {
+    const std::string name = "MyArray" + std::to_string(N);
     std::vector<int> tmp(N);
     std::iota(tmp.begin(), tmp.end(), 0);
 
-    for (int run = 1; run <= runs; ++run) {
-        {
-            auto t_my = time_us([&]() {
-                MyArray<int, N> a;
-            });
-            csv << "MyArray" << N << ",ctor_default," << N << "," << run << "," << t_my << "\n";
-        }
+    h.run(name, "ctor_default", N, [&]() {
+        MyArray<int, N> a;
+        do_not_optimize(a);
+    });
 
-        {
-            auto t_my = time_us([&]() {
-                MyArray<int, N> a{ tmp.begin(), tmp.begin() + N };
-            });
-            csv << "MyArray" << N << ",ctor_init_list," << N << "," << run << "," << t_my << "\n";
-        }
+    h.run(name, "ctor_init_list", N, [&]() {
+        MyArray<int, N> a{ tmp.begin(), tmp.begin() + N };
+        do_not_optimize(a);
+    });
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                long long s = 0;
-                for (size_t i = 0; i < N; ++i) s += a[i];
-            });
-            csv << "MyArray" << N << ",operator[]," << N << "," << run << "," << t_my << "\n";
-        }
+    MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
+    MyArray<int, N> b(a);
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                long long s = 0;
-                for (size_t i = 0; i < N; ++i) s += a.at(i);
-            });
-            csv << "MyArray" << N << ",at," << N << "," << run << "," << t_my << "\n";
+    h.run(name, "operator[]", N, [&]() {
+        long long s = 0;
+        for (size_t i = 0; i < N; ++i) s += a[i];
+        do_not_optimize(s);
+    });
+
+    h.run(name, "at", N, [&]() {
+        long long s = 0;
+        for (size_t i = 0; i < N; ++i) s += a.at(i);
+        do_not_optimize(s);
+    });
+
+    h.run(name, "iterate", N, [&]() {
+        long long s = 0;
+        for (auto const& x : a) s += x;
+        do_not_optimize(s);
+    });
+
+    h.run(name, "copy_ctor", N, [&]() {
+        MyArray<int, N> c(a);
+        do_not_optimize(c);
+    });
+
+    MyArray<int, N> src;
+    h.run(name, "move_ctor", N,
+          [&]() { src = a; },
+          [&]() {
+              MyArray<int, N> c(std::move(src));
+              do_not_optimize(c);
+          });
+
+    h.run(name, "swap", N, [&]() {
+        a.swap(b);
+        do_not_optimize(a);
+    });
+
+    h.run(name, "compare_eq", N, [&]() {
+        volatile bool eq = (a == b);
+    });
+
+    h.run(name, "compare_three_way", N, [&]() {
+        volatile auto cmp = (a <=> b);
+    });
+}
+
+template <typename Vector>
+void bench_vector(BenchHarness& h, const std::string& name, size_t N) {
+    h.run(name, "push_back", N, [&]() {
+        Vector v;
+        v.reserve(N);
+        for (int i = 0; i < (int)N; ++i) v.push_back(i);
+        do_not_optimize(v.begin());
+    });
+
+    Vector base;
+    base.reserve(N);
+    for (size_t i = 0; i < N; ++i) base.push_back(int(i));
+
+    h.run(name, "operator[]", N, [&]() {
+        long long s = 0;
+        for (size_t i = 0; i < N; ++i) s += base[i];
+        do_not_optimize(s);
+    });
+
+    h.run(name, "at", N, [&]() {
+        long long s = 0;
+        for (size_t i = 0; i < N; ++i) s += base.at(i);
+        do_not_optimize(s);
+    });
+
+    h.run(name, "iterate", N, [&]() {
+        long long s = std::accumulate(base.begin(), base.end(), 0LL);
+        do_not_optimize(s);
+    });
+
+    h.run(name, "copy_ctor", N, [&]() {
+        Vector v2(base);
+        do_not_optimize(v2.begin());
+    });
+
+    Vector tmp;
+    h.run(name, "move_ctor", N,
+          [&]() { tmp = base; },
+          [&]() {
+              Vector v2(std::move(tmp));
+              do_not_optimize(v2.begin());
+          });
+
+    h.run(name, "front_back", N, [&]() {
+        volatile int f = base.front();
+        volatile int b = base.back();
+    });
+
+    h.run(name, "resize", N, [&]() {
+        Vector v = base;
+        v.resize(N / 2);
+        v.resize(N);
+        do_not_optimize(v.begin());
+    });
+
+    h.run(name, "clear", N, [&]() {
+        Vector v = base;
+        v.clear();
+        do_not_optimize(v.begin());
+    });
+
+    h.run(name, "insert_one", N, [&]() {
+        Vector v = base;
+        v.insert(v.begin(), -1);
+        do_not_optimize(v.begin());
+    });
+
+    h.run(name, "erase_one", N, [&]() {
+        Vector v = base;
+        v.erase(v.begin());
+        do_not_optimize(v.begin());
+    });
+
+    Vector other(base);
+    h.run(name, "compare_eq", N, [&]() {
+        volatile bool eq = (base == other);
+    });
+
+    h.run(name, "swap", N, [&]() {
+        Vector a = base;
+        a.swap(other);
+        do_not_optimize(a.begin());
+    });
+}
+
+// Workloads where the element type matters: relocation in reserve (copy vs move
+// through move_if_noexcept), shifting on insert/erase and growth patterns.
+template <typename Vector, typename Kind>
+void bench_elements(BenchHarness& h, const std::string& name, size_t N) {
+    using T = typename Kind::type;
+    std::mt19937 gen(42);
+    std::vector<size_t> positions(N);
+    for (auto& p : positions) p = gen();
+
+    if constexpr (std::is_copy_constructible_v<T>) {
+        const T proto = Kind::make(N);
+        h.run(name, "push_back_copy", N, [&]() {
+            Vector v;
+            for (size_t i = 0; i < N; ++i) v.push_back(proto);
+            do_not_optimize(v.begin());
+        });
+    }
+
+    h.run(name, "emplace_back", N, [&]() {
+        Vector v;
+        for (size_t i = 0; i < N; ++i) v.emplace_back(Kind::make(i));
+        do_not_optimize(v.begin());
+    });
+
+    Vector v;
+    auto fill = [&](size_t count) {
+        v = Vector();
+        v.reserve(count);
+        for (size_t i = 0; i < count; ++i) v.emplace_back(Kind::make(i));
+    };
+
+    h.run(name, "reserve_relocate", N,
+          [&]() { fill(N); },
+          [&]() {
+              v.reserve(2 * N);
+              do_not_optimize(v.begin());
+          });
+
+    h.run(name, "random_insert", N,
+          [&]() { fill(N / 2); },
+          [&]() {
+              for (size_t i = 0; i < N / 2; ++i)
+                  v.insert(v.begin() + positions[i] % (v.size() + 1), Kind::make(i));
+              do_not_optimize(v.begin());
+          });
+
+    h.run(name, "push_back_move", N, [&]() {
+        Vector w;
+        for (size_t i = 0; i < N; ++i) {
+            T value = Kind::make(i);
+            w.push_back(std::move(value));
         }
+        do_not_optimize(w.begin());
+    });
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                long long s = 0;
-                for (auto const& x : a) s += x;
-            });
-            csv << "MyArray" << N << ",iterate," << N << "," << run << "," << t_my << "\n";
+    // Builds a vector from move iterators over a filled one: no copies.
+    Vector moved;
+    h.run(name, "range_ctor_move", N,
+          [&]() { fill(N); },
+          [&]() {
+              moved = Vector(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+              do_not_optimize(moved.begin());
+          });
+
+    h.run(name, "erase_heavy", N,
+          [&]() { fill(N); },
+          [&]() {
+              for (size_t i = 0; i < N / 2; ++i)
+                  v.erase(v.begin() + positions[i] % v.size());
+              do_not_optimize(v.begin());
+          });
+
+    h.run(name, "grow_then_shrink", N, [&]() {
+        Vector w;
+        for (size_t i = 0; i < N; ++i) w.emplace_back(Kind::make(i));
+        while (w.size() > N / 8) w.pop_back();
+        w.shrink_to_fit();
+        for (size_t i = w.size(); i < N / 2; ++i) w.emplace_back(Kind::make(i));
+        do_not_optimize(w.begin());
+    });
+}
+
+template <typename Kind>
+void bench_element_kind(BenchHarness& h, size_t N) {
+    using T = typename Kind::type;
+    bench_elements<std::vector<T>, Kind>(h, std::string("std::vector<") + Kind::name + ">", N);
+    bench_elements<MyVector<T>, Kind>(h, std::string("MyVector<") + Kind::name + ">", N);
+}
+
+// FIFO at a steady queue length of N: `ops` times pop the oldest element and
+// push a new one. MyVector has to use erase(begin()), shifting all N elements.
+void bench_fifo(BenchHarness& h, size_t N) {
+    const size_t ops = 1'000;
+
+    MyVector<int> vec;
+    h.run("MyVector", "fifo", N,
+          [&]() { vec = MyVector<int>(N, 1); },
+          [&]() {
+              for (size_t i = 0; i < ops; ++i) {
+                  vec.erase(vec.begin());
+                  vec.push_back(int(i));
+              }
+              do_not_optimize(vec.begin());
+          });
+
+    std::deque<int> deq;
+    h.run("std::deque", "fifo", N,
+          [&]() { deq.assign(N, 1); },
+          [&]() {
+              for (size_t i = 0; i < ops; ++i) {
+                  deq.pop_front();
+                  deq.push_back(int(i));
+              }
+              do_not_optimize(deq.front());
+          });
+
+    MyRingVector<int> ring;
+    h.run("MyRingVector", "fifo", N,
+          [&]() {
+              ring = MyRingVector<int>(N);
+              for (size_t i = 0; i < N; ++i) ring.push_back(1);
+          },
+          [&]() {
+              for (size_t i = 0; i < ops; ++i) {
+                  ring.pop_front();
+                  ring.push_back(int(i));
+              }
+              do_not_optimize(ring.front());
+          });
+
+    // Telemetry buffer: keep the latest N samples out of 10 * N.
+    h.run("MyRingVector", "overwrite_push", N, [&]() {
+        MyRingVector<int> last(N, RingOverflow::overwrite);
+        for (size_t i = 0; i < 10 * N; ++i) last.push_back(int(i));
+        do_not_optimize(last.front());
+    });
+}
+
+// Editor-style insertion into a sequence of N elements: N / 10 inserts either
+// near the previous one (cursor drifts by at most 8) or at uniform positions.
+void bench_gap(BenchHarness& h, size_t N) {
+    const size_t ops = N / 10;
+    std::mt19937 gen(42);
+    std::vector<size_t> local(ops), random(ops);
+    size_t cursor = N / 2;
+    for (size_t i = 0; i < ops; ++i) {
+        long size = long(N + i);
+        long next = long(cursor) + long(gen() % 17) - 8;
+        cursor = size_t(std::clamp(next, 0L, size));
+        local[i] = cursor;
+        random[i] = gen() % (size + 1);
+    }
+
+    for (auto [op, positions] : {std::pair{"local_insert", &local}, std::pair{"random_insert", &random}}) {
+        MyVector<int> vec;
+        h.run("MyVector", op, N,
+              [&]() { vec = MyVector<int>(N, 1); },
+              [&]() {
+                  for (size_t i = 0; i < ops; ++i)
+                      vec.insert(vec.begin() + (*positions)[i], int(i));
+                  do_not_optimize(vec.begin());
+              });
+
+        MyGapVector<int> gap;
+        h.run("MyGapVector", op, N,
+              [&]() {
+                  gap = MyGapVector<int>();
+                  gap.reserve(N);
+                  for (size_t i = 0; i < N; ++i) gap.push_back(1);
+              },
+              [&]() {
+                  for (size_t i = 0; i < ops; ++i)
+                      gap.insert((*positions)[i], int(i));
+                  do_not_optimize(gap.front());
+              });
+    }
+}
+
+// Lookups of 10^6 random int32 keys (about half of them hit) in N sorted keys.
+void bench_lookup(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"std::lower_bound", "MySortedVector<sorted>", "MySortedVector<eytzinger>"},
+                        {"build", "lookup", "find_many"}))
+        return;
+    const size_t queries = 1'000'000;
+    std::mt19937 gen(42);
+    MyVector<std::int32_t> keys;
+    keys.reserve(N);
+    for (size_t i = 0; i < N; ++i) keys.push_back(static_cast<std::int32_t>(gen() & 0x7ffffffe));
+    MyVector<std::int32_t> probe;
+    probe.reserve(queries);
+    for (size_t i = 0; i < queries; ++i)
+        probe.push_back(i % 2 ? keys[gen() % N] : static_cast<std::int32_t>(gen() & 0x7fffffff));
+
+    MyVector<std::int32_t> unsorted;
+    h.run("MySortedVector<sorted>", "build", N,
+          [&]() { unsorted = keys; },
+          [&]() {
+              MySortedVector<std::int32_t> sv(std::move(unsorted));
+              do_not_optimize(sv.begin());
+          });
+
+    MySortedVector<std::int32_t> sorted(keys);
+    MySortedVector<std::int32_t> eytzinger(keys, SortedLayout::eytzinger);
+
+    h.run("std::lower_bound", "lookup", N, [&]() {
+        size_t sum = 0;
+        for (auto q : probe) sum += std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin();
+        do_not_optimize(sum);
+    });
+
+    MyVector<size_t> out(queries, 0);
+    for (auto* sv : {&sorted, &eytzinger}) {
+        const std::string name = sv == &sorted ? "MySortedVector<sorted>" : "MySortedVector<eytzinger>";
+        h.run(name, "lookup", N, [&]() {
+            size_t sum = 0;
+            for (auto q : probe) sum += sv->lower_bound(q);
+            do_not_optimize(sum);
+        });
+        h.run(name, "find_many", N, [&]() {
+            sv->lower_bound_many(probe.begin(), probe.size(), out.begin());
+            do_not_optimize(out.begin());
+        });
+    }
+}
+
+// Visitation/filter masks of N flags (~1/8 set): packed MyBitVector against the
+// byte-per-bool MyVector<bool> and std::vector<bool>.
+void bench_bits(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"MyBitVector", "MyVector<bool>", "std::vector<bool>"},
+                        {"set_random", "count", "scan_set", "and", "rank"}))
+        return;
+    std::mt19937 gen(11);
+    MyVector<size_t> positions;
+    positions.reserve(N / 8);
+    for (size_t i = 0; i < N / 8; ++i) positions.push_back(gen() % N);
+
+    MyBitVector packed(N), other(N);
+    MyVector<bool> bytes(N, false), other_bytes(N, false);
+    std::vector<bool> std_bits(N, false);
+    for (size_t i = 0; i < N; i += 3) {
+        other[i] = true;
+        other_bytes[i] = true;
+    }
+
+    h.run("MyBitVector", "set_random", N, [&]() {
+        for (size_t p : positions) packed[p] = true;
+        do_not_optimize(packed.words());
+    });
+    h.run("MyVector<bool>", "set_random", N, [&]() {
+        for (size_t p : positions) bytes[p] = true;
+        do_not_optimize(bytes.begin());
+    });
+    h.run("std::vector<bool>", "set_random", N, [&]() {
+        for (size_t p : positions) std_bits[p] = true;
+        do_not_optimize(std_bits);
+    });
+
+    h.run("MyBitVector", "count", N, [&]() { do_not_optimize(packed.count()); });
+    h.run("MyVector<bool>", "count", N, [&]() {
+        do_not_optimize(std::count(bytes.begin(), bytes.end(), true));
+    });
+    h.run("std::vector<bool>", "count", N, [&]() {
+        do_not_optimize(std::count(std_bits.begin(), std_bits.end(), true));
+    });
+
+    h.run("MyBitVector", "scan_set", N, [&]() {
+        size_t sum = 0;
+        for (size_t i = packed.find_first(); i != MyBitVector::npos; i = packed.find_next(i)) sum += i;
+        do_not_optimize(sum);
+    });
+    h.run("MyVector<bool>", "scan_set", N, [&]() {
+        size_t sum = 0;
+        for (size_t i = 0; i < N; ++i)
+            if (bytes[i]) sum += i;
+        do_not_optimize(sum);
+    });
+
+    h.run("MyBitVector", "and", N, [&]() {
+        MyBitVector result = packed & other;
+        do_not_optimize(result.words());
+    });
+    h.run("MyVector<bool>", "and", N, [&]() {
+        MyVector<bool> result(bytes);
+        for (size_t i = 0; i < N; ++i) result[i] = result[i] && other_bytes[i];
+        do_not_optimize(result.begin());
+    });
+
+    // 10^6 rank queries; the byte layout has no index and keeps a prefix-sum array instead.
+    MyVector<size_t> queries;
+    queries.reserve(1'000'000);
+    for (size_t i = 0; i < 1'000'000; ++i) queries.push_back(gen() % N);
+    MyBitRank index(packed);
+    h.run("MyBitVector", "rank", N, [&]() {
+        size_t sum = 0;
+        for (size_t q : queries) sum += index.rank(q);
+        do_not_optimize(sum);
+    });
+    if (h.selected("MyVector<bool>", "rank")) {
+        MyVector<std::uint32_t> prefix(N + 1, 0);
+        for (size_t i = 0; i < N; ++i) prefix[i + 1] = prefix[i] + bytes[i];
+        h.run("MyVector<bool>", "rank", N, [&]() {
+            size_t sum = 0;
+            for (size_t q : queries) sum += prefix[q];
+            do_not_optimize(sum);
+        });
+    }
+}
+
+// A column of N sorted 64-bit IDs with small gaps: sequential scans decode
+// chunks into a buffer, random_get reads 10^6 random positions.
+void bench_packed(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"MyVector<uint64_t>", "MyPackedIntVector", "MyBlockPackedVector<for>",
+                         "MyBlockPackedVector<delta>"}, {"build", "scan_sum", "random_get"}))
+        return;
+    std::mt19937_64 gen(13);
+    MyVector<std::uint64_t> ids;
+    ids.reserve(N);
+    std::uint64_t id = 0;
+    for (size_t i = 0; i < N; ++i) ids.push_back(id += 1 + gen() % 64);
+    MyVector<size_t> probes;
+    probes.reserve(1'000'000);
+    for (size_t i = 0; i < 1'000'000; ++i) probes.push_back(gen() % N);
+
+    MyPackedIntVector packed(ids);
+    MyBlockPackedVector frame(ids), delta(ids, BlockEncoding::delta);
+    frame.shrink_to_fit();
+    delta.shrink_to_fit();
+    if (h.selected_any({"MyPackedIntVector", "MyBlockPackedVector"}, {"scan_sum"}))
+        std::cout << "packed ids, N=" << N << ": bytes/value raw 8, fixed "
+                  << double(packed.memory_bytes()) / double(N) << ", for "
+                  << double(frame.memory_bytes()) / double(N) << ", delta "
+                  << double(delta.memory_bytes()) / double(N) << "\n";
+
+    h.run("MyPackedIntVector", "build", N, [&]() {
+        MyPackedIntVector v;
+        for (auto x : ids) v.push_back(x);
+        do_not_optimize(v.size());
+    });
+
+    h.run("MyVector<uint64_t>", "scan_sum", N, [&]() {
+        do_not_optimize(std::accumulate(ids.begin(), ids.end(), std::uint64_t(0)));
+    });
+    MyVector<std::uint64_t> chunk(1024, std::uint64_t(0));
+    auto scan = [&](const auto& column) {
+        std::uint64_t sum = 0;
+        for (size_t first = 0; first < N; first += chunk.size()) {
+            size_t count = std::min(chunk.size(), N - first);
+            column.decode(first, count, chunk.begin());
+            sum = std::accumulate(chunk.begin(), chunk.begin() + count, sum);
         }
+        do_not_optimize(sum);
+    };
+    h.run("MyPackedIntVector", "scan_sum", N, [&]() { scan(packed); });
+    h.run("MyBlockPackedVector<for>", "scan_sum", N, [&]() { scan(frame); });
+    h.run("MyBlockPackedVector<delta>", "scan_sum", N, [&]() { scan(delta); });
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                MyArray<int, N> b(a);
-            });
-            csv << "MyArray" << N << ",copy_ctor," << N << "," << run << "," << t_my << "\n";
+    auto random_get = [&](const auto& column) {
+        std::uint64_t sum = 0;
+        for (size_t p : probes) sum += column[p];
+        do_not_optimize(sum);
+    };
+    h.run("MyVector<uint64_t>", "random_get", N, [&]() { random_get(ids); });
+    h.run("MyPackedIntVector", "random_get", N, [&]() { random_get(packed); });
+    h.run("MyBlockPackedVector<for>", "random_get", N, [&]() { random_get(frame); });
+    h.run("MyBlockPackedVector<delta>", "random_get", N, [&]() { random_get(delta); });
+}
+
+// r = a * 2 + b - c and dot(a - b, c) over N doubles: one temporary MyVector per
+// operator ("temporaries"), expression templates ("expr") and a hand-written loop.
+void bench_expr(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"MyVector<double>"}, {"axpy_temporaries", "axpy_expr", "axpy_loop",
+                                               "dot_temporaries", "dot_expr", "dot_loop"}))
+        return;
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    MyVector<double> a, b, c, r(N, 0.0);
+    for (auto* v : {&a, &b, &c}) {
+        v->reserve(N);
+        for (size_t i = 0; i < N; ++i) v->push_back(dist(gen));
+    }
+
+    auto binary = [](const MyVector<double>& x, const MyVector<double>& y, auto op) {
+        MyVector<double> out;
+        out.reserve(x.size());
+        for (size_t i = 0; i < x.size(); ++i) out.push_back(op(x[i], y[i]));
+        return out;
+    };
+    auto scale = [](const MyVector<double>& x, double k) {
+        MyVector<double> out;
+        out.reserve(x.size());
+        for (auto v : x) out.push_back(v * k);
+        return out;
+    };
+
+    h.run("MyVector<double>", "axpy_temporaries", N, [&]() {
+        r = binary(binary(scale(a, 2.0), b, std::plus<>()), c, std::minus<>());
+        do_not_optimize(r.begin());
+    });
+    h.run("MyVector<double>", "axpy_expr", N, [&]() {
+        r = a * 2.0 + b - c;
+        do_not_optimize(r.begin());
+    });
+    h.run("MyVector<double>", "axpy_loop", N, [&]() {
+        for (size_t i = 0; i < N; ++i) r[i] = a[i] * 2.0 + b[i] - c[i];
+        do_not_optimize(r.begin());
+    });
+
+    h.run("MyVector<double>", "dot_temporaries", N, [&]() {
+        MyVector<double> prod = binary(binary(a, b, std::minus<>()), c, std::multiplies<>());
+        do_not_optimize(std::accumulate(prod.begin(), prod.end(), 0.0));
+    });
+    h.run("MyVector<double>", "dot_expr", N, [&]() { do_not_optimize(my::dot(a - b, c)); });
+    h.run("MyVector<double>", "dot_loop", N, [&]() {
+        double sum = 0;
+        for (size_t i = 0; i < N; ++i) sum += (a[i] - b[i]) * c[i];
+        do_not_optimize(sum);
+    });
+}
+
+// Summing the middle half of a MyVector<int> through a function: a copy made
+// with the iterator-range constructor against a MySpan of the same range.
+void bench_span(BenchHarness& h, size_t N) {
+    MyVector<int> v(N, 1);
+    auto sum_vector = [](const MyVector<int>& part) { return std::accumulate(part.begin(), part.end(), 0L); };
+    auto sum_span = [](MySpan<const int> part) { return std::accumulate(part.begin(), part.end(), 0L); };
+
+    h.run("MyVector", "sub_range_sum", N, [&]() {
+        do_not_optimize(sum_vector(MyVector<int>(v.begin() + N / 4, v.begin() + N / 4 + N / 2)));
+    });
+    h.run("MySpan", "sub_range_sum", N, [&]() {
+        do_not_optimize(sum_span(MySpan<const int>(v).subspan(N / 4, N / 2)));
+    });
+}
+
+// A burst of N pushes drained down to 1% again: plain MyVector against
+// MyTrackedVector with auto-shrink ("burst_drain"), and giving the slack back
+// after the drain ("trim"), which reallocates below my_memory::kMadviseBytes
+// and uses madvise above it.
+void bench_tracked(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"MyVector", "MyTrackedVector"}, {"burst_drain", "trim"}))
+        return;
+    const size_t keep = N / 100;
+
+    h.run("MyVector", "burst_drain", N, [&]() {
+        MyVector<std::uint64_t> v;
+        for (size_t i = 0; i < N; ++i) v.push_back(i);
+        while (v.size() > keep) v.pop_back();
+        do_not_optimize(v.capacity());
+    });
+    h.run("MyTrackedVector", "burst_drain", N, [&]() {
+        MyTrackedVector<std::uint64_t> v(my_memory::ShrinkPolicy{});
+        for (size_t i = 0; i < N; ++i) v.push_back(i);
+        while (v.size() > keep) v.pop_back();
+        do_not_optimize(v.capacity());
+    });
+
+    MyVector<std::uint64_t> plain;
+    MyTrackedVector<std::uint64_t> tracked;
+    auto fill = [&]() {
+        plain.clear();
+        plain.resize(N, 1);
+        plain.resize(keep);
+        tracked.clear();
+        tracked.resize(N, 1);
+        tracked.resize(keep);
+    };
+    h.run("MyVector", "trim", N, fill, [&]() {
+        plain.shrink_to_fit();
+        do_not_optimize(plain.begin());
+    });
+    h.run("MyTrackedVector", "trim", N, fill, [&]() {
+        do_not_optimize(my_memory::trim_all(0));
+    });
+}
+
+// Summing N uint64 values from a thread pinned to each node, with the
+// buffer bound to each node ("numa/cpuC/memM"), interleaved, or first-touched
+// by the scanning workers. Prints GB/s per row; on a single node (or fake
+// NUMA) only the local row and the placement variants exist.
+void bench_numa(BenchHarness& h, size_t N) {
+    const size_t workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t bytes = N * sizeof(std::uint64_t);
+    auto scan = [&](const MyVector<std::uint64_t>& v) {
+        do_not_optimize(std::accumulate(v.begin(), v.end(), std::uint64_t(0)));
+    };
+    auto report = [&](const std::string& container) {
+        long long us = h.median_us(container, "scan", N);
+        if (us > 0)
+            std::cout << container << ", N=" << N << ": " << double(bytes) / double(us) / 1e3 << " GB/s\n";
+    };
+    auto filled = [&](my_numa::Placement placement, int node) {
+        MyVector<std::uint64_t> v;
+        v.reserve(N);
+        my_numa::place(v, placement, node, workers);
+        v.resize(N, 1);
+        return v;
+    };
+
+    for (int mem : my_numa::nodes()) {
+        for (int cpu : my_numa::nodes()) {
+            const std::string name = "numa/cpu" + std::to_string(cpu) + "/mem" + std::to_string(mem);
+            if (!h.selected(name, "scan")) continue;
+            MyVector<std::uint64_t> v = filled(my_numa::Placement::bind, mem);
+            my_numa::NodePin pin(cpu);
+            h.run(name, "scan", N, [&]() { scan(v); });
+            report(name);
         }
+    }
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                MyArray<int, N> b(std::move(a));
-            });
-            csv << "MyArray" << N << ",move_ctor," << N << "," << run << "," << t_my << "\n";
+    // Parallel scan by `workers` pinned threads, one chunk each.
+    auto parallel_scan = [&](const MyVector<std::uint64_t>& v) {
+        MyVector<std::uint64_t> sums(workers, std::uint64_t(0));
+        auto part = [&](size_t k) {
+            my_numa::NodePin pin(my_numa::node_for_worker(k, workers));
+            MySpan<const std::uint64_t> chunk = MySpan<const std::uint64_t>(v).chunks(workers)[k];
+            sums[k] = std::accumulate(chunk.begin(), chunk.end(), std::uint64_t(0));
+        };
+        MyVector<std::thread> threads;
+        for (size_t k = 1; k < workers; ++k) threads.emplace_back(part, k);
+        part(0);
+        for (auto& t : threads) t.join();
+        do_not_optimize(std::accumulate(sums.begin(), sums.end(), std::uint64_t(0)));
+    };
+    const std::pair<const char*, my_numa::Placement> variants[] = {
+        {"numa/bind0/parallel", my_numa::Placement::bind},
+        {"numa/interleave/parallel", my_numa::Placement::interleave},
+        {"numa/first_touch/parallel", my_numa::Placement::first_touch},
+    };
+    for (const auto& [name, placement] : variants) {
+        if (!h.selected(name, "scan")) continue;
+        MyVector<std::uint64_t> v = filled(placement, my_numa::nodes()[0]);
+        h.run(name, "scan", N, [&]() { parallel_scan(v); });
+        report(name);
+    }
+}
+
+// Sum, element-wise transform and prefix sum of N doubles on a pool of K
+// threads ("my::parallel/tK"), against the serial std:: loops. Prints the
+// reduce speedup and bandwidth per K; once the scan is memory bound, extra
+// threads stop helping.
+void bench_parallel(BenchHarness& h, size_t N) {
+    std::vector<size_t> thread_counts = {1};
+    for (size_t t = 2; t <= std::max<size_t>(4, my::ThreadPool::default_threads()); t *= 2)
+        thread_counts.push_back(t);
+    bool any = h.selected_any({"std"}, {"reduce", "transform", "inclusive_scan"});
+    for (size_t t : thread_counts)
+        any = any || h.selected_any({("my::parallel/t" + std::to_string(t)).c_str()},
+                                    {"reduce", "transform", "inclusive_scan"});
+    if (!any) return;
+
+    MyVector<double> v(N, 0.0), out(N, 0.0);
+    std::iota(v.begin(), v.end(), 0.0);
+
+    h.run("std", "reduce", N, [&]() { do_not_optimize(std::accumulate(v.begin(), v.end(), 0.0)); });
+    h.run("std", "transform", N, [&]() {
+        std::transform(v.begin(), v.end(), out.begin(), [](double x) { return x * 1.5 + 1.0; });
+        do_not_optimize(out.begin());
+    });
+    h.run("std", "inclusive_scan", N, [&]() {
+        std::inclusive_scan(v.begin(), v.end(), out.begin());
+        do_not_optimize(out.begin());
+    });
+
+    const long long serial = h.median_us("std", "reduce", N);
+    for (size_t t : thread_counts) {
+        const std::string name = "my::parallel/t" + std::to_string(t);
+        if (!h.selected_any({name.c_str()}, {"reduce", "transform", "inclusive_scan"})) continue;
+        my::ThreadPool pool(t);
+        h.run(name, "reduce", N, [&]() { do_not_optimize(my::parallel::reduce(v, 0.0, std::plus<>(), pool)); });
+        h.run(name, "transform", N, [&]() {
+            my::parallel::transform(v, out, [](double x) { return x * 1.5 + 1.0; }, pool);
+            do_not_optimize(out.begin());
+        });
+        h.run(name, "inclusive_scan", N, [&]() {
+            my::parallel::inclusive_scan(v, out, std::plus<>(), pool);
+            do_not_optimize(out.begin());
+        });
+        const long long us = h.median_us(name, "reduce", N);
+        if (us > 0 && serial > 0)
+            std::cout << name << " reduce, N=" << N << ": " << double(serial) / double(us) << "x, "
+                      << double(N * sizeof(double)) / double(us) / 1e3 << " GB/s\n";
+    }
+}
+
+// Loading N uint64 values from a binary file and N results.csv-style rows
+// from a CSV file: a read-then-push_back loop over std::ifstream ("naive")
+// against the double-buffered my_io loaders. Prints MB/s. The files are
+// written just before, so this measures the page cache, not the disk.
+void bench_io(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"naive", "my_io"}, {"load_binary", "load_csv"}))
+        return;
+    struct Row {
+        std::uint32_t size;
+        std::uint32_t run;
+        double time_us;
+    };
+    auto parse = [](std::string_view line) {
+        // container,operation,size,run,time_us: skip the two text columns.
+        size_t a = line.find(',');
+        size_t b = line.find(',', a + 1);
+        const char* p = line.data() + b + 1;
+        char* end;
+        Row row;
+        row.size = static_cast<std::uint32_t>(std::strtoul(p, &end, 10));
+        row.run = static_cast<std::uint32_t>(std::strtoul(end + 1, &end, 10));
+        row.time_us = std::strtod(end + 1, &end);
+        return row;
+    };
+
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    const std::string bin_path = dir + "/compare_io.bin", csv_path = dir + "/compare_io.csv";
+    {
+        MyVector<std::uint64_t> values(N, std::uint64_t(0));
+        std::iota(values.begin(), values.end(), 0);
+        my_io::save_binary(bin_path, MySpan<const std::uint64_t>(values));
+        std::ofstream csv(csv_path);
+        csv << "container,operation,size,run,time_us\n";
+        for (size_t i = 0; i < N; ++i)
+            csv << "MyVector,push_back," << i % 100000 << "," << i % 11 << "," << double(i) * 0.25 << "\n";
+    }
+    const double bin_mb = double(N * sizeof(std::uint64_t)) / 1e6;
+    const double csv_mb = double(std::filesystem::file_size(csv_path)) / 1e6;
+
+    h.run("naive", "load_binary", N, [&]() {
+        MyVector<std::uint64_t> out;
+        std::ifstream in(bin_path, std::ios::binary);
+        std::uint64_t x;
+        while (in.read(reinterpret_cast<char*>(&x), sizeof(x))) out.push_back(x);
+        do_not_optimize(out.begin());
+    });
+    h.run("my_io", "load_binary", N, [&]() {
+        MyVector<std::uint64_t> out = my_io::load_binary<std::uint64_t>(bin_path);
+        do_not_optimize(out.begin());
+    });
+    h.run("naive", "load_csv", N, [&]() {
+        MyVector<Row> out;
+        std::ifstream in(csv_path);
+        std::string line;
+        std::getline(in, line);
+        while (std::getline(in, line)) out.push_back(parse(line));
+        do_not_optimize(out.begin());
+    });
+    h.run("my_io", "load_csv", N, [&]() {
+        MyVector<Row> out;
+        my_io::load_lines(csv_path, out, parse, true);
+        do_not_optimize(out.begin());
+    });
+
+    for (const char* c : {"naive", "my_io"}) {
+        for (auto [op, mb] : {std::pair{"load_binary", bin_mb}, std::pair{"load_csv", csv_mb}}) {
+            long long us = h.median_us(c, op, N);
+            if (us > 0) std::cout << c << " " << op << ", N=" << N << ": " << mb / (double(us) / 1e6) << " MB/s\n";
         }
+    }
+    std::filesystem::remove(bin_path);
+    std::filesystem::remove(csv_path);
+}
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            MyArray<int, N> b(tmp.begin(), tmp.begin() + N);
-            auto t_my = time_us([&]() {
-                a.swap(b);
-            });
-            csv << "MyArray" << N << ",swap," << N << "," << run << "," << t_my << "\n";
+// N calls of a hot-path helper that collects up to 48 values into a local
+// buffer and sums them: MyStaticVector<int, 64> keeps the buffer inline,
+// MyVector and std::vector allocate on every call. Prints ns per call.
+void bench_static(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"std::vector", "MyVector", "MyStaticVector"}, {"small_buffer"}))
+        return;
+    MyVector<std::uint32_t> counts;
+    counts.reserve(N);
+    std::mt19937 gen(23);
+    for (size_t i = 0; i < N; ++i) counts.push_back(8 + gen() % 41);
+
+    auto call = [](auto& buffer, std::uint32_t count) {
+        for (std::uint32_t i = 0; i < count; ++i) buffer.push_back(int(i * 3));
+        long sum = 0;
+        for (int x : buffer) sum += x;
+        return sum;
+    };
+    h.run("std::vector", "small_buffer", N, [&]() {
+        long total = 0;
+        for (auto c : counts) {
+            std::vector<int> buffer;
+            total += call(buffer, c);
+        }
+        do_not_optimize(total);
+    });
+    h.run("MyVector", "small_buffer", N, [&]() {
+        long total = 0;
+        for (auto c : counts) {
+            MyVector<int> buffer;
+            total += call(buffer, c);
         }
+        do_not_optimize(total);
+    });
+    h.run("MyStaticVector", "small_buffer", N, [&]() {
+        long total = 0;
+        for (auto c : counts) {
+            MyStaticVector<int, 64> buffer;
+            total += call(buffer, c);
+        }
+        do_not_optimize(total);
+    });
+    for (const char* c : {"std::vector", "MyVector", "MyStaticVector"}) {
+        long long us = h.median_us(c, "small_buffer", N);
+        if (us > 0) std::cout << c << " small_buffer: " << double(us) * 1e3 / double(N) << " ns/call\n";
+    }
+}
+
+// Gathering and scattering N floats through N uint32 indices into a table
+// of N elements, with uniformly random indices and with clustered ones
+// (runs of 16 consecutive slots from random starts). The plain operator[]
+// loop is the baseline; "my::gather/pfD" fixes the prefetch distance to D to
+// show where the automatic choice sits. Prints ns per element.
+void bench_gather(BenchHarness& h, size_t N) {
+    const char* gathers[] = {"operator[]", "my_simd::gather_scalar", "my::gather", "my::gather/pf0",
+                             "my::gather/pf8", "my::gather/pf16", "my::gather/pf32", "my::gather/pf64"};
+    if (!h.selected_any({"operator[]", "my_simd::gather_scalar", "my::gather", "my::gather/pf0", "my::gather/pf8",
+                         "my::gather/pf16", "my::gather/pf32", "my::gather/pf64", "my::scatter"},
+                        {"gather_random", "gather_clustered", "scatter_random", "scatter_clustered"}))
+        return;
+    MyVector<float> table;
+    table.reserve(N);
+    for (size_t i = 0; i < N; ++i) table.push_back(float(i));
+    std::mt19937 gen(29);
+    MyVector<std::uint32_t> random_idx, clustered_idx;
+    random_idx.reserve(N);
+    clustered_idx.reserve(N);
+    for (size_t i = 0; i < N; ++i) random_idx.push_back(std::uint32_t(gen() % N));
+    while (clustered_idx.size() < N) {
+        const size_t start = gen() % N;
+        for (size_t k = 0; k < 16 && clustered_idx.size() < N; ++k)
+            clustered_idx.push_back(std::uint32_t((start + k) % N));
+    }
+    MyVector<float> out(N, 0.0f);
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            MyArray<int, N> b(a);
-            auto t_my = time_us([&]() {
-                volatile bool eq = (a == b);
+    auto report = [&](const std::string& container, const std::string& op) {
+        long long us = h.median_us(container, op, N);
+        if (us > 0) std::cout << container << " " << op << ", N=" << N << ": " << double(us) * 1e3 / double(N) << " ns/elem\n";
+    };
+    for (auto [pattern, idx] : {std::pair{"random", &random_idx}, std::pair{"clustered", &clustered_idx}}) {
+        const std::string gather_op = std::string("gather_") + pattern;
+        const std::string scatter_op = std::string("scatter_") + pattern;
+        const MyVector<std::uint32_t>& ix = *idx;
+        h.run("operator[]", gather_op, N, [&]() {
+            for (size_t i = 0; i < N; ++i) out[i] = table[ix[i]];
+            do_not_optimize(out);
+        });
+        h.run("my_simd::gather_scalar", gather_op, N, [&]() {
+            my_simd::gather_scalar(table.begin(), ix.begin(), N, out.begin());
+            do_not_optimize(out);
+        });
+        h.run("my::gather", gather_op, N, [&]() {
+            my::gather(table, ix, out);
+            do_not_optimize(out);
+        });
+        for (size_t pf : {0, 8, 16, 32, 64}) {
+            h.run("my::gather/pf" + std::to_string(pf), gather_op, N, [&]() {
+                my::gather(table, ix, out, pf);
+                do_not_optimize(out);
             });
-            csv << "MyArray" << N << ",compare_eq," << N << "," << run << "," << t_my << "\n";
         }
+        for (const char* c : gathers) report(c, gather_op);
+
+        h.run("operator[]", scatter_op, N, [&]() {
+            for (size_t i = 0; i < N; ++i) table[ix[i]] = out[i];
+            do_not_optimize(table);
+        });
+        h.run("my::scatter", scatter_op, N, [&]() {
+            my::scatter(table, ix, out);
+            do_not_optimize(table);
+        });
+        for (const char* c : {"operator[]", "my::scatter"}) report(c, scatter_op);
+    }
+}
 
-        {
-            MyArray<int, N> a(tmp.begin(), tmp.begin() + N);
-            MyArray<int, N> b(a);
-            auto t_my = time_us([&]() {
-                volatile auto cmp = (a <=> b);
+// N lookups into a 4096-entry table, split over several reader threads,
+// while a writer replaces one entry every 100 us: a MyVector behind a
+// std::shared_mutex against MySnapshotVector, where each lookup takes its
+// own snapshot. Prints million reads per second.
+void bench_snapshot(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"std::shared_mutex", "MySnapshotVector"}, {"read_under_writes"}))
+        return;
+    const size_t table_size = 4096;
+    const size_t readers = std::max<size_t>(2, std::thread::hardware_concurrency());
+    MyVector<std::uint32_t> keys;
+    keys.reserve(N);
+    std::mt19937 gen(31);
+    for (size_t i = 0; i < N; ++i) keys.push_back(std::uint32_t(gen() % table_size));
+
+    // Runs read(k) for every key on `readers` threads and write(i) in a loop
+    // on one more until the readers are done.
+    auto contended = [&](auto read, auto write) {
+        std::atomic<bool> done{false};
+        std::thread writer([&]() {
+            for (std::uint64_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+                write(i);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+        MyVector<std::thread> threads;
+        for (size_t r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r]() {
+                std::uint64_t sum = 0;
+                for (size_t i = r; i < N; i += readers) sum += read(keys[i]);
+                do_not_optimize(sum);
             });
-            csv << "MyArray" << N << ",compare_three_way," << N << "," << run << "," << t_my << "\n";
         }
+        for (auto& t : threads) t.join();
+        done = true;
+        writer.join();
+    };
+
+    MyVector<std::uint64_t> locked(table_size, std::uint64_t(1));
+    std::shared_mutex lock;
+    h.run("std::shared_mutex", "read_under_writes", N, [&]() {
+        contended([&](std::uint32_t k) {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            return locked[k];
+        }, [&](std::uint64_t i) {
+            std::unique_lock<std::shared_mutex> guard(lock);
+            locked[i % table_size] = i;
+        });
+    });
+
+    MySnapshotVector<std::uint64_t> snapshots(MyVector<std::uint64_t>(table_size, std::uint64_t(1)));
+    h.run("MySnapshotVector", "read_under_writes", N, [&]() {
+        contended([&](std::uint32_t k) {
+            return snapshots.snapshot()[k];
+        }, [&](std::uint64_t i) {
+            snapshots.update([&](MyVector<std::uint64_t>& v) { v[i % table_size] = i; });
+        });
+    });
+
+    for (const char* c : {"std::shared_mutex", "MySnapshotVector"}) {
+        long long us = h.median_us(c, "read_under_writes", N);
+        if (us > 0)
+            std::cout << c << " read_under_writes, " << readers << " readers: " << double(N) / double(us)
+                      << " M reads/s\n";
     }
 }
 
-int main() {
-    std::ofstream csv("results.csv");
-    csv << "container,operation,size,run,time_us\n";
+// Bytes currently allocated through malloc, or 0 where that is unknown.
+size_t heap_in_use() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
 
-    std::vector<size_t> vec_sizes = {10'000, 100'000};
-    std::vector<size_t> arr_sizes = {1'000, 5'000};
-    int runs = 5;
+// Adjacency lists of a random graph with N vertices and 4N edges (degrees
+// roughly Poisson, about 2% of the vertices isolated), built by appending
+// edges in random order, then one pass summing all neighbour ids. The outer
+// MyVector is the same for all rows; only the inner vector type changes.
+// Prints the heap footprint per vertex and the share taken by the headers.
+void bench_compact(BenchHarness& h, size_t N) {
+    const char* names[] = {"MyVector<MyVector>", "MyVector<MyCompactVector>", "MyVector<MyThinVector>"};
+    if (!h.selected_any({names[0], names[1], names[2]}, {"graph_build", "graph_scan"}))
+        return;
+    const size_t edges = 4 * N;
+    MyVector<std::uint32_t> from, to;
+    from.reserve(edges);
+    to.reserve(edges);
+    std::mt19937 gen(37);
+    for (size_t e = 0; e < edges; ++e) {
+        from.push_back(std::uint32_t(gen() % N));
+        to.push_back(std::uint32_t(gen() % N));
+    }
 
-    for (auto N : vec_sizes) {
-        for (int run = 1; run <= runs; ++run) {
-            {
-                long long t_std = time_us([&](){
-                    std::vector<int> v;
-                    v.reserve(N);
-                    for (int i = 0; i < (int)N; ++i) v.push_back(i);
-                });
-                csv << "std::vector,push_back,"<<N<<","<<run<<","<<t_std<<"\n";
+    auto run = [&]<typename Inner>(const char* name, std::type_identity<Inner>) {
+        auto build = [&]() {
+            MyVector<Inner> adj(N, Inner());
+            for (size_t e = 0; e < edges; ++e) adj[from[e]].push_back(to[e]);
+            return adj;
+        };
+        h.run(name, "graph_build", N, [&]() { do_not_optimize(build()); });
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v;
-                    v.reserve(N);
-                    for (int i = 0; i < (int)N; ++i) v.push_back(i);
-                });
-                csv << "MyVector,push_back,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+        const size_t before = heap_in_use();
+        MyVector<Inner> adj = build();
+        const size_t heap = heap_in_use() - before;
+        h.run(name, "graph_scan", N, [&]() {
+            std::uint64_t sum = 0;
+            for (const Inner& list : adj)
+                for (std::uint32_t v : list) sum += v;
+            do_not_optimize(sum);
+        });
+        if (heap > 0) {
+            const double headers = double(N * sizeof(Inner));
+            std::cout << name << " footprint, N=" << N << ": " << double(heap) / double(N) << " bytes/vertex ("
+                      << sizeof(Inner) << "-byte headers = " << 100.0 * headers / double(heap) << "%)\n";
+        }
+    };
+    if (h.selected_any({names[0]}, {"graph_build", "graph_scan"}))
+        run(names[0], std::type_identity<MyVector<std::uint32_t>>());
+    if (h.selected_any({names[1]}, {"graph_build", "graph_scan"}))
+        run(names[1], std::type_identity<MyCompactVector<std::uint32_t>>());
+    if (h.selected_any({names[2]}, {"graph_build", "graph_scan"}))
+        run(names[2], std::type_identity<MyThinVector<std::uint32_t>>());
+}
 
-            std::vector<int> base_std(N);
-            std::iota(base_std.begin(), base_std.end(), 0);
-            MyVector<int> base_my(N,0);
-            for(size_t i=0;i<N;++i) base_my[i]=int(i);
+// N rows of 0..8 uint32 values (4 on average), appended row by row, then a
+// full scan summing every value: nested MyVectors (one heap block per row)
+// against MyJaggedVector (one value array plus offsets). "edit_rows"
+// appends one value to every 16th row and compacts, which nested vectors
+// do in place.
+void bench_jagged(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"MyVector<MyVector>", "MyJaggedVector"}, {"jagged_build", "jagged_scan", "jagged_edit_rows"}))
+        return;
+    MyVector<std::uint8_t> lengths;
+    lengths.reserve(N);
+    std::mt19937 gen(41);
+    for (size_t i = 0; i < N; ++i) lengths.push_back(std::uint8_t(gen() % 9));
 
-            {
-                long long t_std = time_us([&](){
-                    long long s = 0;
-                    for (size_t i = 0; i < N; ++i) s += base_std[i];
-                });
-                csv << "std::vector,operator[],"<<N<<","<<run<<","<<t_std<<"\n";
+    auto build_nested = [&]() {
+        MyVector<MyVector<std::uint32_t>> rows;
+        rows.reserve(N);
+        for (size_t r = 0; r < N; ++r) {
+            rows.emplace_back();
+            for (std::uint32_t k = 0; k < lengths[r]; ++k) rows.back().push_back(std::uint32_t(r) + k);
+        }
+        return rows;
+    };
+    auto build_jagged = [&]() {
+        MyJaggedVector<std::uint32_t> rows;
+        rows.reserve(N, 4 * N);
+        for (size_t r = 0; r < N; ++r) {
+            rows.push_row();
+            for (std::uint32_t k = 0; k < lengths[r]; ++k) rows.push_back(std::uint32_t(r) + k);
+        }
+        return rows;
+    };
+    auto scan = [](const auto& rows) {
+        std::uint64_t sum = 0;
+        for (const auto& row : rows)
+            for (std::uint32_t v : row) sum += v;
+        do_not_optimize(sum);
+    };
 
-                long long t_my = time_us([&](){
-                    long long s = 0;
-                    for (size_t i = 0; i < N; ++i) s += base_my[i];
-                });
-                csv << "MyVector,operator[],"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    h.run("MyVector<MyVector>", "jagged_build", N, [&]() { do_not_optimize(build_nested()); });
+    h.run("MyJaggedVector", "jagged_build", N, [&]() { do_not_optimize(build_jagged()); });
 
-            {
-                long long t_std = time_us([&](){
-                    long long s = 0;
-                    for (size_t i = 0; i < N; ++i) s += base_std.at(i);
-                });
-                csv << "std::vector,at,"<<N<<","<<run<<","<<t_std<<"\n";
+    auto nested = build_nested();
+    auto jagged = build_jagged();
+    h.run("MyVector<MyVector>", "jagged_scan", N, [&]() { scan(nested); });
+    h.run("MyJaggedVector", "jagged_scan", N, [&]() { scan(jagged); });
 
-                long long t_my = time_us([&](){
-                    long long s = 0;
-                    for (size_t i = 0; i < N; ++i) s += base_my.at(i);
-                });
-                csv << "MyVector,at,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    h.run("MyVector<MyVector>", "jagged_edit_rows", N, [&]() { nested = build_nested(); }, [&]() {
+        for (size_t r = 0; r < N; r += 16) nested[r].push_back(1);
+        do_not_optimize(nested);
+    });
+    h.run("MyJaggedVector", "jagged_edit_rows", N, [&]() { jagged = build_jagged(); }, [&]() {
+        for (size_t r = 0; r < N; r += 16) jagged.append_to_row(r, 1);
+        jagged.compact();
+        do_not_optimize(jagged);
+    });
+}
 
-            {
-                long long t_std = time_us([&](){
-                    long long s = accumulate(base_std.begin(), base_std.end(), 0LL);
-                });
-                csv << "std::vector,iterate,"<<N<<","<<run<<","<<t_std<<"\n";
+// Handing 8 batches of N uint64 values to a forked reader process that sums
+// each batch and acknowledges it with one byte: written through a pipe and
+// read into the reader's own MyVector, against filled in place in a
+// MyShmVector and read where it is. Process start-up is part of both rows.
+// Prints MB/s of payload.
+void bench_shm(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"pipe", "MyShmVector"}, {"handoff"}))
+        return;
+    const int batches = 8;
+    const double mb = double(batches) * double(N * sizeof(std::uint64_t)) / 1e6;
 
-                long long t_my = time_us([&](){
-                    long long s = std::accumulate(base_my.begin(), base_my.end(), 0LL);
-                });
-                csv << "MyVector,iterate,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    // Runs reader() in a child process; writer(ack_fd) in this one.
+    auto two_process = [&](auto reader, auto writer) {
+        int ack[2];
+        if (::pipe(ack) != 0) return;
+        const pid_t child = ::fork();
+        if (child == 0) {
+            ::close(ack[0]);
+            reader(ack[1]);
+            ::_exit(0);
+        }
+        ::close(ack[1]);
+        writer(ack[0]);
+        ::close(ack[0]);
+        ::waitpid(child, nullptr, 0);
+    };
+    auto read_all = [](int fd, void* buf, size_t bytes) {
+        auto* p = static_cast<char*>(buf);
+        while (bytes) {
+            ssize_t r = ::read(fd, p, bytes);
+            if (r <= 0) return false;
+            p += r;
+            bytes -= size_t(r);
+        }
+        return true;
+    };
+    auto write_all = [](int fd, const void* buf, size_t bytes) {
+        const auto* p = static_cast<const char*>(buf);
+        while (bytes) {
+            ssize_t w = ::write(fd, p, bytes);
+            if (w <= 0) return;
+            p += w;
+            bytes -= size_t(w);
+        }
+    };
 
-            {
-                long long t_std = time_us([&](){
-                    auto v2 = base_std;
-                });
-                csv << "std::vector,copy_ctor,"<<N<<","<<run<<","<<t_std<<"\n";
+    h.run("pipe", "handoff", N, [&]() {
+        int data[2];
+        if (::pipe(data) != 0) return;
+        two_process([&](int ack) {
+            ::close(data[1]);
+            MyVector<std::uint64_t> batch(N, std::uint64_t(0));
+            for (int b = 0; b < batches; ++b) {
+                if (!read_all(data[0], batch.begin(), N * sizeof(std::uint64_t))) break;
+                do_not_optimize(std::accumulate(batch.begin(), batch.end(), std::uint64_t(0)));
+                write_all(ack, "", 1);
+            }
+        }, [&](int ack) {
+            ::close(data[0]);
+            MyVector<std::uint64_t> batch(N, std::uint64_t(0));
+            char byte;
+            for (int b = 0; b < batches; ++b) {
+                for (size_t i = 0; i < N; ++i) batch[i] = i + size_t(b);
+                write_all(data[1], batch.begin(), N * sizeof(std::uint64_t));
+                read_all(ack, &byte, 1);
+            }
+            ::close(data[1]);
+        });
+    });
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v2(base_my);
+    auto shared = MyShmVector<std::uint64_t>::create_anonymous(N);
+    h.run("MyShmVector", "handoff", N, [&]() {
+        // Taken before the fork: the child may start after the first batch.
+        const std::uint32_t start = shared.publish();
+        two_process([&](int ack) {
+            auto in = MyShmReader<std::uint64_t>::from_fd(shared.fd());
+            std::uint32_t seen = start;
+            for (int b = 0; b < batches; ++b) {
+                seen = in.wait(seen);
+                in.read([](MySpan<const std::uint64_t> batch) {
+                    do_not_optimize(std::accumulate(batch.begin(), batch.end(), std::uint64_t(0)));
                 });
-                csv << "MyVector,copy_ctor,"<<N<<","<<run<<","<<t_my<<"\n";
+                write_all(ack, "", 1);
+            }
+        }, [&](int ack) {
+            char byte;
+            for (int b = 0; b < batches; ++b) {
+                shared.resize(N);
+                std::uint64_t* out = shared.begin();
+                for (size_t i = 0; i < N; ++i) out[i] = i + size_t(b);
+                shared.publish();
+                read_all(ack, &byte, 1);
             }
+        });
+    });
 
-            {
-                std::vector<int> tmp_std = base_std;
-                MyVector<int> tmp_my = base_my;
+    for (const char* c : {"pipe", "MyShmVector"}) {
+        long long us = h.median_us(c, "handoff", N);
+        if (us > 0) std::cout << c << " handoff, N=" << N << ": " << mb / (double(us) / 1e6) << " MB/s\n";
+    }
+}
 
-                long long t_std = time_us([&](){
-                    auto v2 = std::move(tmp_std);
-                });
-                csv << "std::vector,move_ctor,"<<N<<","<<run<<","<<t_std<<"\n";
+// Container kernels from my_simd.h at every level this CPU supports
+// ("my_simd/<level>", switched with my_simd::set_level), against the
+// <algorithm> calls the compiler vectorizes for the baseline target. N
+// uint32 values; `find` looks for the last one.
+void bench_kernels(BenchHarness& h, size_t N) {
+    if (!h.selected_any({"<algorithm>", "my_simd/scalar", "my_simd/sse42", "my_simd/avx2", "my_simd/avx512"},
+                        {"equal", "find", "fill"}))
+        return;
+    MyVector<std::uint32_t> a(N, 1), b(N, 1);
+    a.back() = b.back() = 2;
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v2(std::move(tmp_my));
-                });
-                csv << "MyVector,move_ctor,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    h.run("<algorithm>", "equal", N, [&]() { do_not_optimize(std::equal(a.begin(), a.end(), b.begin())); });
+    h.run("<algorithm>", "find", N, [&]() { do_not_optimize(std::find(a.begin(), a.end(), 2u)); });
+    h.run("<algorithm>", "fill", N, [&]() {
+        std::fill(a.begin(), a.end() - 1, 1u);
+        do_not_optimize(a);
+    });
 
-            {
-                long long t_std = time_us([&](){
-                    volatile int f = base_std.front();
-                    volatile int b = base_std.back();
-                });
-                csv << "std::vector,front_back,"<<N<<","<<run<<","<<t_std<<"\n";
+    const my_simd::Level saved = my_simd::level();
+    for (my_simd::Level level : {my_simd::Level::scalar, my_simd::Level::sse42, my_simd::Level::avx2,
+                                 my_simd::Level::avx512}) {
+        if (my_simd::set_level(level) != level) continue;
+        const std::string name = std::string("my_simd/") + my_simd::level_name(level);
+        h.run(name, "equal", N, [&]() { do_not_optimize(a == b); });
+        h.run(name, "find", N, [&]() { do_not_optimize(my_simd::find(a.begin(), N, 2u)); });
+        h.run(name, "fill", N, [&]() {
+            my_simd::fill(a.begin(), N - 1, 1u);
+            do_not_optimize(a);
+        });
+    }
+    my_simd::set_level(saved);
+}
 
-                long long t_my = time_us([&](){
-                    volatile int f = base_my.front();
-                    volatile int b = base_my.back();
-                });
-                csv << "MyVector,front_back,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+// N values produced by pool tasks (every third index is kept) and collected
+// into one MyVector: push_back under a shared std::mutex, a private
+// MyVector per slot concatenated on one thread with insert(end()), and
+// MyPerThreadVector::gather(). Repeated per thread count (".../tK").
+void bench_collect(BenchHarness& h, size_t N) {
+    std::vector<size_t> thread_counts = {1};
+    for (size_t t = 2; t <= std::max<size_t>(4, my::ThreadPool::default_threads()); t *= 2)
+        thread_counts.push_back(t);
+    for (size_t t : thread_counts) {
+        const std::string suffix = "/t" + std::to_string(t);
+        const std::string locked = "std::mutex" + suffix, concat = "serial_concat" + suffix,
+                          collector = "MyPerThreadVector" + suffix;
+        if (!h.selected_any({locked.c_str(), concat.c_str(), collector.c_str()}, {"collect"})) continue;
+        my::ThreadPool pool(t);
+        const size_t grain = pool.grain_for(N);
+        auto keep = [](size_t i) { return i % 3 == 0; };
 
-            {
-                long long t_std = time_us([&](){
-                    auto v = base_std;
-                    v.resize(N/2);
-                    v.resize(N);
-                });
-                csv << "std::vector,resize,"<<N<<","<<run<<","<<t_std<<"\n";
+        h.run(locked, "collect", N, [&]() {
+            std::mutex m;
+            MyVector<std::uint64_t> out;
+            pool.run(N, grain, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (!keep(i)) continue;
+                    std::lock_guard<std::mutex> lock(m);
+                    out.push_back(i);
+                }
+            });
+            do_not_optimize(out);
+        });
+        h.run(concat, "collect", N, [&]() {
+            MyVector<MyVector<std::uint64_t>> parts(pool.slots(), MyVector<std::uint64_t>());
+            pool.run(N, grain, [&](size_t begin, size_t end, size_t slot) {
+                for (size_t i = begin; i < end; ++i)
+                    if (keep(i)) parts[slot].push_back(i);
+            });
+            MyVector<std::uint64_t> out;
+            for (auto& part : parts) out.insert(out.end(), part.begin(), part.end());
+            do_not_optimize(out);
+        });
+        h.run(collector, "collect", N, [&]() {
+            MyPerThreadVector<std::uint64_t> c;
+            pool.run(N, grain, [&](size_t begin, size_t end, size_t) {
+                MyVector<std::uint64_t>& out = c.local();
+                for (size_t i = begin; i < end; ++i)
+                    if (keep(i)) out.push_back(i);
+            });
+            MyVector<std::uint64_t> out = c.gather(GatherOrder::registration, pool);
+            do_not_optimize(out);
+        });
+    }
+}
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v = base_my;
-                    v.resize(N/2);
-                    v.resize(N);
-                });
-                csv << "MyVector,resize,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+// Batch kernels on N uint32 values, as run right after a sort: an
+// exclusive scan into offsets, a 256-bin histogram of the top byte of
+// sorted keys (long runs of equal keys), and partitioning random keys
+// around the middle of their range. "std" is <numeric> / <algorithm>, or a
+// plain counting loop for the histogram; "my" is my_algorithm.h, and
+// "my::parallel/tK" the pool versions with K threads.
+void bench_batch(BenchHarness& h, size_t N) {
+    std::vector<size_t> thread_counts = {1};
+    for (size_t t = 2; t <= std::max<size_t>(4, my::ThreadPool::default_threads()); t *= 2)
+        thread_counts.push_back(t);
+    const char* ops[] = {"exclusive_scan", "histogram", "partition", "stable_partition"};
+    bool any = h.selected_any({"std", "my"}, {"exclusive_scan", "histogram", "partition", "stable_partition"});
+    for (size_t t : thread_counts)
+        for (const char* op : ops) any = any || h.selected("my::parallel/t" + std::to_string(t), op);
+    if (!any) return;
 
-            {
-                long long t_std = time_us([&](){
-                    auto v = base_std;
-                    v.clear();
-                });
-                csv << "std::vector,clear,"<<N<<","<<run<<","<<t_std<<"\n";
+    std::mt19937 gen(41);
+    MyVector<std::uint32_t> keys(N, 0), sorted(N, 0), out(N, 0), work(N, 0);
+    for (auto& k : keys) k = std::uint32_t(gen());
+    sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    MyVector<std::uint32_t> small(N, 0);
+    for (size_t i = 0; i < N; ++i) small[i] = keys[i] & 0xff;   // counts, so the sums stay small
+    auto top_byte = [](std::uint32_t k) { return k >> 24; };
+    auto low_half = [](std::uint32_t k) { return k < 0x80000000u; };
+    auto reset = [&]() { std::copy(keys.begin(), keys.end(), work.begin()); };
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v = base_my;
-                    v.clear();
-                });
-                csv << "MyVector,clear,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    h.run("std", "exclusive_scan", N, [&]() {
+        std::exclusive_scan(small.begin(), small.end(), out.begin(), 0u);
+        do_not_optimize(out);
+    });
+    h.run("std", "histogram", N, [&]() {
+        MyVector<size_t> counts(256, 0);
+        for (std::uint32_t k : sorted) ++counts[top_byte(k)];
+        do_not_optimize(counts);
+    });
+    h.run("std", "partition", N, reset, [&]() { do_not_optimize(std::partition(work.begin(), work.end(), low_half)); });
+    h.run("std", "stable_partition", N, reset, [&]() {
+        do_not_optimize(std::stable_partition(work.begin(), work.end(), low_half));
+    });
 
-            {
-                long long t_std = time_us([&](){
-                    auto v = base_std;
-                    v.insert(v.begin(), -1);
-                });
-                csv << "std::vector,insert_one,"<<N<<","<<run<<","<<t_std<<"\n";
+    h.run("my", "exclusive_scan", N, [&]() {
+        do_not_optimize(my::exclusive_scan(small, out, 0));
+        do_not_optimize(out);
+    });
+    h.run("my", "histogram", N, [&]() { do_not_optimize(my::histogram(sorted, 256, top_byte)); });
+    h.run("my", "partition", N, reset, [&]() { do_not_optimize(my::partition(work, low_half)); });
+    h.run("my", "stable_partition", N, reset, [&]() { do_not_optimize(my::stable_partition(work, low_half)); });
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v = base_my;
-                    v.insert(v.begin(), -1);
-                });
-                csv << "MyVector,insert_one,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    for (size_t t : thread_counts) {
+        const std::string name = "my::parallel/t" + std::to_string(t);
+        my::ThreadPool pool(t);
+        h.run(name, "exclusive_scan", N, [&]() {
+            do_not_optimize(my::parallel::exclusive_scan(small, out, 0, std::plus<>(), pool));
+            do_not_optimize(out);
+        });
+        h.run(name, "histogram", N, [&]() { do_not_optimize(my::parallel::histogram(sorted, 256, top_byte, pool)); });
+        h.run(name, "stable_partition", N, reset, [&]() {
+            do_not_optimize(my::parallel::stable_partition(work, low_half, pool));
+        });
+    }
+}
 
-            {
-                long long t_std = time_us([&](){
-                    auto v = base_std;
-                    v.erase(v.begin());
-                });
-                csv << "std::vector,erase_one,"<<N<<","<<run<<","<<t_std<<"\n";
+// Sorting N random values; my:: rows are repeated per thread count (".../tK")
+// to report scaling. std::sort is the single-threaded baseline.
+template<typename T>
+void bench_sort(BenchHarness& h, const std::string& type, size_t N) {
+    const std::string op = "sort<" + type + ">";
+    std::vector<size_t> thread_counts = {1};
+    for (size_t t = 2; t <= std::max<size_t>(4, my::default_sort_threads()); t *= 2)
+        thread_counts.push_back(t);
 
-                long long t_my = time_us([&](){
-                    MyVector<int> v = base_my;
-                    v.erase(v.begin());
-                });
-                csv << "MyVector,erase_one,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    bool any = h.selected("std::sort", op);
+    for (size_t t : thread_counts) {
+        const std::string suffix = "/t" + std::to_string(t);
+        any = any || h.selected("my::radix_sort" + suffix, op) || h.selected("my::merge_sort" + suffix, op);
+    }
+    if (!any) return;
 
-            {
-                auto v2 = base_std;
-                long long t_std = time_us([&](){
-                    volatile bool eq = (base_std == v2);
-                });
-                csv << "std::vector,compare_eq,"<<N<<","<<run<<","<<t_std<<"\n";
+    std::mt19937_64 gen(7);
+    MyVector<T> unsorted;
+    unsorted.reserve(N);
+    for (size_t i = 0; i < N; ++i) {
+        if constexpr (std::is_floating_point_v<T>)
+            unsorted.push_back(static_cast<T>(static_cast<std::int64_t>(gen()) >> 11) / T(1 << 20));
+        else
+            unsorted.push_back(static_cast<T>(gen()));
+    }
 
-                MyVector<int> m2(base_my);
-                long long t_my = time_us([&](){
-                    volatile bool eq = (base_my == m2);
-                });
-                csv << "MyVector,compare_eq,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
+    MyVector<T> v;
+    auto reset = [&]() { v = unsorted; };
+    h.run("std::sort", op, N, reset, [&]() {
+        std::sort(v.begin(), v.end());
+        do_not_optimize(v.begin());
+    });
+    for (size_t t : thread_counts) {
+        const std::string suffix = "/t" + std::to_string(t);
+        h.run("my::radix_sort" + suffix, op, N, reset, [&]() {
+            my::radix_sort(v, t);
+            do_not_optimize(v.begin());
+        });
+        h.run("my::merge_sort" + suffix, op, N, reset, [&]() {
+            my::merge_sort(v, std::less<T>(), t);
+            do_not_optimize(v.begin());
+        });
+    }
+}
 
-            {
-                auto v2 = base_std;
-                long long t_std = time_us([&](){
-                    auto a = base_std;
-                    a.swap(v2);
-                });
-                csv << "std::vector,swap,"<<N<<","<<run<<","<<t_std<<"\n";
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    try {
+        opts = parse_bench_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n"
+                  << "usage: compare [--runs N] [--warmup N] [--cpu ID] [--perf]"
+                     " [--out FILE] [--filter TEXT] [--large]\n";
+        return 1;
+    }
 
-                MyVector<int> m2(base_my);
-                long long t_my = time_us([&](){
-                    MyVector<int> a = base_my;
-                    a.swap(m2);
-                });
-                csv << "MyVector,swap,"<<N<<","<<run<<","<<t_my<<"\n";
-            }
-        }
+    std::ofstream csv(opts.out);
+    BenchHarness h(opts, &csv);
+
+    std::vector<size_t> vec_sizes = {10'000, 100'000};
+
+    for (auto N : vec_sizes) {
+        bench_vector<std::vector<int>>(h, "std::vector", N);
+        bench_vector<MyVector<int>>(h, "MyVector", N);
+    }
+
+    std::vector<size_t> elem_sizes = {1'000, 10'000};
+
+    for (auto N : elem_sizes) {
+        bench_element_kind<IntKind>(h, N);
+        bench_element_kind<Pod64Kind>(h, N);
+        bench_element_kind<StringSsoKind>(h, N);
+        bench_element_kind<StringHeapKind>(h, N);
+        bench_element_kind<UniquePtrKind>(h, N);
+        bench_element_kind<ThrowingMoveKind>(h, N);
+    }
+
+    for (auto N : vec_sizes) {
+        bench_fifo(h, N);
+        bench_gap(h, N);
+        bench_span(h, N);
     }
 
+    std::vector<size_t> lookup_sizes = {10'000, 100'000, 1'000'000, 10'000'000};
+    if (opts.large) lookup_sizes.push_back(100'000'000);
+
+    for (auto N : lookup_sizes)
+        bench_lookup(h, N);
+
+    std::vector<size_t> bit_sizes = {1'000'000, 10'000'000};
+    if (opts.large) bit_sizes.push_back(100'000'000);
+
+    for (auto N : bit_sizes)
+        bench_bits(h, N);
+
+    for (auto N : {1'000'000, 10'000'000})
+        bench_packed(h, size_t(N));
+
+    for (auto N : {10'000, 1'000'000})
+        bench_expr(h, size_t(N));
+
+    bench_static(h, 1'000'000);
+
+    for (auto N : {1'000'000, 10'000'000})
+        bench_gather(h, size_t(N));
+
+    for (auto N : {16'384, 1'000'000})
+        bench_kernels(h, size_t(N));
+
+    bench_snapshot(h, 4'000'000);
+
+    bench_compact(h, opts.large ? 10'000'000 : 1'000'000);
+
+    bench_jagged(h, 1'000'000);
+
+    for (auto N : {100'000, 4'000'000})
+        bench_shm(h, size_t(N));
+
+    for (auto N : {100'000, 10'000'000})
+        bench_tracked(h, size_t(N));
+
+    for (auto N : {1'000'000, 10'000'000})
+        bench_parallel(h, size_t(N));
+
+    for (auto N : {1'000'000, 30'000'000})
+        bench_collect(h, size_t(N));
+
+    for (auto N : {1'000'000, 10'000'000})
+        bench_batch(h, size_t(N));
+
+    bench_io(h, opts.large ? 50'000'000 : 5'000'000);
+
+    bench_numa(h, opts.large ? 100'000'000 : 10'000'000);
+
+    std::vector<size_t> sort_sizes = {100'000, 1'000'000, 10'000'000};
+
+    for (auto N : sort_sizes) {
+        bench_sort<std::int32_t>(h, "int32", N);
+        bench_sort<std::uint64_t>(h, "uint64", N);
+        bench_sort<double>(h, "double", N);
+    }
 
-    bench_myarray<1000>(csv, runs);
-    bench_myarray<5000>(csv, runs);
+    bench_myarray<1000>(h);
+    bench_myarray<5000>(h);
 
     csv.close();
-    std::cout << "Done. Results in results.csv\n";
+    h.print_summary(std::cout);
+    std::cout << "Done. Results in " << opts.out << "\n";
     return 0;
 }
@@ -2,83 +2,101 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
 
 #include <vector>
-#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 
 #include "my_vector.h"
 #include "my_array.h"
+#include "bench_harness.h"
 
 template<typename Vector>
-void run_benchmarks(const char* name) {
-    using namespace std::chrono;
+void run_benchmarks(BenchHarness& h, const char* name) {
     const size_t test_size = 100'000;
     std::mt19937 gen(42);
     std::uniform_int_distribution<int> dist(1, 1000);
 
     // Benchmark 1: Sequential push_back
-    {
+    h.run(name, "push_back", test_size, [&]() {
         Vector v;
-        auto start = high_resolution_clock::now();
         for (size_t i = 0; i < test_size; ++i) {
             v.push_back(dist(gen));
         }
-        auto end = high_resolution_clock::now();
-        std::cout << name << " push_back: "
-                  << duration_cast<microseconds>(end-start).count() << " μs\n";
-    }
+        do_not_optimize(v.begin());
+    });
 
     // Benchmark 2: Random insertions
-    {
+    h.run(name, "random insert", test_size, [&]() {
         Vector v;
-        auto start = high_resolution_clock::now();
         for (size_t i = 0; i < test_size; ++i) {
             v.insert(v.begin() + (i % (v.size()+1)), dist(gen));
         }
-        auto end = high_resolution_clock::now();
-        std::cout << name << " random insert: "
-                  << duration_cast<microseconds>(end-start).count() << " μs\n";
-    }
+        do_not_optimize(v.begin());
+    });
 
     // Benchmark 3: Iteration
     {
         Vector v(test_size, 42);
-        volatile int sum = 0; // Prevent optimization
-        auto start = high_resolution_clock::now();
-        for (const auto& x : v) {
-            sum += x;
-        }
-        auto end = high_resolution_clock::now();
-        std::cout << name << " iteration: "
-                  << duration_cast<microseconds>(end-start).count() << " μs\n";
+        h.run(name, "iteration", test_size, [&]() {
+            int sum = 0;
+            for (const auto& x : v) {
+                sum += x;
+            }
+            do_not_optimize(sum);
+        });
     }
 
     // Benchmark 4: Copy construction
     {
         Vector v(test_size, 42);
-        auto start = high_resolution_clock::now();
-        Vector v2 = v;
-        auto end = high_resolution_clock::now();
-        std::cout << name << " copy construct: "
-                  << duration_cast<microseconds>(end-start).count() << " μs\n";
+        h.run(name, "copy construct", test_size, [&]() {
+            Vector v2 = v;
+            do_not_optimize(v2.begin());
+        });
     }
 
     // Benchmark 5: Sorting
     {
         Vector v;
-        for (size_t i = 0; i < test_size; ++i) {
-            v.push_back(dist(gen));
-        }
-        auto start = high_resolution_clock::now();
-        std::sort(v.begin(), v.end());
-        auto end = high_resolution_clock::now();
-        std::cout << name << " sorting: "
-                  << duration_cast<microseconds>(end-start).count() << " μs\n";
+        h.run(name, "sorting", test_size,
+              [&]() {
+                  v.clear();
+                  for (size_t i = 0; i < test_size; ++i) {
+                      v.push_back(dist(gen));
+                  }
+              },
+              [&]() {
+                  std::sort(v.begin(), v.end());
+              });
     }
 }
 
-int main() {
-    run_benchmarks<std::vector<int>>("std::vector");
-    run_benchmarks<MyVector<int>>("MyVector");
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    opts.runs = 1;
+    opts.warmup = 0;
+    opts.out.clear();      // no CSV unless --out is given
+    try {
+        opts = parse_bench_options(argc, argv, opts);
+        if (opts.large) throw std::invalid_argument("--large is only supported by compare");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n"
+                  << "usage: my_vector [--runs N] [--warmup N] [--cpu ID] [--perf] [--out FILE] [--filter TEXT]\n";
+        return 1;
+    }
+
+    std::ofstream csv;
+    if (!opts.out.empty()) {
+        csv.open(opts.out);
+        if (!csv) {
+            std::cerr << "cannot write " << opts.out << "\n";
+            return 1;
+        }
+    }
+    BenchHarness h(opts, opts.out.empty() ? nullptr : &csv);
+    run_benchmarks<std::vector<int>>(h, "std::vector");
+    run_benchmarks<MyVector<int>>(h, "MyVector");
+    h.print_summary(std::cout);
     return 0;
-}
\ No newline at end of file
+}
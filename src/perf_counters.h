@@ -0,0 +1,145 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Thin wrapper over perf_event_open for the benchmark harness.
+// Every event is opened on its own, so a missing counter (VMs, containers,
+// perf_event_paranoid) only blanks that column instead of the whole group.
+class PerfCounters {
+public:
+    static constexpr std::size_t kEventCount = 6;
+    using Values = std::array<long long, kEventCount>; // -1 = not collected
+
+    static constexpr std::array<const char*, kEventCount> names = {
+        "cycles", "instructions", "l1d_misses",
+        "llc_misses", "dtlb_misses", "branch_misses"
+    };
+
+    PerfCounters() { fds_.fill(-1); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() { close_all(); }
+
+    // Returns true if at least one counter could be opened.
+    bool open() {
+#ifdef __linux__
+        close_all();
+        for (std::size_t i = 0; i < kEventCount; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            describe(i, attr);
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+        return available();
+    }
+
+    bool available() const noexcept {
+        for (int fd : fds_)
+            if (fd >= 0) return true;
+        return false;
+    }
+
+    void start() noexcept {
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    Values stop() noexcept {
+        Values values;
+        values.fill(-1);
+#ifdef __linux__
+        for (int fd : fds_)
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (std::size_t i = 0; i < kEventCount; ++i) {
+            if (fds_[i] < 0) continue;
+            std::uint64_t buf[3] = {0, 0, 0}; // value, time_enabled, time_running
+            if (read(fds_[i], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)))
+                continue;
+            // Scale up if the kernel had to multiplex the counter.
+            if (buf[2] != 0 && buf[2] < buf[1])
+                buf[0] = static_cast<std::uint64_t>(
+                    static_cast<double>(buf[0]) * static_cast<double>(buf[1]) / static_cast<double>(buf[2]));
+            values[i] = static_cast<long long>(buf[0]);
+        }
+#endif
+        return values;
+    }
+
+private:
+    std::array<int, kEventCount> fds_;
+
+    void close_all() noexcept {
+#ifdef __linux__
+        for (int& fd : fds_) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+#ifdef __linux__
+    static constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    static void describe(std::size_t i, perf_event_attr& attr) {
+        switch (i) {
+        case 0:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case 1:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case 2:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                      PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        case 3:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case 4:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                      PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        default:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        }
+    }
+#endif
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,127 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_algorithm.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+template<typename C>
+concept can_partition = requires(C c) { my::partition(c, [](int x) { return x > 5; }); };
+
+template<typename C>
+concept can_histogram = requires(const C& c) { my::histogram(c, 10); };
+
+template<typename In, typename Out>
+concept can_scan = requires(const In& in, Out out) { my::inclusive_scan(in, out); my::exclusive_scan(in, out, 0); };
+
+} // namespace
+
+TEST(MyAlgorithm, ScansMatchNumericAtEveryLevel) {
+    const my_simd::Level saved = my_simd::level();
+    std::mt19937 gen(3);
+    for (my_simd::Level level : {my_simd::Level::scalar, my_simd::Level::sse42, my_simd::Level::avx2}) {
+        if (my_simd::set_level(level) != level) continue;
+        SCOPED_TRACE(my_simd::level_name(level));
+        for (size_t n : {0, 1, 3, 8, 13, 1000}) {
+            MyVector<std::uint32_t> v(n, 0), out(n, 0), expected(n, 0);
+            for (auto& x : v) x = std::uint32_t(gen());
+            std::inclusive_scan(v.begin(), v.end(), expected.begin());
+            EXPECT_EQ(my::inclusive_scan(v, out), n ? expected.back() : 0);
+            EXPECT_EQ(out, expected);
+
+            MyVector<std::int64_t> w(n, 0), wexpected(n, 0);
+            for (auto& x : w) x = std::int64_t(gen()) - 2'000'000'000;
+            std::exclusive_scan(w.begin(), w.end(), wexpected.begin(), std::int64_t(10));
+            const std::int64_t total = std::accumulate(w.begin(), w.end(), std::int64_t(10));
+            EXPECT_EQ(my::exclusive_scan(w, w, 10), total);   // in place
+            EXPECT_EQ(w, wexpected);
+        }
+    }
+    my_simd::set_level(saved);
+}
+
+TEST(MyAlgorithm, ScansWithOtherTypesAndOps) {
+    MyArray<std::uint32_t, 4> counts{3, 0, 2, 5};
+    MyVector<std::uint64_t> offsets(4, 0);
+    EXPECT_EQ(my::exclusive_scan(counts, offsets, 0), 10);
+    EXPECT_EQ(offsets, (MyVector<std::uint64_t>{0, 3, 3, 5}));
+
+    MyVector<std::string> words{"a", "b", "c"}, joined(3, std::string());
+    EXPECT_EQ(my::inclusive_scan(words, joined), "abc");
+    EXPECT_EQ(joined[1], "ab");
+    MyVector<int> v{3, 1, 4, 1, 5}, maxima(5, 0);
+    my::inclusive_scan(v, maxima, [](int a, int b) { return std::max(a, b); });
+    EXPECT_EQ(maxima, (MyVector<int>{3, 3, 4, 4, 5}));
+    EXPECT_THROW(my::inclusive_scan(v, MySpan<int>(maxima).first(2)), std::invalid_argument);
+}
+
+TEST(MyAlgorithm, Histogram) {
+    MyVector<std::uint32_t> keys;
+    for (std::uint32_t i = 0; i < 100'000; ++i) keys.push_back(i % 7 == 0 ? 3 : i % 256);
+    MyVector<size_t> expected(256, 0);
+    for (std::uint32_t k : keys) ++expected[k];
+    EXPECT_EQ(my::histogram(keys, 256), expected);
+
+    MyVector<size_t> top = my::histogram(keys, 2, [](std::uint32_t k) { return k >> 7; });
+    EXPECT_EQ(top[0] + top[1], keys.size());
+    EXPECT_EQ(top[1], std::accumulate(expected.begin() + 128, expected.end(), size_t(0)));
+    // Many bins take the single-array path.
+    EXPECT_EQ(my::histogram(keys, 100'000)[3], expected[3]);
+    EXPECT_THROW(my::histogram(keys, 255), std::out_of_range);
+    EXPECT_THROW(my::histogram(MyVector<int>{-1}, 4), std::out_of_range);
+}
+
+TEST(MyAlgorithm, PartitionAndStablePartition) {
+    std::mt19937 gen(8);
+    MyVector<std::uint32_t> v;
+    for (int i = 0; i < 5000; ++i) v.push_back(std::uint32_t(gen() % 1000));
+    auto small = [](std::uint32_t x) { return x < 300; };
+
+    MyVector<std::uint32_t> a(v);
+    const size_t k = my::partition(a, small);
+    EXPECT_EQ(k, size_t(std::count_if(v.begin(), v.end(), small)));
+    EXPECT_TRUE(std::all_of(a.begin(), a.begin() + k, small));
+    EXPECT_TRUE(std::none_of(a.begin() + k, a.end(), small));
+    MyVector<std::uint32_t> sorted_a(a), sorted_v(v);
+    std::sort(sorted_a.begin(), sorted_a.end());
+    std::sort(sorted_v.begin(), sorted_v.end());
+    EXPECT_EQ(sorted_a, sorted_v);
+
+    MyVector<std::uint32_t> b(v), expected(v);
+    std::stable_partition(expected.begin(), expected.end(), small);
+    EXPECT_EQ(my::stable_partition(b, small), k);
+    EXPECT_EQ(b, expected);
+
+    // Three-way split of the rest of `a`.
+    const size_t mid = k + my::partition(MySpan<std::uint32_t>(a).subspan(k), [](std::uint32_t x) { return x < 600; });
+    EXPECT_TRUE(std::all_of(a.begin() + k, a.begin() + mid, [](std::uint32_t x) { return x >= 300 && x < 600; }));
+    EXPECT_TRUE(std::all_of(a.begin() + mid, a.end(), [](std::uint32_t x) { return x >= 600; }));
+
+    MyVector<std::string> words{"bb", "a", "ccc", "d"};
+    EXPECT_EQ(my::stable_partition(words, [](const std::string& w) { return w.size() == 1; }), 2);
+    EXPECT_EQ(words, (MyVector<std::string>{"a", "d", "bb", "ccc"}));
+}
+
+TEST(MyAlgorithm, StridedViewsAreRejected) {
+    static_assert(can_partition<MySpan<int>>);
+    static_assert(!can_partition<MyStridedView<int>>);
+    static_assert(can_histogram<MyVector<int>>);
+    static_assert(!can_histogram<MyStridedView<int>>);
+    static_assert(can_scan<MyVector<int>, MySpan<int>>);
+    static_assert(!can_scan<MyStridedView<int>, MySpan<int>>);
+    static_assert(!can_scan<MyVector<int>, MyStridedView<int>>);
+
+    // A column has to be copied out first.
+    MyVector<int> m{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto col = MySpan<int>(m).strided(2);
+    MyVector<int> copy(col.begin(), col.end());
+    EXPECT_EQ(my::partition(copy, [](int x) { return x > 5; }), 2);
+    EXPECT_EQ(my::histogram(copy, 10)[1], 0);
+}
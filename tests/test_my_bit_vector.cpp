@@ -0,0 +1,136 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_bit_vector.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<bool> random_bits(size_t n, unsigned seed, unsigned one_in = 2) {
+    std::mt19937 gen(seed);
+    std::vector<bool> bits(n);
+    for (size_t i = 0; i < n; ++i) bits[i] = gen() % one_in == 0;
+    return bits;
+}
+
+MyBitVector to_bit_vector(const std::vector<bool>& bits) {
+    MyBitVector v;
+    for (bool b : bits) v.push_back(b);
+    return v;
+}
+
+} // namespace
+
+TEST(MyBitVector, ConstructAndIndex) {
+    MyBitVector v(130, true);
+    EXPECT_EQ(v.size(), 130);
+    EXPECT_EQ(v.word_count(), 3);
+    EXPECT_EQ(v.count(), 130);
+    EXPECT_TRUE(v.all());
+
+    MyBitVector w{true, false, true};
+    EXPECT_TRUE(w[0]);
+    EXPECT_FALSE(w[1]);
+    EXPECT_TRUE(w.at(2));
+    EXPECT_THROW(w.at(3), std::out_of_range);
+}
+
+TEST(MyBitVector, ProxyReference) {
+    MyBitVector v(70);
+    v[3] = true;
+    v[69] = v[3];
+    v[5].flip();
+    EXPECT_TRUE(v[3]);
+    EXPECT_TRUE(v[69]);
+    EXPECT_TRUE(v[5]);
+    EXPECT_FALSE(~v[5]);
+    v.reset(3);
+    EXPECT_EQ(v.count(), 2);
+}
+
+TEST(MyBitVector, PushPopAndResizeKeepTailClear) {
+    MyBitVector v;
+    for (int i = 0; i < 65; ++i) v.push_back(true);
+    v.pop_back();
+    EXPECT_EQ(v.word_count(), 1);
+    EXPECT_EQ(v.count(), 64);
+    v.resize(10);
+    EXPECT_EQ(v.count(), 10);
+    v.resize(100, true);
+    EXPECT_EQ(v.count(), 100);
+    v.resize(100 + 28);
+    EXPECT_EQ(v.count(), 100);
+    v.flip();
+    EXPECT_EQ(v.count(), 28);
+}
+
+TEST(MyBitVector, CountMatchesReference) {
+    for (size_t n : {0, 1, 63, 64, 65, 255, 256, 257, 100'000}) {
+        auto bits = random_bits(n, unsigned(n));
+        MyBitVector v = to_bit_vector(bits);
+        size_t expected = 0;
+        for (bool b : bits) expected += b;
+        EXPECT_EQ(v.count(), expected) << n;
+        EXPECT_EQ(v.rank(n / 3), size_t(std::count(bits.begin(), bits.begin() + long(n / 3), true)));
+    }
+}
+
+TEST(MyBitVector, FindFirstAndNext) {
+    auto bits = random_bits(10'000, 7, 50);
+    MyBitVector v = to_bit_vector(bits);
+    std::vector<size_t> found;
+    for (size_t i = v.find_first(); i != MyBitVector::npos; i = v.find_next(i)) found.push_back(i);
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < bits.size(); ++i)
+        if (bits[i]) expected.push_back(i);
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(MyBitVector(100).find_first(), MyBitVector::npos);
+    EXPECT_EQ(v.find_next(MyBitVector::npos), MyBitVector::npos);
+    EXPECT_EQ(v.find_next(v.size()), MyBitVector::npos);
+    EXPECT_EQ(v.find_next(v.size() - 1), MyBitVector::npos);
+}
+
+TEST(MyBitVector, BitwiseOperations) {
+    auto a_bits = random_bits(1'000, 1), b_bits = random_bits(1'000, 2);
+    MyBitVector a = to_bit_vector(a_bits), b = to_bit_vector(b_bits);
+    MyBitVector both = a & b, either = a | b, diff = a ^ b, neg = ~a;
+    size_t and_count = 0;
+    for (size_t i = 0; i < a_bits.size(); ++i) {
+        ASSERT_EQ(both[i], a_bits[i] && b_bits[i]);
+        ASSERT_EQ(either[i], a_bits[i] || b_bits[i]);
+        ASSERT_EQ(diff[i], a_bits[i] != b_bits[i]);
+        ASSERT_EQ(neg[i], !a_bits[i]);
+        and_count += a_bits[i] && b_bits[i];
+    }
+    EXPECT_EQ(a.count_and(b), and_count);
+    EXPECT_EQ(neg.count() + a.count(), a.size());
+    EXPECT_THROW(a &= MyBitVector(3), std::invalid_argument);
+}
+
+TEST(MyBitVector, RankSelect) {
+    auto bits = random_bits(5'000, 3, 3);
+    MyBitVector v = to_bit_vector(bits);
+    MyBitRank index(v);
+    EXPECT_EQ(index.ones(), v.count());
+    size_t ones = 0;
+    for (size_t i = 0; i <= bits.size(); ++i) {
+        ASSERT_EQ(index.rank(i), ones) << i;
+        if (i < bits.size() && bits[i]) {
+            ASSERT_EQ(index.select(ones), i);
+            ++ones;
+        }
+    }
+    EXPECT_EQ(index.select(ones), MyBitRank::npos);
+}
+
+TEST(MyBitVector, CompareAndSwap) {
+    MyBitVector a{true, false}, b{true, false};
+    EXPECT_EQ(a, b);
+    b.push_back(false);
+    EXPECT_FALSE(a == b);
+    a.swap(b);
+    EXPECT_EQ(a.size(), 3);
+}
@@ -0,0 +1,189 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_compact_vector.h"
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+static_assert(sizeof(MyCompactVector<std::uint32_t>) == 16);
+static_assert(sizeof(MyThinVector<std::uint32_t>) == sizeof(void*));
+static_assert(sizeof(MyThinVector<std::string>) == sizeof(void*));
+
+namespace {
+
+struct alignas(32) Wide {
+    double x = 0;
+    bool operator==(const Wide&) const = default;
+};
+
+// Throws on the copy after `countdown` reaches zero.
+struct Fragile {
+    static inline int countdown = -1;
+    int value = 0;
+    Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("copy");
+    }
+    Fragile(Fragile&&) noexcept = default;
+    Fragile& operator=(const Fragile&) = default;
+};
+
+// Like Fragile, but without a move, so mid-vector inserts copy; assignment
+// throws too. `live` holds the address of every constructed object, so a
+// leak or a double destruction shows up.
+struct CopyOnly {
+    static inline int countdown = -1;
+    static inline std::set<const CopyOnly*> live;
+    static inline int bad_destroys = 0;
+    int value = 0;
+    CopyOnly(int v = 0) : value(v) { live.insert(this); }
+    CopyOnly(const CopyOnly& other) : value(other.value) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("copy");
+        live.insert(this);
+    }
+    CopyOnly& operator=(const CopyOnly& other) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("assign");
+        value = other.value;
+        return *this;
+    }
+    ~CopyOnly() {
+        if (live.erase(this) == 0) ++bad_destroys;
+    }
+};
+
+} // namespace
+
+template<typename V>
+class MyCompactVectorLayouts : public ::testing::Test {};
+
+using Layouts = ::testing::Types<MyCompactVector<std::string>, MyThinVector<std::string>>;
+TYPED_TEST_SUITE(MyCompactVectorLayouts, Layouts);
+
+TYPED_TEST(MyCompactVectorLayouts, PushInsertErase) {
+    TypeParam v;
+    EXPECT_TRUE(v.is_empty());
+    EXPECT_EQ(v.capacity(), 0);
+    for (int i = 0; i < 10; ++i) v.push_back(std::to_string(i));
+    EXPECT_EQ(v.size(), 10);
+    EXPECT_GE(v.capacity(), 10);
+    v.insert(v.begin(), "start");
+    v.emplace(v.begin() + 5, 3, 'x');
+    EXPECT_EQ(v.front(), "start");
+    EXPECT_EQ(v[5], "xxx");
+    EXPECT_EQ(v.back(), "9");
+    v.erase(v.begin(), v.begin() + 2);
+    EXPECT_EQ(v.front(), "1");
+    EXPECT_EQ(v.size(), 10);
+    v.pop_back();
+    EXPECT_EQ(v.back(), "8");
+    EXPECT_THROW(v.at(9), std::out_of_range);
+    EXPECT_THROW(v.erase(v.end()), std::out_of_range);
+
+    std::string more[] = {"a", "b"};
+    v.insert(v.end(), more, more + 2);
+    EXPECT_EQ(v.back(), "b");
+}
+
+TYPED_TEST(MyCompactVectorLayouts, CopyMoveCompare) {
+    TypeParam a{"x", "y", "z"};
+    TypeParam b(a);
+    EXPECT_EQ(a, b);
+    b.push_back("w");
+    EXPECT_LT(a, b);
+    TypeParam c(std::move(b));
+    EXPECT_TRUE(b.is_empty());
+    EXPECT_EQ(c.size(), 4);
+    a = c;
+    EXPECT_EQ(a, c);
+    c = TypeParam{};
+    EXPECT_TRUE(c.is_empty());
+    a.swap(c);
+    EXPECT_EQ(c.size(), 4);
+    EXPECT_TRUE(a.is_empty());
+}
+
+TYPED_TEST(MyCompactVectorLayouts, ResizeReserveShrink) {
+    TypeParam v(3, "q");
+    v.resize(6, "r");
+    EXPECT_EQ(v[5], "r");
+    v.resize(2);
+    EXPECT_EQ(v.size(), 2);
+    v.reserve(100);
+    EXPECT_EQ(v.capacity(), 100);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 2);
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0);
+    EXPECT_EQ(v.data(), nullptr);
+}
+
+TYPED_TEST(MyCompactVectorLayouts, SelfReferencingPushBack) {
+    TypeParam v{"self"};
+    for (int i = 0; i < 5; ++i) v.push_back(v[0]);
+    for (const auto& s : v) EXPECT_EQ(s, "self");
+}
+
+TEST(MyCompactVector, OverAlignedElementsInBothLayouts) {
+    MyCompactVector<Wide> a;
+    MyThinVector<Wide> b;
+    for (int i = 0; i < 9; ++i) {
+        a.push_back({double(i)});
+        b.push_back({double(i)});
+    }
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 32, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 32, 0);
+    EXPECT_EQ(b[8].x, 8.0);
+}
+
+TEST(MyCompactVector, FailedInsertLeavesVectorUnchanged) {
+    MyThinVector<Fragile> v;
+    v.reserve(8);
+    for (int i = 0; i < 4; ++i) v.emplace_back(i);
+    Fragile src[] = {Fragile(10), Fragile(11)};
+    Fragile::countdown = 1;
+    EXPECT_THROW(v.insert(v.begin() + 1, src, src + 2), std::runtime_error);
+    Fragile::countdown = -1;
+    ASSERT_EQ(v.size(), 4);
+    for (int i = 0; i < 4; ++i) EXPECT_EQ(v[size_t(i)].value, i);
+}
+
+TEST(MyCompactVector, ThrowingCopyKeepsElementsCounted) {
+    for (int fail_at = 0; fail_at < 8; ++fail_at) {
+        {
+            MyThinVector<CopyOnly> v;
+            v.reserve(16);
+            for (int i = 0; i < 6; ++i) v.emplace_back(i);
+            CopyOnly extra[] = {CopyOnly(10), CopyOnly(11)};
+            CopyOnly::countdown = fail_at;
+            try {
+                v.emplace(v.begin() + 1, 7);
+                v.insert(v.begin() + 2, extra, extra + 2);
+                v.erase(v.begin(), v.begin() + 2);
+            } catch (const std::runtime_error&) {
+            }
+            CopyOnly::countdown = -1;
+            EXPECT_EQ(v.capacity(), 16) << fail_at;
+            EXPECT_EQ(CopyOnly::live.size(), v.size() + 2) << fail_at;
+            for (const CopyOnly& c : v) EXPECT_EQ(CopyOnly::live.count(&c), 1) << fail_at;
+        }
+        EXPECT_TRUE(CopyOnly::live.empty()) << fail_at;
+        EXPECT_EQ(CopyOnly::bad_destroys, 0) << fail_at;
+    }
+    MyCompactVector<CopyOnly> v{1, 2, 4};
+    v.reserve(8);
+    v.emplace(v.begin() + 2, 3);
+    v.erase(v.begin());
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0].value + v[1].value * 10 + v[2].value * 100, 432);
+}
+
+TEST(MyCompactVector, SizeLimit) {
+    MyCompactVector<char> v;
+    EXPECT_EQ(v.max_size(), UINT32_MAX);
+    EXPECT_THROW(v.reserve(size_t(UINT32_MAX) + 1), std::length_error);
+    EXPECT_THROW(MyThinVector<char>(size_t(UINT32_MAX) + 1, 'a'), std::length_error);
+}
@@ -0,0 +1,57 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_expr.h"
+#include <stdexcept>
+
+TEST(MyExpr, FusedVectorExpression) {
+    MyVector<double> a{1, 2, 3}, b{10, 20, 30}, c{0.5, 0.5, 0.5};
+    MyVector<double> r = a * 2.0 + b - c;
+    ASSERT_EQ(r.size(), 3);
+    EXPECT_DOUBLE_EQ(r[0], 11.5);
+    EXPECT_DOUBLE_EQ(r[1], 23.5);
+    EXPECT_DOUBLE_EQ(r[2], 35.5);
+
+    r = 1.0 / (a + 1.0) * -b;
+    EXPECT_DOUBLE_EQ(r[0], -5.0);
+    EXPECT_DOUBLE_EQ(r[2], -7.5);
+}
+
+TEST(MyExpr, AssignInPlaceAndResize) {
+    MyVector<int> a{1, 2, 3};
+    a = a * a + a;
+    EXPECT_EQ(a, (MyVector<int>{2, 6, 12}));
+
+    MyVector<int> empty;
+    empty = a - 1;
+    EXPECT_EQ(empty, (MyVector<int>{1, 5, 11}));
+}
+
+TEST(MyExpr, MyArrayOperands) {
+    MyArray<float, 4> x{1, 2, 3, 4}, y{4, 3, 2, 1};
+    MyArray<float, 4> z = (x + y) * 0.5f;
+    for (size_t i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(z[i], 2.5f);
+    MyVector<float> v = x - y;
+    EXPECT_FLOAT_EQ(v[0], -3.0f);
+    MyArray<float, 3> wrong;
+    EXPECT_THROW(wrong = x + y, std::invalid_argument);
+}
+
+TEST(MyExpr, SizeMismatchIsChecked) {
+    MyVector<double> a(3, 1.0), b(4, 1.0);
+    EXPECT_THROW(a + b, std::invalid_argument);
+    EXPECT_THROW((void)my::dot(a, b), std::invalid_argument);
+}
+
+TEST(MyExpr, Reductions) {
+    MyVector<double> a{3, -1, 4, 1, -5, 9, 2};
+    MyVector<double> b(7, 2.0);
+    EXPECT_DOUBLE_EQ(my::sum(a), 13.0);
+    EXPECT_DOUBLE_EQ(my::dot(a, b), 26.0);
+    EXPECT_DOUBLE_EQ(my::sum(a * a - b), 137.0 - 14.0);
+    EXPECT_DOUBLE_EQ(my::min(a), -5.0);
+    EXPECT_DOUBLE_EQ(my::max(my::abs(a) * -1.0), -1.0);
+    EXPECT_DOUBLE_EQ(my::sum(my::sqrt(b * b)), 14.0);
+    EXPECT_THROW(my::min(MyVector<double>()), std::out_of_range);
+}
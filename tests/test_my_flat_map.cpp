@@ -0,0 +1,63 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_flat_map.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+TEST(MyFlatMap, BulkBuildFirstDuplicateWins) {
+    MyVector<std::pair<int, std::string>> items{{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+    MyFlatMap<int, std::string> m(items);
+    ASSERT_EQ(m.size(), 3);
+    EXPECT_EQ(m.at(3), "c");
+    EXPECT_EQ(m.keys()[0], 1);
+    EXPECT_EQ(m.values()[0], "a");
+}
+
+TEST(MyFlatMap, FindAndAt) {
+    MyFlatMap<int, int> m(SortedLayout::eytzinger);
+    for (int i = 0; i < 100; ++i) m.insert(i * 2, i);
+    ASSERT_NE(m.find(42), nullptr);
+    EXPECT_EQ(*m.find(42), 21);
+    EXPECT_EQ(m.find(43), nullptr);
+    EXPECT_THROW(m.at(43), std::out_of_range);
+}
+
+TEST(MyFlatMap, InsertDoesNotOverwrite) {
+    MyFlatMap<std::string, int> m;
+    EXPECT_TRUE(m.insert("a", 1));
+    EXPECT_FALSE(m.insert("a", 2));
+    EXPECT_EQ(m.at("a"), 1);
+    m.insert_or_assign("a", 3);
+    EXPECT_EQ(m.at("a"), 3);
+}
+
+TEST(MyFlatMap, EraseKeepsValuesAligned) {
+    MyFlatMap<int, char> m;
+    m.insert(1, 'a');
+    m.insert(2, 'b');
+    m.insert(3, 'c');
+    EXPECT_TRUE(m.erase(2));
+    EXPECT_FALSE(m.erase(2));
+    EXPECT_EQ(m.at(3), 'c');
+    EXPECT_EQ(m.at(1), 'a');
+}
+
+TEST(MyFlatMap, FindMany) {
+    MyVector<std::pair<int, int>> items;
+    for (int i = 0; i < 1000; ++i) items.push_back({i * 3, i});
+    for (auto layout : {SortedLayout::sorted, SortedLayout::eytzinger}) {
+        MyFlatMap<int, int> m(items, layout);
+        MyVector<int> queries{0, 1, 3, 2997, 2998, 3000, -5};
+        MyVector<size_t> pos = m.find_many(queries);
+        EXPECT_EQ(pos[0], 0);
+        EXPECT_EQ(pos[1], m.npos);
+        EXPECT_EQ(pos[2], 1);
+        EXPECT_EQ(pos[3], 999);
+        EXPECT_EQ(pos[4], m.npos);
+        EXPECT_EQ(pos[5], m.npos);
+        EXPECT_EQ(pos[6], m.npos);
+    }
+}
@@ -0,0 +1,118 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_gap_vector.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CountsMoves {
+    static inline int moves = 0;
+    int value;
+    explicit CountsMoves(int v) : value(v) {}
+    CountsMoves(const CountsMoves&) = default;
+    CountsMoves(CountsMoves&& other) noexcept : value(other.value) { ++moves; }
+};
+
+} // namespace
+
+TEST(MyGapVector, DefaultConstructor) {
+    MyGapVector<int> g;
+    EXPECT_TRUE(g.is_empty());
+    EXPECT_EQ(g.size(), 0);
+}
+
+TEST(MyGapVector, PushBackAndIndex) {
+    MyGapVector<int> g;
+    for (int i = 0; i < 10; ++i) g.push_back(i);
+    ASSERT_EQ(g.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(g[i], i);
+}
+
+TEST(MyGapVector, InsertAcrossTheGap) {
+    MyGapVector<std::string> g{"a", "d"};
+    g.insert(1, "b");
+    g.insert(2, "c");
+    g.insert(0, "_");
+    g.insert(5, "e");
+    std::vector<std::string> expected{"_", "a", "b", "c", "d", "e"};
+    EXPECT_TRUE(std::equal(g.begin(), g.end(), expected.begin(), expected.end()));
+}
+
+TEST(MyGapVector, LocalizedEditsKeepCursor) {
+    MyGapVector<char> g;
+    for (char c : std::string("hello world")) g.push_back(c);
+    g.move_cursor(5);
+    g.insert_at_cursor(',');
+    EXPECT_EQ(g.cursor(), 6);
+    g.erase(6);
+    g.insert(6, '!');
+    std::string text(g.begin(), g.end());
+    EXPECT_EQ(text, "hello,!world");
+}
+
+TEST(MyGapVector, EraseRange) {
+    MyGapVector<int> g{0, 1, 2, 3, 4, 5};
+    g.erase(1, 4);
+    ASSERT_EQ(g.size(), 3);
+    EXPECT_EQ(g[0], 0);
+    EXPECT_EQ(g[1], 4);
+    EXPECT_EQ(g[2], 5);
+    EXPECT_THROW(g.erase(2, 5), std::out_of_range);
+}
+
+TEST(MyGapVector, InsertCopyOfOwnElement) {
+    MyGapVector<std::string> g{"x", "y", std::string(40, 'z')};
+    g.move_cursor(0);
+    g.insert(3, g[2]);
+    g.insert(0, g[3]);
+    EXPECT_EQ(g[0], std::string(40, 'z'));
+    EXPECT_EQ(g[4], std::string(40, 'z'));
+}
+
+TEST(MyGapVector, EmplaceAtCursorConstructsInPlace) {
+    MyGapVector<CountsMoves> g;
+    g.reserve(8);
+    CountsMoves::moves = 0;
+    for (int i = 0; i < 8; ++i) g.emplace_back(i);
+    EXPECT_EQ(CountsMoves::moves, 0);
+    g.emplace(2, 42);   // moves the cursor, so it builds a temporary first
+    EXPECT_GT(CountsMoves::moves, 0);
+    EXPECT_EQ(g[2].value, 42);
+
+    MyGapVector<std::string> s{std::string(40, 'a')};
+    s.reserve(4);
+    s.insert_at_cursor(s[0]);
+    EXPECT_EQ(s[1], std::string(40, 'a'));
+}
+
+TEST(MyGapVector, AsContiguousAndExport) {
+    MyGapVector<int> g;
+    for (int i = 0; i < 8; ++i) g.insert(g.size() / 2, i);
+    MyVector<int> copy = g.to_vector();
+    int* data = g.as_contiguous();
+    ASSERT_EQ(copy.size(), g.size());
+    for (size_t i = 0; i < g.size(); ++i)
+        EXPECT_EQ(data[i], copy[i]);
+    EXPECT_EQ(g.cursor(), g.size());
+}
+
+TEST(MyGapVector, AtThrowsOutOfBounds) {
+    MyGapVector<int> g{1, 2, 3};
+    EXPECT_THROW(g.at(3), std::out_of_range);
+    EXPECT_THROW(g.insert(5, 0), std::out_of_range);
+}
+
+TEST(MyGapVector, CopyAndCompare) {
+    MyGapVector<int> a{1, 2, 3};
+    a.move_cursor(1);
+    MyGapVector<int> b = a;
+    EXPECT_EQ(a, b);
+    b.pop_back();
+    EXPECT_FALSE(a == b);
+}
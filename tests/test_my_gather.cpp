@@ -0,0 +1,149 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_array.h"
+#include "my_gather.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+template<typename T>
+MyVector<T> iota_values(size_t n) {
+    MyVector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(static_cast<T>(i * 3 + 1));
+    return v;
+}
+
+template<typename I>
+MyVector<I> random_indices(size_t n, size_t limit, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    MyVector<I> idx;
+    idx.reserve(n);
+    for (size_t i = 0; i < n; ++i) idx.push_back(static_cast<I>(rng() % limit));
+    return idx;
+}
+
+// Every length up to a few vector widths, so all the scalar tails are hit,
+// with and without prefetching.
+template<typename T, typename I>
+void check_gather() {
+    const MyVector<T> src = iota_values<T>(1000);
+    for (size_t n : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 33, 100}) {
+        const MyVector<I> idx = random_indices<I>(n, src.size(), static_cast<unsigned>(n));
+        for (size_t prefetch : {size_t(0), size_t(8), my::kAutoPrefetch}) {
+            MyVector<T> out = my::gather(src, idx, prefetch);
+            MyVector<T> scalar(n, T());
+            my_simd::gather_scalar(src.begin(), idx.begin(), n, scalar.begin());
+            ASSERT_EQ(out.size(), n);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(out[i], src[size_t(idx[i])]) << "n=" << n << " i=" << i;
+                ASSERT_EQ(out[i], scalar[i]);
+            }
+        }
+    }
+}
+
+template<typename Src, typename Idx>
+concept can_gather = requires(const Src& s, const Idx& i) { my::gather(s, i); };
+
+template<typename Dst, typename Idx, typename Values>
+concept can_scatter = requires(Dst d, const Idx& i, const Values& v) { my::scatter(d, i, v); };
+
+} // namespace
+
+TEST(MyGather, AllElementAndIndexWidths) {
+    check_gather<int, std::uint32_t>();
+    check_gather<int, size_t>();
+    check_gather<float, std::int32_t>();
+    check_gather<double, std::uint32_t>();
+    check_gather<double, std::int64_t>();
+    check_gather<std::int64_t, size_t>();
+    check_gather<std::uint16_t, std::uint32_t>();   // no SIMD path
+}
+
+TEST(MyGather, NonTrivialElementsUseScalarPath) {
+    MyVector<std::string> names{"a", "bb", "ccc"};
+    MyVector<std::uint32_t> idx{2, 0, 2, 1};
+    MyVector<std::string> picked = my::gather(names, idx);
+    ASSERT_EQ(picked.size(), 4);
+    EXPECT_EQ(picked[0], "ccc");
+    EXPECT_EQ(picked[1], "a");
+    EXPECT_EQ(picked[3], "bb");
+}
+
+TEST(MyGather, IntoSpanAndFromArray) {
+    MyArray<float, 5> table{0.5f, 1.5f, 2.5f, 3.5f, 4.5f};
+    MyArray<std::int32_t, 3> idx{4, 4, 1};
+    MyVector<float> out(3, 0.0f);
+    my::gather(table, idx, MySpan<float>(out));
+    EXPECT_EQ(out[0], 4.5f);
+    EXPECT_EQ(out[1], 4.5f);
+    EXPECT_EQ(out[2], 1.5f);
+    MyVector<float> wrong(2, 0.0f);
+    EXPECT_THROW(my::gather(table, idx, wrong), std::invalid_argument);
+}
+
+TEST(MyGather, ScatterLastDuplicateWins) {
+    MyVector<int> dst(6, 0);
+    MyVector<size_t> idx{5, 1, 5, 0};
+    MyVector<int> values{10, 20, 30, 40};
+    my::scatter(dst, idx, values);
+    EXPECT_EQ(dst[0], 40);
+    EXPECT_EQ(dst[1], 20);
+    EXPECT_EQ(dst[5], 30);
+    EXPECT_EQ(dst[2], 0);
+
+    // Scatter inverts gather for a permutation, with prefetching on.
+    const MyVector<double> src = iota_values<double>(257);
+    MyVector<std::uint32_t> perm;
+    for (std::uint32_t i = 0; i < 257; ++i) perm.push_back((i * 101) % 257);
+    MyVector<double> back(257, 0.0);
+    my::scatter(back, perm, my::gather(src, perm), 16);
+    EXPECT_EQ(back, src);
+}
+
+TEST(MyGather, Permute) {
+    MyVector<int> v{10, 20, 30, 40};
+    MyVector<std::uint32_t> order{3, 2, 1, 0};
+    MyVector<int> reversed = my::permute(v, order);
+    EXPECT_EQ(reversed, (MyVector<int>{40, 30, 20, 10}));
+    MyVector<std::uint32_t> short_order{0, 1};
+    EXPECT_THROW(my::permute(v, short_order), std::invalid_argument);
+}
+
+TEST(MyGather, BadIndicesThrowBeforeTouchingAnything) {
+    MyVector<int> src{1, 2, 3};
+    EXPECT_THROW(my::gather(src, MyVector<size_t>{0, 3}), std::out_of_range);
+    EXPECT_THROW(my::gather(src, MyVector<int>{1, -1}), std::out_of_range);
+
+    MyVector<int> dst(3, 7);
+    EXPECT_THROW(my::scatter(dst, MyVector<std::uint32_t>{0, 9}, MyVector<int>{1, 2}), std::out_of_range);
+    EXPECT_THROW(my::scatter(dst, MyVector<std::uint32_t>{0, 1}, MyVector<int>{1}), std::invalid_argument);
+    EXPECT_EQ(dst, (MyVector<int>(3, 7)));
+
+    EXPECT_TRUE(my::gather(MyVector<int>{}, MyVector<size_t>{}).is_empty());
+}
+
+TEST(MyGather, DefaultPrefetchDistance) {
+    EXPECT_EQ(my::default_prefetch_distance(64 << 10), 0);
+    EXPECT_GT(my::default_prefetch_distance(size_t(64) << 20), 0);
+}
+
+TEST(MyGather, StridedViewsAreRejected) {
+    static_assert(can_gather<MySpan<int>, MyVector<size_t>>);
+    static_assert(!can_gather<MyStridedView<int>, MyVector<size_t>>);
+    static_assert(!can_gather<MyVector<int>, MyStridedView<size_t>>);
+    static_assert(can_scatter<MySpan<int>, MyVector<size_t>, MyVector<int>>);
+    static_assert(!can_scatter<MyStridedView<int>, MyVector<size_t>, MyVector<int>>);
+
+    // A column has to be copied out to be gathered from.
+    MyVector<int> m{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto col = MySpan<int>(m).strided(2);
+    const MyVector<int> copy(col.begin(), col.end());
+    EXPECT_EQ(my::gather(copy, MyVector<size_t>{1, 2}), (MyVector<int>{2, 4}));
+}
@@ -0,0 +1,142 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_io.h"
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+std::string temp_path(const std::string& name) { return testing::TempDir() + "my_io_" + name; }
+
+void write_text(const std::string& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+struct Row {
+    std::string container;
+    std::string operation;
+    size_t size;
+    long long time_us;
+};
+
+// container,operation,size,run,time_us
+Row parse_row(std::string_view line) {
+    MyVector<std::string_view> f;
+    for (size_t pos = 0;;) {
+        size_t comma = line.find(',', pos);
+        f.push_back(line.substr(pos, comma - pos));
+        if (comma == std::string_view::npos) break;
+        pos = comma + 1;
+    }
+    return {std::string(f[0]), std::string(f[1]), std::stoul(std::string(f[2])), std::stoll(std::string(f[4]))};
+}
+
+} // namespace
+
+TEST(MyIo, BinaryRoundTrip) {
+    const std::string path = temp_path("values.bin");
+    MyVector<std::uint64_t> values(100003, 0);
+    std::iota(values.begin(), values.end(), 1);
+    my_io::save_binary(path, MySpan<const std::uint64_t>(values));
+
+    for (size_t chunk : {size_t(1000), size_t(4096), my_io::kDefaultChunkBytes}) {
+        MyVector<std::uint64_t> loaded{42};
+        my_io::load_binary(path, loaded, chunk);
+        ASSERT_EQ(loaded.size(), values.size() + 1) << chunk;
+        EXPECT_EQ(loaded[0], 42);
+        for (size_t i = 0; i < values.size(); ++i) ASSERT_EQ(loaded[i + 1], values[i]);
+    }
+    EXPECT_EQ(my_io::load_binary<std::uint64_t>(path), values);
+}
+
+TEST(MyIo, BinarySizeMismatchThrows) {
+    const std::string path = temp_path("odd.bin");
+    write_text(path, "12345");
+    EXPECT_THROW(my_io::load_binary<std::uint32_t>(path), std::runtime_error);
+    EXPECT_THROW(my_io::load_binary<std::uint32_t>(temp_path("missing.bin")), std::system_error);
+}
+
+TEST(MyIo, ChunksCoverTheFile) {
+    const std::string path = temp_path("chunks.txt");
+    std::string text(10000, 'x');
+    for (size_t i = 0; i < text.size(); ++i) text[i] = static_cast<char>('a' + i % 26);
+    write_text(path, text);
+
+    my_io::ChunkReader reader(path, 333);
+    EXPECT_EQ(reader.file_size(), text.size());
+    std::string joined;
+    for (MySpan<const char> chunk : reader) {
+        EXPECT_LE(chunk.size(), 333);
+        joined.append(chunk.data(), chunk.size());
+    }
+    EXPECT_EQ(joined, text);
+    EXPECT_TRUE(reader.next().is_empty());
+}
+
+TEST(MyIo, StopsEarlyWithoutHanging) {
+    const std::string path = temp_path("early.bin");
+    write_text(path, std::string(1 << 20, 'z'));
+    my_io::ChunkReader reader(path, 4096);
+    EXPECT_EQ(reader.next().size(), 4096);
+}
+
+TEST(MyIo, FailedConstructionClosesTheFile) {
+    const std::string path = temp_path("unopened.bin");
+    write_text(path, "data");
+    // open() returns the lowest free descriptor, so a leak shifts it.
+    auto lowest_free_fd = [] {
+        int fd = ::open("/dev/null", O_RDONLY);
+        ::close(fd);
+        return fd;
+    };
+    const int before = lowest_free_fd();
+    EXPECT_THROW(my_io::ChunkReader(path, size_t(1) << 62), std::bad_alloc);
+    EXPECT_EQ(lowest_free_fd(), before);
+}
+
+TEST(MyIo, LinesAcrossChunkBoundaries) {
+    const std::string path = temp_path("lines.txt");
+    std::string text;
+    MyVector<std::string> expected;
+    for (int i = 0; i < 500; ++i) {
+        std::string line = i % 7 == 0 ? "" : std::string(static_cast<size_t>(i % 23), char('a' + i % 26));
+        expected.push_back(line);
+        text += line + (i % 3 == 0 ? "\r\n" : "\n");
+    }
+    text += "last";
+    expected.push_back("last");
+    write_text(path, text);
+
+    for (size_t chunk : {size_t(1), size_t(5), size_t(64), size_t(1 << 20)}) {
+        MyVector<std::string> lines;
+        my_io::for_each_line(path, [&](std::string_view line) { lines.push_back(std::string(line)); }, chunk);
+        ASSERT_EQ(lines, expected) << chunk;
+    }
+}
+
+TEST(MyIo, LoadResultsCsvRows) {
+    const std::string path = temp_path("results.csv");
+    std::string text = "container,operation,size,run,time_us\n";
+    for (int i = 0; i < 1000; ++i)
+        text += "MyVector,push_back," + std::to_string(i) + ",1," + std::to_string(i * 10) + "\n";
+    write_text(path, text);
+
+    MyVector<Row> rows;
+    my_io::load_lines(path, rows, parse_row, true, 256);
+    ASSERT_EQ(rows.size(), 1000);
+    EXPECT_EQ(rows[999].container, "MyVector");
+    EXPECT_EQ(rows[999].size, 999);
+    EXPECT_EQ(rows[999].time_us, 9990);
+    // One reserve from the first chunk's line length covers the file.
+    EXPECT_GE(rows.capacity(), 1000);
+    EXPECT_LT(rows.capacity(), 1200);
+}
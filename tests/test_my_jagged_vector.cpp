@@ -0,0 +1,155 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_jagged_vector.h"
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using JaggedIt = MyJaggedVector<int>::const_iterator;
+static_assert(std::forward_iterator<JaggedIt>);
+static_assert(std::is_same_v<std::iterator_traits<JaggedIt>::iterator_category, std::input_iterator_tag>);
+
+namespace {
+
+template<typename T>
+void expect_same(const MyJaggedVector<T>& j, const MyVector<MyVector<T>>& model) {
+    ASSERT_EQ(j.rows(), model.size());
+    size_t total = 0;
+    for (size_t r = 0; r < model.size(); ++r) {
+        MySpan<const T> row = j.row(r);
+        ASSERT_EQ(row.size(), model[r].size()) << "row " << r;
+        for (size_t i = 0; i < row.size(); ++i) ASSERT_EQ(row[i], model[r][i]) << "row " << r;
+        total += row.size();
+    }
+    EXPECT_EQ(j.size(), total);
+}
+
+} // namespace
+
+TEST(MyJaggedVector, BuildAndScan) {
+    MyJaggedVector<int> j;
+    j.push_row({1, 2, 3});
+    j.push_row();
+    j.push_row({4});
+    j.push_back(5);
+    j.push_back(6);
+    EXPECT_EQ(j.rows(), 3);
+    EXPECT_EQ(j.size(), 6);
+    EXPECT_TRUE(j.is_compact());
+    EXPECT_EQ(j.offsets(), (MyVector<size_t>{0, 3, 3, 6}));
+    EXPECT_EQ(j.values(), (MyVector<int>{1, 2, 3, 4, 5, 6}));
+    EXPECT_EQ(j.row_size(1), 0);
+
+    int sum = 0;
+    size_t rows = 0;
+    for (MySpan<const int> row : j) {
+        for (int x : row) sum += x;
+        ++rows;
+    }
+    EXPECT_EQ(sum, 21);
+    EXPECT_EQ(rows, 3);
+
+    j[0][1] = 20;
+    EXPECT_EQ(j.row(0)[1], 20);
+    EXPECT_THROW(j.row(3), std::out_of_range);
+    EXPECT_THROW(MyJaggedVector<int>().push_back(1), std::out_of_range);
+}
+
+TEST(MyJaggedVector, FromNested) {
+    MyVector<MyVector<std::string>> nested{{"a", "b"}, {}, {"c"}};
+    MyJaggedVector<std::string> j(nested);
+    expect_same(j, nested);
+    EXPECT_EQ(j.values().capacity(), 3);
+}
+
+TEST(MyJaggedVector, EditedRowsMoveAndCompact) {
+    MyJaggedVector<int> j;
+    j.push_row({1, 2});
+    j.push_row({3, 4});
+    j.push_row({5});
+
+    j.append_to_row(0, 9);          // row 0 moves to the end
+    EXPECT_FALSE(j.is_compact());
+    EXPECT_EQ(j.wasted(), 2);
+    j.append_to_row(0, j.row(1)[0]);  // argument aliases the storage
+    j.push_row({6});                // new row after a moved one
+    j.push_back(7);
+    j.assign_row(1, MyVector<int>{8});   // shrinks in place
+    j.clear_row(2);
+
+    MyVector<MyVector<int>> model{{1, 2, 9, 3}, {8}, {}, {6, 7}};
+    expect_same(j, model);
+
+    j.compact();
+    EXPECT_TRUE(j.is_compact());
+    EXPECT_EQ(j.wasted(), 0);
+    EXPECT_EQ(j.values(), (MyVector<int>{1, 2, 9, 3, 8, 6, 7}));
+    expect_same(j, model);
+}
+
+TEST(MyJaggedVector, AssignRowFromItsOwnStorage) {
+    MyJaggedVector<int> j;
+    j.push_row({1, 2, 3});
+    j.push_row({4});
+    j.assign_row(1, j.row(0));
+    j.assign_row(0, j.row(0).subspan(1));
+    expect_same(j, MyVector<MyVector<int>>{{2, 3}, {1, 2, 3}});
+}
+
+TEST(MyJaggedVector, PopRow) {
+    MyJaggedVector<int> j;
+    j.push_row({1});
+    j.push_row({2, 3});
+    j.pop_row();
+    EXPECT_EQ(j.values().size(), 1);
+    j.append_to_row(0, 4);
+    j.push_row({5});
+    j.pop_row();
+    j.pop_row();
+    EXPECT_TRUE(j.is_empty());
+    EXPECT_THROW(j.pop_row(), std::out_of_range);
+    j.push_row({6});
+    j.compact();
+    EXPECT_EQ(j.values(), MyVector<int>{6});
+}
+
+// Random edits checked against MyVector<MyVector<int>>.
+TEST(MyJaggedVector, MatchesNestedVectorUnderRandomEdits) {
+    std::mt19937 gen(5);
+    MyJaggedVector<int> j;
+    MyVector<MyVector<int>> model;
+    for (int step = 0; step < 5000; ++step) {
+        const unsigned op = gen() % 10;
+        const int value = int(gen() % 1000);
+        if (model.is_empty() || op < 2) {
+            j.push_row({value});
+            model.push_back(MyVector<int>{value});
+        } else if (op < 5) {
+            j.push_back(value);
+            model.back().push_back(value);
+        } else if (op < 8) {
+            const size_t r = gen() % model.size();
+            j.append_to_row(r, value);
+            model[r].push_back(value);
+        } else if (op == 8) {
+            const size_t r = gen() % model.size();
+            MyVector<int> row(gen() % 5, value);
+            j.assign_row(r, row);
+            model[r] = row;
+        } else if (gen() % 4 == 0) {
+            j.pop_row();
+            model.pop_back();
+        } else {
+            j.compact();
+            EXPECT_TRUE(j.is_compact());
+        }
+    }
+    expect_same(j, model);
+    j.compact();
+    expect_same(j, model);
+    EXPECT_EQ(j.values().size(), j.size());
+}
@@ -0,0 +1,69 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_numa.h"
+#include <cstdint>
+#include <numeric>
+
+TEST(MyNuma, ParseList) {
+    EXPECT_EQ(my_numa::parse_list("0"), (MyVector<int>{0}));
+    EXPECT_EQ(my_numa::parse_list("0-3,8,10-11"), (MyVector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(my_numa::parse_list("").is_empty());
+}
+
+TEST(MyNuma, Topology) {
+    ASSERT_GE(my_numa::node_count(), 1);
+    const int current = my_numa::current_node();
+    EXPECT_NE(std::find(my_numa::nodes().begin(), my_numa::nodes().end(), current), my_numa::nodes().end());
+    for (size_t k = 0; k < 8; ++k) {
+        const int node = my_numa::node_for_worker(k, 8);
+        EXPECT_NE(std::find(my_numa::nodes().begin(), my_numa::nodes().end(), node), my_numa::nodes().end());
+    }
+    EXPECT_EQ(my_numa::node_for_worker(0, 8), my_numa::nodes()[0]);
+}
+
+#ifdef __linux__
+TEST(MyNuma, BindPlacesPagesOnNode) {
+    const int node = my_numa::nodes().back();
+    MyVector<std::uint64_t> v;
+    v.reserve(1 << 20);
+    if (!my_numa::place(v, my_numa::Placement::bind, node))
+        GTEST_SKIP() << "mbind not permitted here";
+    v.resize(1 << 20, 7);
+    EXPECT_EQ(my_numa::node_of(v.begin() + v.size() / 2), node);
+    const auto pages = my_numa::pages_per_node(v.begin(), v.size() * sizeof(std::uint64_t));
+    const size_t total = std::accumulate(pages.begin(), pages.end(), size_t(0));
+    EXPECT_EQ(pages[size_t(node)], total);
+    EXPECT_GE(total, v.size() * sizeof(std::uint64_t) / 4096 - 1);
+}
+
+TEST(MyNuma, InterleaveCoversAllNodes) {
+    MyVector<std::uint64_t> v;
+    v.reserve(1 << 20);
+    if (!my_numa::place(v, my_numa::Placement::interleave))
+        GTEST_SKIP() << "mbind not permitted here";
+    v.resize(1 << 20, 1);
+    const auto pages = my_numa::pages_per_node(v.begin(), v.size() * sizeof(std::uint64_t));
+    for (int n : my_numa::nodes()) EXPECT_GT(pages[size_t(n)], 0);
+}
+
+TEST(MyNuma, FirstTouchKeepsData) {
+    MyVector<int> v(100000, 0);
+    std::iota(v.begin(), v.end(), 0);
+    EXPECT_TRUE(my_numa::place(v, my_numa::Placement::first_touch, 0, 4));
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], static_cast<int>(i));
+    EXPECT_GE(my_numa::node_of(v.begin()), 0);
+}
+#endif
+
+TEST(MyNuma, NodePinRestoresAffinity) {
+    const int node = my_numa::nodes()[0];
+    {
+        my_numa::NodePin pin(node);
+        if (pin.pinned()) {
+            EXPECT_EQ(my_numa::current_node(), node);
+        }
+    }
+    EXPECT_GE(my_numa::current_node(), 0);
+}
@@ -0,0 +1,110 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_packed_int_vector.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+MyVector<std::uint64_t> random_values(size_t n, unsigned bits, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    MyVector<std::uint64_t> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(gen() & my_packing::width_mask(bits));
+    return values;
+}
+
+} // namespace
+
+TEST(MyPackedIntVector, BulkBuildPicksMinimalWidth) {
+    MyPackedIntVector v{5, 17, 1023, 0};
+    EXPECT_EQ(v.width(), 10);
+    EXPECT_EQ(v.size(), 4);
+    EXPECT_EQ(v[2], 1023);
+    EXPECT_EQ(v.at(3), 0);
+    EXPECT_THROW(v.at(4), std::out_of_range);
+}
+
+TEST(MyPackedIntVector, RandomAccessAtEveryWidth) {
+    for (unsigned bits : {1u, 7u, 13u, 31u, 32u, 33u, 56u, 57u, 63u, 64u}) {
+        auto values = random_values(1'000, bits, bits);
+        MyPackedIntVector v(values);
+        ASSERT_LE(v.width(), bits);
+        for (size_t i = 0; i < values.size(); ++i)
+            ASSERT_EQ(v[i], values[i]) << bits << " bits, index " << i;
+        EXPECT_EQ(v.decode(), values) << bits << " bits";
+    }
+}
+
+TEST(MyPackedIntVector, PushBackRewidens) {
+    MyPackedIntVector v;
+    EXPECT_EQ(v.width(), 0);
+    MyVector<std::uint64_t> expected;
+    for (std::uint64_t x : {0ull, 1ull, 2ull, 300ull, 5ull, 1ull << 40, 7ull}) {
+        v.push_back(x);
+        expected.push_back(x);
+    }
+    EXPECT_EQ(v.width(), 41);
+    EXPECT_EQ(v.decode(), expected);
+    v.set(1, ~0ull);
+    EXPECT_EQ(v.width(), 64);
+    EXPECT_EQ(v[1], ~0ull);
+    EXPECT_EQ(v[5], 1ull << 40);
+}
+
+TEST(MyPackedIntVector, PartialDecodeAndPop) {
+    auto values = random_values(777, 19, 3);
+    MyPackedIntVector v(values);
+    std::uint64_t out[100];
+    v.decode(333, 100, out);
+    for (size_t i = 0; i < 100; ++i) ASSERT_EQ(out[i], values[333 + i]);
+    EXPECT_THROW(v.decode(700, 100, out), std::out_of_range);
+    v.pop_back();
+    EXPECT_EQ(v.size(), 776);
+    EXPECT_THROW(MyPackedIntVector().pop_back(), std::out_of_range);
+}
+
+TEST(MyPackedIntVector, SavesMemory) {
+    auto values = random_values(100'000, 16, 4);
+    MyPackedIntVector v(values);
+    EXPECT_LE(v.memory_bytes() * 3, values.size() * sizeof(std::uint64_t));
+}
+
+TEST(MyBlockPackedVector, FrameOfReference) {
+    std::mt19937_64 gen(5);
+    MyVector<std::uint64_t> values;
+    for (size_t i = 0; i < 1'000; ++i) values.push_back((1ull << 50) + (i / 128) * 1'000'000 + gen() % 4096);
+    MyBlockPackedVector v(values);
+    ASSERT_EQ(v.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) ASSERT_EQ(v[i], values[i]) << i;
+    EXPECT_EQ(v.decode(), values);
+}
+
+TEST(MyBlockPackedVector, SavesMemoryOnIdColumns) {
+    std::mt19937_64 gen(7);
+    MyVector<std::uint64_t> ids;
+    std::uint64_t id = 1ull << 40;
+    for (size_t i = 0; i < 100'000; ++i) ids.push_back(id += 1 + gen() % 1000);
+    const size_t raw = ids.size() * sizeof(std::uint64_t);
+    MyBlockPackedVector delta(ids, BlockEncoding::delta), frame(ids);
+    delta.shrink_to_fit();
+    frame.shrink_to_fit();
+    EXPECT_LT(delta.memory_bytes() * 5, raw);
+    EXPECT_LT(frame.memory_bytes() * 3, raw);
+}
+
+TEST(MyBlockPackedVector, DeltaOfSortedIds) {
+    std::mt19937_64 gen(6);
+    MyVector<std::uint64_t> ids;
+    std::uint64_t id = 1ull << 33;
+    for (size_t i = 0; i < 1'000; ++i) ids.push_back(id += gen() % 64);
+    MyBlockPackedVector v(ids, BlockEncoding::delta);
+    for (size_t i = 0; i < ids.size(); ++i) ASSERT_EQ(v[i], ids[i]) << i;
+    std::uint64_t out[300];
+    v.decode(100, 300, out);
+    for (size_t i = 0; i < 300; ++i) ASSERT_EQ(out[i], ids[100 + i]);
+    EXPECT_EQ(v.back(), ids.back());
+    EXPECT_THROW(v.push_back(0), std::invalid_argument);
+}
@@ -0,0 +1,166 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+template<typename C>
+concept can_reduce = requires(const C& c) { my::parallel::reduce(c, 0); };
+
+template<typename C>
+concept can_histogram = requires(const C& c) { my::parallel::histogram(c, 10); };
+
+template<typename C>
+concept can_partition = requires(C c) { my::parallel::partition(c, [](int x) { return x > 5; }); };
+
+} // namespace
+
+TEST(ThreadPool, RunCoversEveryIndexOnce) {
+    my::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    MyVector<int> hits(100000, 0);
+    pool.run(hits.size(), 100, [&](size_t begin, size_t end, size_t slot) {
+        ASSERT_LT(slot, pool.slots());
+        for (size_t i = begin; i < end; ++i) ++hits[i];
+    });
+    for (int h : hits) ASSERT_EQ(h, 1);
+}
+
+TEST(ThreadPool, PropagatesException) {
+    my::ThreadPool pool(3);
+    EXPECT_THROW(pool.run(10000, 10, [](size_t begin, size_t, size_t) {
+        if (begin >= 5000) throw std::runtime_error("boom");
+    }), std::runtime_error);
+    // The pool is still usable afterwards.
+    std::atomic<size_t> count{0};
+    pool.run(1000, 10, [&](size_t begin, size_t end, size_t) { count += end - begin; });
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPool, NestedLoops) {
+    my::ThreadPool pool(4);
+    std::atomic<size_t> count{0};
+    pool.run(64, 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i)
+            pool.run(1000, 50, [&](size_t b, size_t e, size_t) { count += e - b; });
+    });
+    EXPECT_EQ(count.load(), 64 * 1000);
+}
+
+TEST(ThreadPool, ConcurrentOutsideCallers) {
+    my::ThreadPool pool(2);
+    std::atomic<size_t> count{0};
+    auto loop = [&]() {
+        for (int r = 0; r < 20; ++r)
+            pool.run(5000, 16, [&](size_t b, size_t e, size_t) { count += e - b; });
+    };
+    std::thread a(loop), b(loop);
+    loop();
+    a.join();
+    b.join();
+    EXPECT_EQ(count.load(), 3 * 20 * 5000);
+}
+
+TEST(Parallel, ForEachAndTransform) {
+    my::ThreadPool pool(4);
+    MyVector<int> v(50000, 1);
+    my::parallel::for_each(v, [](int& x) { x *= 3; }, pool);
+    for (int x : v) ASSERT_EQ(x, 3);
+
+    MyVector<double> out(v.size(), 0.0);
+    my::parallel::transform(v, out, [](int x) { return x * 0.5; }, pool);
+    for (double x : out) ASSERT_EQ(x, 1.5);
+
+    MyArray<int, 4> a{1, 2, 3, 4};
+    my::parallel::transform(a, a, [](int x) { return -x; }, pool);
+    EXPECT_EQ(a[3], -4);
+
+    MyVector<int> wrong(3, 0);
+    EXPECT_THROW(my::parallel::transform(v, wrong, [](int x) { return x; }, pool), std::invalid_argument);
+}
+
+TEST(Parallel, Reduce) {
+    my::ThreadPool pool(4);
+    MyVector<std::int64_t> v(1000003, 0);
+    std::iota(v.begin(), v.end(), 0);
+    EXPECT_EQ(my::parallel::reduce(v, std::int64_t(5), std::plus<>(), pool),
+              std::accumulate(v.begin(), v.end(), std::int64_t(5)));
+    EXPECT_EQ(my::parallel::reduce(v, std::int64_t(0), [](auto a, auto b) { return std::max(a, b); }, pool),
+              1000002);
+    MyVector<std::int64_t> empty;
+    EXPECT_EQ(my::parallel::reduce(empty, std::int64_t(7), std::plus<>(), pool), 7);
+    // Default pool and a span.
+    EXPECT_EQ(my::parallel::reduce(MySpan<const std::int64_t>(v).first(10), std::int64_t(0)), 45);
+}
+
+TEST(Parallel, InclusiveScan) {
+    my::ThreadPool pool(4);
+    for (size_t n : {size_t(1), size_t(4095), size_t(100000), size_t(1234567)}) {
+        MyVector<std::uint64_t> v(n, 0), out(n, 0), expected(n, 0);
+        std::iota(v.begin(), v.end(), 1);
+        std::inclusive_scan(v.begin(), v.end(), expected.begin());
+        my::parallel::inclusive_scan(v, out, std::plus<>(), pool);
+        ASSERT_EQ(out, expected) << n;
+        my::parallel::inclusive_scan(v, v, std::plus<>(), pool);   // in place
+        ASSERT_EQ(v, expected) << n;
+    }
+    MyVector<std::string> words{"a", "b", "c"}, joined(3, std::string());
+    my::parallel::inclusive_scan(words, joined, std::plus<>(), pool);
+    EXPECT_EQ(joined[2], "abc");
+}
+
+TEST(Parallel, ExclusiveScan) {
+    my::ThreadPool pool(4);
+    for (size_t n : {size_t(0), size_t(1), size_t(4097), size_t(300000)}) {
+        MyVector<std::uint32_t> v(n, 0), expected(n, 0);
+        for (size_t i = 0; i < n; ++i) v[i] = std::uint32_t(i * 2654435761u);
+        std::exclusive_scan(v.begin(), v.end(), expected.begin(), std::uint32_t(5));
+        const std::uint32_t total = std::accumulate(v.begin(), v.end(), std::uint32_t(5));
+        EXPECT_EQ(my::parallel::exclusive_scan(v, v, 5, std::plus<>(), pool), total) << n;
+        ASSERT_EQ(v, expected) << n;
+    }
+}
+
+TEST(Parallel, Histogram) {
+    my::ThreadPool pool(4);
+    MyVector<std::uint32_t> keys(500'000, 0);
+    for (size_t i = 0; i < keys.size(); ++i) keys[i] = std::uint32_t((i * 31) % 1000);
+    EXPECT_EQ(my::parallel::histogram(keys, 1000, std::identity(), pool), my::histogram(keys, 1000));
+    EXPECT_THROW(my::parallel::histogram(keys, 999, std::identity(), pool), std::out_of_range);
+}
+
+TEST(Parallel, StablePartition) {
+    my::ThreadPool pool(4);
+    for (size_t n : {size_t(0), size_t(10), size_t(5000), size_t(200'001)}) {
+        MyVector<std::uint64_t> v(n, 0);
+        for (size_t i = 0; i < n; ++i) v[i] = (i * 7919) % 1009;
+        auto odd = [](std::uint64_t x) { return x % 2 == 1; };
+        MyVector<std::uint64_t> expected(v);
+        std::stable_partition(expected.begin(), expected.end(), odd);
+        const size_t k = my::parallel::partition(v, odd, pool);
+        EXPECT_EQ(k, size_t(std::count_if(v.begin(), v.end(), odd))) << n;
+        ASSERT_EQ(v, expected) << n;
+    }
+}
+
+TEST(Parallel, StridedViews) {
+    static_assert(can_reduce<MyStridedView<int>>);
+    static_assert(!can_histogram<MyStridedView<int>>);
+    static_assert(!can_partition<MyStridedView<int>>);
+    static_assert(can_partition<MySpan<int>>);
+
+    my::ThreadPool pool(2);
+    MyVector<int> m(100, 0);
+    std::iota(m.begin(), m.end(), 0);
+    auto col = MySpan<int>(m).strided(2);
+    EXPECT_EQ(my::parallel::reduce(col, 0, std::plus<>(), pool), 2450);
+}
@@ -0,0 +1,105 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_per_thread_vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Copies throw once `countdown` reaches zero; moves may throw too, so
+// gather() has to copy.
+struct Fragile {
+    static inline int countdown = -1;
+    int value = 0;
+    Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("copy");
+    }
+    Fragile& operator=(const Fragile&) = default;
+};
+
+} // namespace
+
+TEST(MyPerThreadVector, GatherInRegistrationOrder) {
+    MyPerThreadVector<std::string> c;
+    c.local().push_back("main");
+    std::thread([&]() {
+        c.local().push_back("t1");
+        c.local().push_back("t1");
+    }).join();
+    c.local().push_back("main");
+    EXPECT_EQ(c.shard_count(), 2);
+    EXPECT_EQ(c.size(), 4);
+
+    MyVector<std::string> all = c.gather();
+    EXPECT_EQ(all, (MyVector<std::string>{"main", "main", "t1", "t1"}));
+    EXPECT_EQ(c.size(), 0);
+    EXPECT_GE(c.local().capacity(), 2);
+    EXPECT_TRUE(c.gather().is_empty());
+}
+
+TEST(MyPerThreadVector, ThreadsAppendWithoutLocking) {
+    constexpr size_t kThreads = 6, kPerThread = 20'000;
+    MyPerThreadVector<std::uint64_t> c;
+    MyVector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&c, t]() {
+            for (size_t i = 0; i < kPerThread; ++i) c.local().push_back(t * kPerThread + i);
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(c.shard_count(), kThreads);
+
+    my::ThreadPool pool(3);
+    MyVector<std::uint64_t> all = c.gather(GatherOrder::thread_id, pool);
+    ASSERT_EQ(all.size(), kThreads * kPerThread);
+    // Each thread's run is contiguous and in its own order.
+    for (size_t i = 0; i < all.size(); i += kPerThread)
+        for (size_t k = 1; k < kPerThread; ++k) ASSERT_EQ(all[i + k], all[i] + k);
+    std::sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); ++i) ASSERT_EQ(all[i], i);
+}
+
+TEST(MyPerThreadVector, CollectFromPoolBodies) {
+    my::ThreadPool pool(4);
+    MyPerThreadVector<int> c;
+    pool.run(100'000, 1000, [&](size_t begin, size_t end, size_t) {
+        MyVector<int>& out = c.local();
+        for (size_t i = begin; i < end; ++i)
+            if (i % 3 == 0) out.push_back(int(i));
+    });
+    MyVector<int> all = c.gather(GatherOrder::registration, pool);
+    EXPECT_EQ(all.size(), 33'334);
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all.back(), 99'999);
+}
+
+TEST(MyPerThreadVector, SeveralCollectorsOnOneThread) {
+    MyPerThreadVector<int> a, b;
+    for (int i = 0; i < 3; ++i) {
+        a.local().push_back(i);
+        b.local().push_back(-i);
+    }
+    EXPECT_EQ(a.shard_count(), 1);
+    EXPECT_EQ(a.gather(), (MyVector<int>{0, 1, 2}));
+    EXPECT_EQ(b.gather(), (MyVector<int>{0, -1, -2}));
+}
+
+TEST(MyPerThreadVector, FailedCopyLeavesShardsUnchanged) {
+    MyPerThreadVector<Fragile> c;
+    for (int i = 0; i < 4; ++i) c.local().push_back(Fragile(i));
+    std::thread([&]() { c.local().push_back(Fragile(10)); }).join();
+
+    Fragile::countdown = 4;
+    EXPECT_THROW(c.gather(), std::runtime_error);
+    Fragile::countdown = -1;
+    EXPECT_EQ(c.size(), 5);
+    MyVector<Fragile> all = c.gather();
+    ASSERT_EQ(all.size(), 5);
+    EXPECT_EQ(all[4].value, 10);
+}
@@ -0,0 +1,163 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_ring_vector.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(MyRingVector, DefaultConstructor) {
+    MyRingVector<int> r;
+    EXPECT_TRUE(r.is_empty());
+    EXPECT_EQ(r.size(), 0);
+}
+
+TEST(MyRingVector, CapacityIsPowerOfTwo) {
+    MyRingVector<int> r(5);
+    EXPECT_EQ(r.capacity(), 8);
+}
+
+TEST(MyRingVector, PushPopBothEnds) {
+    MyRingVector<int> r;
+    r.push_back(2);
+    r.push_back(3);
+    r.push_front(1);
+    r.push_front(0);
+    ASSERT_EQ(r.size(), 4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(r[i], i);
+    r.pop_front();
+    r.pop_back();
+    EXPECT_EQ(r.front(), 1);
+    EXPECT_EQ(r.back(), 2);
+}
+
+TEST(MyRingVector, FifoWrapsAround) {
+    MyRingVector<int> r(4);
+    for (int i = 0; i < 4; ++i) r.push_back(i);
+    for (int i = 4; i < 100; ++i) {
+        EXPECT_EQ(r.front(), i - 4);
+        r.pop_front();
+        r.push_back(i);
+    }
+    EXPECT_EQ(r.capacity(), 4);
+    EXPECT_EQ(r.front(), 96);
+    EXPECT_EQ(r.back(), 99);
+}
+
+TEST(MyRingVector, GrowKeepsOrderWhenWrapped) {
+    MyRingVector<std::string> r(4);
+    r.push_back("c");
+    r.push_back("d");
+    r.push_front("b");
+    r.push_front("a");
+    r.push_back("e");
+    ASSERT_EQ(r.size(), 5);
+    EXPECT_EQ(r.capacity(), 8);
+    std::vector<std::string> expected{"a", "b", "c", "d", "e"};
+    EXPECT_TRUE(std::equal(r.begin(), r.end(), expected.begin(), expected.end()));
+}
+
+TEST(MyRingVector, AtAndEmptyAccessThrow) {
+    MyRingVector<int> r{1, 2};
+    EXPECT_THROW(r.at(2), std::out_of_range);
+    r.pop_back();
+    r.pop_back();
+    EXPECT_THROW(r.front(), std::out_of_range);
+    EXPECT_THROW(r.pop_front(), std::out_of_range);
+}
+
+TEST(MyRingVector, OverwriteOldest) {
+    MyRingVector<int> r(3, RingOverflow::overwrite);
+    for (int i = 0; i < 10; ++i) r.push_back(i);
+    ASSERT_EQ(r.size(), 3);
+    EXPECT_TRUE(r.is_full());
+    EXPECT_EQ(r[0], 7);
+    EXPECT_EQ(r[1], 8);
+    EXPECT_EQ(r[2], 9);
+}
+
+TEST(MyRingVector, EmplaceOwnElement) {
+    MyRingVector<std::string> r;
+    r.push_back(std::string(32, 'a'));
+    for (int i = 0; i < 5; ++i) {
+        r.emplace_back(r.front());     // reallocates on a full ring
+        r.emplace_front(r.back());
+    }
+    EXPECT_EQ(r.size(), 11);
+    EXPECT_TRUE(std::all_of(r.begin(), r.end(), [](const std::string& s) { return s == std::string(32, 'a'); }));
+
+    MyRingVector<std::string> w(2, RingOverflow::overwrite);
+    w.push_back(std::string(32, 'x'));
+    w.push_back(std::string(32, 'y'));
+    w.emplace_back(w.front());         // evicts the front it copies
+    EXPECT_EQ(w[0], std::string(32, 'y'));
+    EXPECT_EQ(w[1], std::string(32, 'x'));
+    w.emplace_front(w.back());
+    EXPECT_EQ(w[0], std::string(32, 'x'));
+    EXPECT_EQ(w[1], std::string(32, 'y'));
+}
+
+TEST(MyRingVector, AsContiguousLinearizesInPlace) {
+    MyRingVector<std::string> r(8);
+    for (int i = 0; i < 6; ++i) r.push_back(std::to_string(i));
+    for (int i = 0; i < 4; ++i) {
+        r.pop_front();
+        r.push_back(std::to_string(6 + i));
+    }
+    auto spans = r.data_spans();
+    ASSERT_FALSE(spans.second.empty());
+    std::string* p = r.as_contiguous();
+    for (int i = 0; i < 6; ++i)
+        EXPECT_EQ(p[i], std::to_string(4 + i));
+    EXPECT_TRUE(r.data_spans().second.empty());
+    EXPECT_EQ(r.capacity(), 8);
+}
+
+TEST(MyRingVector, AsContiguousWhenFull) {
+    MyRingVector<int> r(4);
+    for (int i = 0; i < 4; ++i) r.push_back(i);
+    r.pop_front();
+    r.push_back(4);
+    int* p = r.as_contiguous();
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(p[i], i + 1);
+}
+
+TEST(MyRingVector, FreeSpansBulkWrite) {
+    MyRingVector<int> r(8);
+    for (int i = 0; i < 6; ++i) r.push_back(i);
+    r.consume_front(5);
+    auto [first, second] = r.free_spans();
+    ASSERT_EQ(first.size() + second.size(), 7);
+    int next = 100;
+    for (auto& x : first) x = next++;
+    for (auto& x : second) x = next++;
+    r.commit_back(7);
+    ASSERT_EQ(r.size(), 8);
+    EXPECT_EQ(r.front(), 5);
+    for (int i = 1; i < 8; ++i)
+        EXPECT_EQ(r[i], 99 + i);
+    EXPECT_THROW(r.commit_back(1), std::out_of_range);
+}
+
+TEST(MyRingVector, MoveOnlyElements) {
+    MyRingVector<std::unique_ptr<int>> r;
+    for (int i = 0; i < 5; ++i) r.emplace_front(std::make_unique<int>(i));
+    EXPECT_EQ(*r.front(), 4);
+    EXPECT_EQ(*r.back(), 0);
+}
+
+TEST(MyRingVector, CopyAndCompare) {
+    MyRingVector<int> a{1, 2, 3};
+    a.pop_front();
+    a.push_back(4);
+    MyRingVector<int> b = a;
+    EXPECT_EQ(a, b);
+    b.push_front(0);
+    EXPECT_FALSE(a == b);
+}
@@ -0,0 +1,180 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_shm_vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Tick {
+    std::uint64_t id;
+    double price;
+};
+
+std::string unique_name(const char* tag) {
+    return "/my_shm_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(MyShmVector, PublishAndReadByName) {
+    auto out = MyShmVector<Tick>::create(unique_name("basic"), 4);
+    MyShmReader<Tick> in(out.name());
+    EXPECT_EQ(in.sequence(), 0);
+    EXPECT_TRUE(in.copy().is_empty());
+
+    out.push_back({1, 10.5});
+    out.push_back({2, 11.0});
+    // Not visible before publish().
+    EXPECT_EQ(in.sequence() % 2, 1);
+    const std::uint32_t seq = out.publish();
+    EXPECT_EQ(seq % 2, 0);
+    EXPECT_EQ(in.wait(0), seq);
+
+    MyVector<Tick> got = in.copy();
+    ASSERT_EQ(got.size(), 2);
+    EXPECT_EQ(got[1].id, 2);
+    EXPECT_EQ(got[1].price, 11.0);
+}
+
+TEST(MyShmVector, GrowthRemapsReaders) {
+    auto out = MyShmVector<std::uint64_t>::create_anonymous();
+    auto in = MyShmReader<std::uint64_t>::from_fd(out.fd());
+    const size_t initial = out.capacity();
+    for (std::uint64_t i = 0; i < 100'000; ++i) out.push_back(i);
+    EXPECT_GT(out.capacity(), initial);
+    out.publish();
+    in.read([](MySpan<const std::uint64_t> data) {
+        ASSERT_EQ(data.size(), 100'000);
+        EXPECT_EQ(data[99'999], 99'999);
+    });
+
+    out.clear();
+    MyVector<std::uint64_t> batch(10, std::uint64_t(7));
+    out.append(batch);
+    out.resize(12, 8);
+    out[0] = 1;
+    out.publish();
+    MyVector<std::uint64_t> got = in.copy();
+    ASSERT_EQ(got.size(), 12);
+    EXPECT_EQ(got[0], 1);
+    EXPECT_EQ(got[11], 8);
+}
+
+TEST(MyShmVector, OpenErrors) {
+    EXPECT_THROW(MyShmReader<int>(unique_name("missing")), std::system_error);
+    auto out = MyShmVector<int>::create(unique_name("dup"));
+    EXPECT_THROW(MyShmVector<int>::create(out.name()), std::system_error);
+    EXPECT_THROW(MyShmReader<double>(out.name()), std::runtime_error);
+}
+
+TEST(MyShmVector, NameUnlinkedWithWriter) {
+    std::string name = unique_name("unlink");
+    {
+        auto out = MyShmVector<int>::create(name);
+    }
+    EXPECT_THROW(MyShmReader<int>{name}, std::system_error);
+
+    // Only the moved-to writer owns the name.
+    {
+        std::optional<MyShmVector<int>> from(MyShmVector<int>::create(name));
+        MyShmVector<int> out(std::move(*from));
+        from.reset();
+        EXPECT_EQ(out.name(), name);
+        EXPECT_NO_THROW(MyShmReader<int>{name});
+    }
+    EXPECT_THROW(MyShmReader<int>{name}, std::system_error);
+}
+
+TEST(MyShmVector, WaitTimesOutWithoutPublication) {
+    auto out = MyShmVector<int>::create_anonymous(1);
+    auto in = MyShmReader<int>::from_fd(out.fd());
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(in.wait(0, std::chrono::milliseconds(20)), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+// A forked reader follows several batches, including one that grows the
+// segment, and reports the sum of each through its exit status.
+TEST(MyShmVector, HandoffToAnotherProcess) {
+    auto out = MyShmVector<std::uint32_t>::create(unique_name("fork"), 16);
+    int ack[2];
+    ASSERT_EQ(::pipe(ack), 0);
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ::close(ack[0]);
+        int failures = 0;
+        try {
+            MyShmReader<std::uint32_t> in(out.name());
+            std::uint32_t seen = 0;
+            for (std::uint32_t batch = 1; batch <= 3; ++batch) {
+                seen = in.wait(seen, std::chrono::seconds(5));
+                std::uint64_t sum = 0;
+                size_t size = 0;
+                in.read([&](MySpan<const std::uint32_t> data) {
+                    sum = std::accumulate(data.begin(), data.end(), std::uint64_t(0));
+                    size = data.size();
+                });
+                if (size != batch * 1000 || sum != std::uint64_t(batch) * 1000 * batch) ++failures;
+                char byte = 1;
+                if (::write(ack[1], &byte, 1) != 1) ++failures;
+            }
+        } catch (...) {
+            failures = 100;
+        }
+        ::_exit(failures);
+    }
+    ::close(ack[1]);
+    for (std::uint32_t batch = 1; batch <= 3; ++batch) {
+        out.clear();
+        out.resize(batch * 1000, batch);
+        out.publish();
+        char byte;
+        ASSERT_EQ(::read(ack[0], &byte, 1), 1);
+    }
+    ::close(ack[0]);
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+// A reader thread that keeps reading while the writer rewrites and grows
+// the vector never sees a state that was not published as a whole.
+TEST(MyShmVector, ReadersNeverSeeTornBatches) {
+    auto out = MyShmVector<std::uint64_t>::create_anonymous(8);
+    out.resize(8, 0);
+    out.publish();
+    auto in = MyShmReader<std::uint64_t>::from_fd(out.fd());
+    std::thread reader([&]() {
+        for (int i = 0; i < 2000; ++i) {
+            bool same = true;
+            size_t size = 0;
+            in.read([&](MySpan<const std::uint64_t> data) {
+                size = data.size();
+                same = std::all_of(data.begin(), data.end(), [&](std::uint64_t x) { return x == data[0]; });
+            });
+            EXPECT_TRUE(same);
+            EXPECT_GE(size, 8);
+        }
+    });
+    for (std::uint64_t round = 1; round <= 300; ++round) {
+        out.resize(8 + round * 4);
+        for (auto& x : out) x = round;
+        out.publish();
+    }
+    reader.join();
+}
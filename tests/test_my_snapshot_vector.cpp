@@ -0,0 +1,123 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_snapshot_vector.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Counts live instances, to see when old versions are really freed.
+struct Counted {
+    static inline std::atomic<int> alive{0};
+    int value = 0;
+    Counted(int v = 0) : value(v) { ++alive; }
+    Counted(const Counted& other) : value(other.value) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() { --alive; }
+};
+
+} // namespace
+
+TEST(MySnapshotVector, SnapshotIsImmutable) {
+    MySnapshotVector<int> v{1, 2, 3};
+    auto before = v.snapshot();
+    EXPECT_EQ(v.update([](MyVector<int>& data) { data.push_back(4); }), 1);
+    EXPECT_EQ(before.size(), 3);
+    EXPECT_EQ(before.version(), 0);
+    EXPECT_THROW(before.at(3), std::out_of_range);
+    auto after = v.snapshot();
+    EXPECT_EQ(after.size(), 4);
+    EXPECT_EQ(after[3], 4);
+    EXPECT_EQ(after.version(), 1);
+    EXPECT_EQ(v.publish(MyVector<int>{9}), 2);
+    EXPECT_EQ(v.copy(), MyVector<int>{9});
+}
+
+TEST(MySnapshotVector, FailedUpdatePublishesNothing) {
+    MySnapshotVector<int> v{1, 2};
+    EXPECT_THROW(v.update([](MyVector<int>& data) {
+        data.clear();
+        throw std::runtime_error("abort");
+    }), std::runtime_error);
+    EXPECT_EQ(v.copy(), (MyVector<int>{1, 2}));
+    EXPECT_EQ(v.version(), 0);
+}
+
+TEST(MySnapshotVector, OldVersionsFreedAfterLastReader) {
+    my_rcu::synchronize();
+    const int base = Counted::alive;
+    {
+        MySnapshotVector<Counted> v(MyVector<Counted>(10, Counted(1)));
+        EXPECT_EQ(Counted::alive, base + 10);
+        {
+            auto held = v.snapshot();
+            v.push_back(Counted(2));
+            v.push_back(Counted(3));
+            // The first version is still readable through `held`.
+            my_rcu::reclaim();
+            EXPECT_GE(Counted::alive, base + 10 + 12);
+            EXPECT_EQ(held[0].value, 1);
+        }
+        my_rcu::synchronize();
+        EXPECT_EQ(Counted::alive, base + 12);
+    }
+    my_rcu::synchronize();
+    EXPECT_EQ(Counted::alive, base);
+}
+
+TEST(MySnapshotVector, NestedSnapshotsAndSynchronizeInsideRead) {
+    MySnapshotVector<int> v{1};
+    auto outer = v.snapshot();
+    {
+        auto inner = v.snapshot();
+        EXPECT_EQ(inner[0], 1);
+    }
+    EXPECT_TRUE(my_rcu::domain().in_read());
+    EXPECT_THROW(my_rcu::synchronize(), std::logic_error);
+    EXPECT_EQ(outer[0], 1);
+}
+
+// Writers keep every element of a version equal to its version number, so a
+// reader that saw a torn or freed version would notice. The
+// test_my_snapshot_vector_tsan target runs it under ThreadSanitizer to check
+// the publication ordering.
+TEST(MySnapshotVector, ConcurrentReadersAndWriters) {
+    MySnapshotVector<std::uint64_t> v(MyVector<std::uint64_t>(64, std::uint64_t(0)));
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    MyVector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto snap = v.snapshot();
+                const std::uint64_t version = snap.version();
+                if (version < last) ++bad;
+                last = version;
+                for (std::uint64_t x : snap)
+                    if (x != version) ++bad;
+            }
+        });
+    }
+    MyVector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < 200; ++i)
+                v.update([](MyVector<std::uint64_t>& data) {
+                    for (auto& x : data) ++x;
+                });
+        });
+    }
+    for (auto& t : writers) t.join();
+    stop = true;
+    for (auto& t : readers) t.join();
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(v.version(), 400);
+    EXPECT_EQ(v.snapshot()[63], 400);
+    my_rcu::synchronize();
+    EXPECT_EQ(my_rcu::domain().pending(), 0);
+}
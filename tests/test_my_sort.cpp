@@ -0,0 +1,127 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+template<typename T, typename Gen>
+MyVector<T> random_vector(size_t n, Gen gen) {
+    MyVector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(gen());
+    return v;
+}
+
+} // namespace
+
+TEST(MySort, RadixSignedIntegers) {
+    std::mt19937 gen(1);
+    for (size_t threads : {1, 4}) {
+        auto v = random_vector<int>(200'000, [&] { return static_cast<int>(gen()); });
+        v.push_back(std::numeric_limits<int>::min());
+        v.push_back(std::numeric_limits<int>::max());
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        my::sort(v, threads);
+        EXPECT_EQ(v, expected) << threads << " threads";
+    }
+}
+
+TEST(MySort, RadixUnsignedAndSmallKeys) {
+    std::mt19937_64 gen(2);
+    auto v = random_vector<std::uint64_t>(100'000, [&] { return gen(); });
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    my::sort(v, 3);
+    EXPECT_EQ(v, expected);
+
+    auto bytes = random_vector<std::uint8_t>(1'000, [&] { return static_cast<std::uint8_t>(gen()); });
+    auto expected_bytes = bytes;
+    std::sort(expected_bytes.begin(), expected_bytes.end());
+    my::sort(bytes);
+    EXPECT_EQ(bytes, expected_bytes);
+}
+
+TEST(MySort, RadixFloatingPoint) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    auto v = random_vector<double>(50'000, [&] { return dist(gen); });
+    v.push_back(-0.0);
+    v.push_back(0.0);
+    v.push_back(-std::numeric_limits<double>::infinity());
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    my::sort(v, 2);
+    EXPECT_EQ(v, expected);   // -0.0 == 0.0, so their order is not checked
+    EXPECT_EQ(v.front(), -std::numeric_limits<double>::infinity());
+
+    MyVector<float> f{3.5f, -1.0f, 2.0f, -7.25f};
+    my::sort(f);
+    EXPECT_EQ(f[0], -7.25f);
+    EXPECT_EQ(f[3], 3.5f);
+}
+
+TEST(MySort, LongDoubleUsesMergeSort) {
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<long double> dist(-1e6L, 1e6L);
+    auto v = random_vector<long double>(20'000, [&] { return dist(gen); });
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    my::sort(MySpan<long double>(v), 2);
+    EXPECT_EQ(v, expected);
+
+    struct Item { long double key; int id; };
+    MyVector<Item> items;
+    for (int i = 0; i < 1000; ++i) items.push_back({dist(gen), i});
+    my::sort_by_key(items, [](const Item& it) { return it.key; });
+    for (size_t i = 1; i < items.size(); ++i) ASSERT_LE(items[i - 1].key, items[i].key);
+}
+
+TEST(MySort, SortByKeyIsStable) {
+    struct Row { std::uint32_t key; std::uint32_t order; };
+    std::mt19937 gen(4);
+    MyVector<Row> rows;
+    for (std::uint32_t i = 0; i < 100'000; ++i) rows.push_back({static_cast<std::uint32_t>(gen() % 100), i});
+    my::sort_by_key(rows, [](const Row& r) { return r.key; }, 4);
+    for (size_t i = 1; i < rows.size(); ++i) {
+        ASSERT_LE(rows[i - 1].key, rows[i].key);
+        if (rows[i - 1].key == rows[i].key) {
+            ASSERT_LT(rows[i - 1].order, rows[i].order);
+        }
+    }
+}
+
+TEST(MySort, MergeSortWithComparator) {
+    std::mt19937 gen(5);
+    for (size_t threads : {1, 2, 3, 8}) {
+        auto v = random_vector<int>(300'000, [&] { return static_cast<int>(gen() % 1000); });
+        my::sort(v, std::greater<int>(), threads);
+        EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<int>())) << threads << " threads";
+    }
+}
+
+TEST(MySort, MergeSortStrings) {
+    std::mt19937 gen(6);
+    auto v = random_vector<std::string>(120'000, [&] { return std::string(gen() % 40, char('a' + gen() % 26)); });
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    my::sort(v, 4);
+    EXPECT_EQ(v, expected);
+}
+
+TEST(MySort, SmallAndEmpty) {
+    MyVector<int> empty;
+    my::sort(empty);
+    EXPECT_TRUE(empty.is_empty());
+    MyVector<int> v{3, 1, 2};
+    my::sort(v);
+    EXPECT_EQ(v, (MyVector<int>{1, 2, 3}));
+}
@@ -0,0 +1,86 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_sorted_vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+void expect_matches_std(const MySortedVector<T>& sv, const std::vector<T>& sorted, const std::vector<T>& queries) {
+    MyVector<T> q(queries.begin(), queries.end());
+    MyVector<size_t> batched = sv.lower_bound_many(q);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        size_t expected = std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin();
+        ASSERT_EQ(sv.lower_bound(queries[i]), expected) << "query " << queries[i];
+        ASSERT_EQ(batched[i], expected) << "batched query " << queries[i];
+    }
+}
+
+} // namespace
+
+TEST(MySortedVector, BulkBuildSorts) {
+    MySortedVector<int> sv{5, 1, 4, 2, 3};
+    ASSERT_EQ(sv.size(), 5);
+    EXPECT_TRUE(std::is_sorted(sv.begin(), sv.end()));
+}
+
+TEST(MySortedVector, EmptySearch) {
+    for (auto layout : {SortedLayout::sorted, SortedLayout::eytzinger}) {
+        MySortedVector<int> sv(layout);
+        EXPECT_EQ(sv.lower_bound(3), 0);
+        EXPECT_FALSE(sv.contains(3));
+    }
+}
+
+TEST(MySortedVector, LowerBoundMatchesStdInt32) {
+    std::mt19937 gen(7);
+    for (size_t n : {1, 2, 15, 16, 17, 100, 1000, 4097}) {
+        std::vector<std::int32_t> keys(n), queries(300);
+        for (auto& k : keys) k = static_cast<std::int32_t>(gen() % 2000) - 1000;
+        for (auto& q : queries) q = static_cast<std::int32_t>(gen() % 2200) - 1100;
+        std::vector<std::int32_t> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        for (auto layout : {SortedLayout::sorted, SortedLayout::eytzinger}) {
+            MySortedVector<std::int32_t> sv(MyVector<std::int32_t>(keys.begin(), keys.end()), layout);
+            expect_matches_std(sv, sorted, queries);
+        }
+    }
+}
+
+TEST(MySortedVector, LowerBoundMatchesStdUnsignedAndFloat) {
+    std::vector<std::uint32_t> ukeys{0, 1, 0x7fffffffu, 0x80000000u, 0xfffffffeu, 5, 9, 12, 100, 3000000000u};
+    std::vector<std::uint32_t> usorted = ukeys;
+    std::sort(usorted.begin(), usorted.end());
+    MySortedVector<std::uint32_t> us(MyVector<std::uint32_t>(ukeys.begin(), ukeys.end()));
+    expect_matches_std(us, usorted, {0, 2, 0x80000000u, 0x80000001u, 0xffffffffu, 2999999999u});
+
+    std::vector<float> fkeys(40);
+    for (size_t i = 0; i < fkeys.size(); ++i) fkeys[i] = static_cast<float>(i) * 0.5f - 7.0f;
+    MySortedVector<float> fs(MyVector<float>(fkeys.begin(), fkeys.end()));
+    expect_matches_std(fs, fkeys, {-100.0f, -7.0f, -6.75f, 0.0f, 12.5f, 100.0f});
+}
+
+TEST(MySortedVector, StringsWithEytzinger) {
+    MySortedVector<std::string> sv({"pear", "apple", "fig", "kiwi"}, SortedLayout::eytzinger);
+    EXPECT_EQ(sv[0], "apple");
+    EXPECT_EQ(sv.find("kiwi"), 2);
+    EXPECT_EQ(sv.find("plum"), sv.size());
+}
+
+TEST(MySortedVector, InsertEraseKeepIndex) {
+    MySortedVector<int> sv({10, 30}, SortedLayout::eytzinger);
+    EXPECT_EQ(sv.insert(20), 1);
+    EXPECT_EQ(sv.insert(5), 0);
+    EXPECT_EQ(sv.lower_bound(21), 3);
+    EXPECT_TRUE(sv.erase(10));
+    EXPECT_FALSE(sv.erase(11));
+    EXPECT_EQ(sv.lower_bound(21), 2);
+    sv.set_layout(SortedLayout::sorted);
+    EXPECT_EQ(sv.lower_bound(21), 2);
+}
@@ -0,0 +1,95 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_span.h"
+#include "my_expr.h"
+#include "my_flat_map.h"
+#include "my_sort.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+int sum(MySpan<const int> s) { return std::accumulate(s.begin(), s.end(), 0); }
+
+} // namespace
+
+TEST(MySpan, ConvertsFromContainers) {
+    MyVector<int> v{1, 2, 3, 4};
+    const MyVector<int>& cv = v;
+    MyArray<int, 3> a{5, 6, 7};
+    EXPECT_EQ(sum(v), 10);
+    EXPECT_EQ(sum(cv), 10);
+    EXPECT_EQ(sum(a), 18);
+
+    MySpan s = v;
+    s[0] = 9;
+    EXPECT_EQ(v[0], 9);
+    EXPECT_EQ(s.data(), v.begin());
+    MySpan<const int> c = s;
+    EXPECT_EQ(c.size(), 4);
+}
+
+TEST(MySpan, SubspanFirstLast) {
+    MyVector<int> v(10, 0);
+    std::iota(v.begin(), v.end(), 0);
+    MySpan<int> s(v);
+    EXPECT_EQ(s.subspan(3, 4).front(), 3);
+    EXPECT_EQ(s.subspan(3, 4).back(), 6);
+    EXPECT_EQ(s.subspan(7).size(), 3);
+    EXPECT_EQ(s.first(2).back(), 1);
+    EXPECT_EQ(s.last(2).front(), 8);
+    EXPECT_TRUE(s.subspan(10).is_empty());
+    EXPECT_THROW(s.subspan(11), std::out_of_range);
+    EXPECT_THROW(s.subspan(5, 6), std::out_of_range);
+    EXPECT_THROW(s.first(11), std::out_of_range);
+    EXPECT_THROW(s.at(10), std::out_of_range);
+}
+
+TEST(MySpan, StridedColumns) {
+    // 3x4 row-major matrix.
+    MyVector<int> m(12, 0);
+    std::iota(m.begin(), m.end(), 0);
+    MyStridedView<int> col = MySpan<int>(m).strided(4, 1);
+    ASSERT_EQ(col.size(), 3);
+    EXPECT_EQ(col[0], 1);
+    EXPECT_EQ(col[2], 9);
+    for (int& x : col) x = -x;
+    EXPECT_EQ(m[5], -5);
+    EXPECT_EQ(std::count_if(col.begin(), col.end(), [](int x) { return x < 0; }), 3);
+    EXPECT_EQ(col.end() - col.begin(), 3);
+    EXPECT_EQ(MySpan<int>(m).strided(5, 3).size(), 2);
+    EXPECT_THROW(MySpan<int>(m).strided(0), std::invalid_argument);
+}
+
+TEST(MySpan, ChunksCoverTheRange) {
+    MyVector<int> v(10, 1);
+    auto parts = MySpan<int>(v).chunks(3);
+    ASSERT_EQ(parts.size(), 3);
+    EXPECT_EQ(parts[0].size(), 4);
+    EXPECT_EQ(parts[1].size(), 3);
+    EXPECT_EQ(parts[2].size(), 3);
+    EXPECT_EQ(parts[2].end(), v.end());
+    EXPECT_EQ(MySpan<int>(v).chunks(12)[11].size(), 0);
+}
+
+TEST(MySpan, HotFunctionOverloads) {
+    MyVector<int> v{5, 4, 3, 2, 1, 0};
+    my::sort(MySpan<int>(v).first(3));
+    EXPECT_EQ(v, (MyVector<int>{3, 4, 5, 2, 1, 0}));
+    my::sort(MySpan<int>(v).last(3), std::greater<int>());
+    EXPECT_EQ(v, (MyVector<int>{3, 4, 5, 2, 1, 0}));
+
+    MyVector<double> x{1, 2, 3, 4, 5, 6};
+    EXPECT_DOUBLE_EQ(my::sum(MySpan<double>(x).subspan(1, 2) * 2.0), 10.0);
+    EXPECT_DOUBLE_EQ(my::dot(MySpan<double>(x).strided(2), MySpan<double>(x).strided(2, 1)), 2 + 12 + 30);
+
+    MyFlatMap<int, int> map(MyVector<std::pair<int, int>>{{1, 10}, {2, 20}, {3, 30}});
+    MyVector<int> keys{3, 4, 1};
+    MyVector<size_t> out(3, 0);
+    map.find_many(MySpan<const int>(keys).first(2), MySpan<size_t>(out));
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[1], (MyFlatMap<int, int>::npos));
+}
@@ -0,0 +1,166 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_static_vector.h"
+#include <cstring>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<MyStaticVector<int, 64>>);
+static_assert(std::is_trivially_copyable_v<MyStaticVector<double, 4, StaticOverflow::unchecked>>);
+static_assert(!std::is_trivially_copyable_v<MyStaticVector<std::string, 4>>);
+static_assert(sizeof(MyStaticVector<int, 64>) == 64 * sizeof(int) + sizeof(size_t));
+static_assert(MyStaticVector<int, 8>::capacity() == 8);
+
+namespace {
+
+// No noexcept move, so shifting copies; copies throw once `countdown`
+// reaches zero. `live` holds the address of every constructed object, so a
+// leak or a double destruction shows up.
+struct Fragile {
+    static inline int countdown = -1;
+    static inline std::set<const Fragile*> live;
+    static inline int bad_destroys = 0;
+    int value = 0;
+    Fragile(int v = 0) : value(v) { live.insert(this); }
+    Fragile(const Fragile& other) : value(other.value) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("copy");
+        live.insert(this);
+    }
+    Fragile& operator=(const Fragile& other) {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("assign");
+        value = other.value;
+        return *this;
+    }
+    ~Fragile() {
+        if (live.erase(this) == 0) ++bad_destroys;
+    }
+};
+
+} // namespace
+
+TEST(MyStaticVector, PushPopAndAccess) {
+    MyStaticVector<int, 4> v;
+    EXPECT_TRUE(v.is_empty());
+    v.push_back(1);
+    v.emplace_back(2);
+    v.push_back(3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v.front(), 1);
+    EXPECT_EQ(v.back(), 3);
+    EXPECT_EQ(v[1], 2);
+    EXPECT_THROW(v.at(3), std::out_of_range);
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2);
+    v.clear();
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+    EXPECT_THROW(v.front(), std::out_of_range);
+}
+
+TEST(MyStaticVector, OverflowThrowsWithoutChange) {
+    MyStaticVector<int, 3> v{1, 2, 3};
+    EXPECT_TRUE(v.is_full());
+    EXPECT_THROW(v.push_back(4), std::length_error);
+    EXPECT_THROW(v.insert(v.begin(), 0), std::length_error);
+    EXPECT_THROW(v.resize(5), std::length_error);
+    int extra[] = {7, 8};
+    EXPECT_THROW(v.insert(v.end(), extra, extra + 2), std::length_error);
+    EXPECT_EQ(v, (MyStaticVector<int, 3>{1, 2, 3}));
+    EXPECT_THROW((MyStaticVector<int, 2>{1, 2, 3}), std::length_error);
+}
+
+TEST(MyStaticVector, TryPushBack) {
+    MyStaticVector<int, 2, StaticOverflow::unchecked> v;
+    EXPECT_TRUE(v.try_push_back(1));
+    EXPECT_NE(v.try_emplace_back(2), nullptr);
+    EXPECT_FALSE(v.try_push_back(3));
+    EXPECT_EQ(v.size(), 2);
+}
+
+TEST(MyStaticVectorDeathTest, OverflowTerminates) {
+    MyStaticVector<int, 1, StaticOverflow::terminate> v{1};
+    EXPECT_DEATH(v.push_back(2), "");
+}
+
+TEST(MyStaticVector, InsertAndErase) {
+    MyStaticVector<int, 16> v{1, 2, 5};
+    v.insert(v.begin() + 2, 4);
+    v.insert(v.begin() + 2, 3);
+    EXPECT_EQ(v, (MyStaticVector<int, 16>{1, 2, 3, 4, 5}));
+    int more[] = {10, 11};
+    v.insert(v.begin(), more, more + 2);
+    EXPECT_EQ(v, (MyStaticVector<int, 16>{10, 11, 1, 2, 3, 4, 5}));
+    v.erase(v.begin());
+    v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(v, (MyStaticVector<int, 16>{11, 3, 4, 5}));
+    v.emplace(v.begin(), v[3]);   // argument aliases an element
+    EXPECT_EQ(v.front(), 5);
+    EXPECT_THROW(v.erase(v.end()), std::out_of_range);
+}
+
+TEST(MyStaticVector, NonTrivialElements) {
+    MyStaticVector<std::string, 8> v;
+    v.push_back(std::string(40, 'a'));
+    v.emplace_back(40, 'b');
+    v.insert(v.begin(), std::string(40, 'c'));
+    v.resize(5, "pad");
+    MyStaticVector<std::string, 8> copy(v);
+    EXPECT_EQ(copy, v);
+    MyStaticVector<std::string, 8> moved(std::move(copy));
+    EXPECT_TRUE(copy.is_empty());
+    EXPECT_EQ(moved[0], std::string(40, 'c'));
+    EXPECT_EQ(moved[4], "pad");
+    moved.erase(moved.begin() + 1);
+    EXPECT_EQ(moved[1], std::string(40, 'b'));
+    v = moved;
+    v.swap(moved);
+    EXPECT_EQ(v, moved);
+    EXPECT_LT((MyStaticVector<std::string, 2>{"a"}), (MyStaticVector<std::string, 2>{"b"}));
+}
+
+TEST(MyStaticVector, ThrowingShiftKeepsElementsCounted) {
+    for (int fail_at = 0; fail_at < 8; ++fail_at) {
+        {
+            MyStaticVector<Fragile, 16> v;
+            for (int i = 0; i < 6; ++i) v.emplace_back(i);
+            Fragile extra[] = {Fragile(10), Fragile(11)};
+            Fragile::countdown = fail_at;
+            try {
+                v.emplace(v.begin() + 1, 7);
+                v.insert(v.begin() + 2, extra, extra + 2);
+                v.erase(v.begin(), v.begin() + 2);
+            } catch (const std::runtime_error&) {
+            }
+            Fragile::countdown = -1;
+            EXPECT_EQ(Fragile::live.size(), v.size() + 2) << fail_at;
+            for (const Fragile& f : v) EXPECT_EQ(Fragile::live.count(&f), 1) << fail_at;
+        }
+        EXPECT_TRUE(Fragile::live.empty()) << fail_at;
+        EXPECT_EQ(Fragile::bad_destroys, 0) << fail_at;
+    }
+    MyStaticVector<Fragile, 8> v{1, 2, 4};
+    v.emplace(v.begin() + 2, 3);
+    v.erase(v.begin());
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0].value + v[1].value * 10 + v[2].value * 100, 432);
+}
+
+TEST(MyStaticVector, MoveOnlyElements) {
+    MyStaticVector<std::unique_ptr<int>, 4> v;
+    v.push_back(std::make_unique<int>(1));
+    v.emplace(v.begin(), std::make_unique<int>(0));
+    MyStaticVector<std::unique_ptr<int>, 4> w = std::move(v);
+    EXPECT_EQ(*w[0], 0);
+    EXPECT_EQ(*w[1], 1);
+}
+
+TEST(MyStaticVector, CopiesAsBytes) {
+    MyStaticVector<int, 8> v{1, 2, 3};
+    MyStaticVector<int, 8> w;
+    std::memcpy(static_cast<void*>(&w), &v, sizeof(v));
+    EXPECT_EQ(w, v);
+}
@@ -0,0 +1,151 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include "my_tracked_vector.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+TEST(MyTrackedVector, RegistryAccountsCapacity) {
+    const size_t base = my_memory::total_bytes();
+    const size_t count = my_memory::registry().count();
+    {
+        MyTrackedVector<int> v;
+        v.reserve(1000);
+        EXPECT_EQ(my_memory::registry().count(), count + 1);
+        EXPECT_EQ(my_memory::total_bytes(), base + 1000 * sizeof(int));
+
+        MyTrackedVector<int> w(std::move(v));
+        EXPECT_EQ(my_memory::total_bytes(), base + 1000 * sizeof(int));
+        MyTrackedVector<int> copy(w);
+        EXPECT_EQ(my_memory::total_bytes(), base + 2 * copy.capacity() * sizeof(int));
+    }
+    EXPECT_EQ(my_memory::registry().count(), count);
+    EXPECT_EQ(my_memory::total_bytes(), base);
+}
+
+TEST(MyTrackedVector, MoveIsNoexceptAndAssignmentKeepsPolicy) {
+    static_assert(std::is_nothrow_move_constructible_v<MyTrackedVector<int>>);
+    my_memory::ShrinkPolicy policy;
+    policy.patience = 3;
+    MyTrackedVector<int> shrinking(policy);
+    shrinking.push_back(1);
+
+    MyTrackedVector<int> a;
+    a = shrinking;
+    EXPECT_TRUE(a.auto_shrink());
+    EXPECT_EQ(a.policy().patience, 3);
+    MyTrackedVector<int> b;
+    b = std::move(a);
+    EXPECT_TRUE(b.auto_shrink());
+    EXPECT_EQ(b.policy().patience, 3);
+    EXPECT_EQ(b, MyTrackedVector<int>{1});
+}
+
+TEST(MyTrackedVector, NoAutoShrinkByDefault) {
+    MyTrackedVector<int> v;
+    for (int i = 0; i < 100000; ++i) v.push_back(i);
+    const size_t cap = v.capacity();
+    while (v.size() > 10) v.pop_back();
+    EXPECT_EQ(v.capacity(), cap);
+    EXPECT_FALSE(v.auto_shrink());
+}
+
+TEST(MyTrackedVector, AutoShrinkAfterPatience) {
+    my_memory::ShrinkPolicy policy;
+    policy.patience = 8;
+    policy.min_slack_bytes = 0;
+    MyTrackedVector<int> v(policy);
+    for (int i = 0; i < 10000; ++i) v.push_back(i);
+    const size_t cap = v.capacity();
+
+    // Below a quarter of capacity for fewer than `patience` operations: no shrink.
+    v.resize(cap / 4 - 4);
+    for (int i = 0; i < 6; ++i) v.pop_back();
+    EXPECT_EQ(v.capacity(), cap);
+    // Back above the threshold resets the streak.
+    v.resize(cap / 2);
+    for (int i = 0; i < 7; ++i) v.resize(cap / 8);
+    EXPECT_EQ(v.capacity(), cap);
+
+    v.pop_back();
+    EXPECT_LT(v.capacity(), cap);
+    EXPECT_GE(v.capacity(), v.size());
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], static_cast<int>(i));
+}
+
+TEST(MyTrackedVector, MinSlackBlocksSmallShrinks) {
+    my_memory::ShrinkPolicy policy;
+    policy.patience = 1;
+    MyTrackedVector<int> v(policy);
+    for (int i = 0; i < 64; ++i) v.push_back(i);
+    const size_t cap = v.capacity();
+    v.clear();
+    v.push_back(1);
+    EXPECT_EQ(v.capacity(), cap);
+}
+
+TEST(MyTrackedVector, TrimAllReleasesSlack) {
+    MyTrackedVector<int> a, b;
+    a.reserve(10000);
+    b.reserve(5000);
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(i);
+        b.push_back(-i);
+    }
+    const size_t before = my_memory::total_bytes();
+    EXPECT_EQ(my_memory::trim_all(before), 0);
+
+    const size_t released = my_memory::trim_all(0);
+    EXPECT_EQ(released, (10000 - 100 + 5000 - 100) * sizeof(int));
+    EXPECT_EQ(my_memory::total_bytes(), before - released);
+    EXPECT_EQ(a.capacity(), 100);
+    EXPECT_EQ(b.capacity(), 100);
+    EXPECT_EQ(a[99], 99);
+    EXPECT_EQ(b[99], -99);
+}
+
+TEST(MyTrackedVector, TrimAllStopsAtTarget) {
+    MyTrackedVector<int> big, small;
+    big.reserve(100000);
+    small.reserve(1000);
+    const size_t before = my_memory::total_bytes();
+    my_memory::trim_all(before - 1);
+    // The largest slack goes first and is enough on its own.
+    EXPECT_EQ(big.capacity(), 0);
+    EXPECT_EQ(small.capacity(), 1000);
+}
+
+#ifdef __linux__
+TEST(MyTrackedVector, LargeBuffersTrimWithMadvise) {
+    const size_t n = 4 * my_memory::kMadviseBytes / sizeof(std::uint64_t);
+    MyTrackedVector<std::uint64_t> v;
+    for (size_t i = 0; i < n; ++i) v.push_back(i);
+    const std::uint64_t* data = v.begin();
+    const size_t cap = v.capacity();
+
+    v.resize(1000);
+    const size_t released = v.release_slack();
+    EXPECT_EQ(v.begin(), data);           // no reallocation
+    EXPECT_EQ(v.capacity(), cap);
+    EXPECT_GT(released, (cap - 1000) * sizeof(std::uint64_t) - 2 * my_memory::page_size());
+    EXPECT_LT(v.resident_bytes(), 1000 * sizeof(std::uint64_t) + 2 * my_memory::page_size());
+    for (size_t i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+
+    // The trimmed state moves with the buffer.
+    const size_t resident = v.resident_bytes();
+    const size_t total = my_memory::total_bytes();
+    MyTrackedVector<std::uint64_t> moved(std::move(v));
+    EXPECT_EQ(moved.resident_bytes(), resident);
+    EXPECT_EQ(my_memory::total_bytes(), total);
+    v = std::move(moved);
+    EXPECT_EQ(v.resident_bytes(), resident);
+    EXPECT_EQ(my_memory::total_bytes(), total);
+
+    // Writing into released pages brings them back into the accounting.
+    for (size_t i = 1000; i < n / 2; ++i) v.push_back(i);
+    EXPECT_GE(v.resident_bytes(), n / 2 * sizeof(std::uint64_t));
+    for (size_t i = 0; i < n / 2; ++i) ASSERT_EQ(v[i], i);
+}
+#endif
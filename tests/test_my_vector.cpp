@@ -7,8 +7,28 @@
 #include <initializer_list>
 #include <iterator>
 #include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <sstream>
 #include <string>
 
+namespace {
+
+// Counts copies; moves are free.
+struct CopyCounter {
+    static inline int copies = 0;
+    int value;
+
+    explicit CopyCounter(int v = 0) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) {}
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&&) noexcept = default;
+};
+
+} // namespace
+
 TEST(MyVector, DefaultConstructor) {
     MyVector<int> v;
     EXPECT_TRUE(v.is_empty());
@@ -129,6 +149,12 @@ TEST(MyVector, ResizeGrowDefault) {
     EXPECT_EQ(v[2], {});
 }
 
+TEST(MyVector, ResizeFromOwnElement) {
+    MyVector<std::string> v{std::string(32, 'a')};
+    v.resize(4, v[0]);   // reallocates while the value is still needed
+    EXPECT_EQ(v, MyVector<std::string>(4, std::string(32, 'a')));
+}
+
 TEST(MyVector, InsertSingle) {
     MyVector<int> v{1, 3};
     auto it = v.insert(v.begin() + 1, 2);
@@ -186,6 +212,15 @@ TEST(MyVector, PushPopEmplaceBack) {
     EXPECT_EQ(v.size(), 1);
 }
 
+TEST(MyVector, PopBackDestroysLastElement) {
+    MyVector<std::string> v{"first", std::string(64, 'x')};
+    v.pop_back();
+    ASSERT_EQ(v.size(), 1);
+    EXPECT_EQ(v.back(), "first");
+    v.pop_back();
+    EXPECT_TRUE(v.is_empty());
+}
+
 TEST(MyVector, ComparisonOperators) {
     MyVector<int> a{1, 2, 3};
     MyVector<int> b{1, 2, 4};
@@ -255,3 +290,125 @@ TEST(MyVector, NestedPushBackSelfBack) {
     ASSERT_EQ(v.size(), 2);
     EXPECT_EQ(v[1], v[0]); // Must be deep copy
 }
+
+TEST(MyVector, RvalueOverloadsDoNotCopy) {
+    CopyCounter::copies = 0;
+    MyVector<CopyCounter> v;
+    for (int i = 0; i < 20; ++i) {
+        CopyCounter c(i);
+        v.push_back(std::move(c));
+    }
+    CopyCounter mid(100);
+    v.insert(v.begin() + 5, std::move(mid));
+    v.emplace(v.begin(), 200);
+    v.emplace(v.end(), 300);
+    CopyCounter& ref = v.emplace_back(400);
+    EXPECT_EQ(ref.value, 400);
+    EXPECT_EQ(&ref, &v.back());
+    EXPECT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(v.size(), 24);
+    EXPECT_EQ(v[0].value, 200);
+    EXPECT_EQ(v[6].value, 100);
+    EXPECT_EQ(v[22].value, 300);
+}
+
+TEST(MyVector, MoveIteratorRangeConstructAndInsert) {
+    MyVector<std::unique_ptr<int>> src;
+    for (int i = 0; i < 4; ++i) src.push_back(std::make_unique<int>(i));
+    MyVector<std::unique_ptr<int>> dst(std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+    ASSERT_EQ(dst.size(), 4);
+    EXPECT_EQ(*dst[3], 3);
+    EXPECT_EQ(src[0], nullptr);
+
+    MyVector<std::unique_ptr<int>> more;
+    more.push_back(std::make_unique<int>(10));
+    more.push_back(std::make_unique<int>(11));
+    dst.insert(dst.begin() + 1, std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+    ASSERT_EQ(dst.size(), 6);
+    EXPECT_EQ(*dst[1], 10);
+    EXPECT_EQ(*dst[2], 11);
+    EXPECT_EQ(*dst[5], 3);
+
+    dst.reserve(20);
+    MyVector<std::unique_ptr<int>> tail;
+    tail.push_back(std::make_unique<int>(12));
+    dst.insert(dst.begin(), std::make_move_iterator(tail.begin()), std::make_move_iterator(tail.end()));
+    EXPECT_EQ(*dst[0], 12);
+    EXPECT_EQ(*dst[6], 3);
+}
+
+TEST(MyVector, RangeConstructFromInputIterator) {
+    std::istringstream in("1 2 3 4");
+    MyVector<int> v{std::istream_iterator<int>(in), std::istream_iterator<int>()};
+    EXPECT_EQ(v, (MyVector<int>{1, 2, 3, 4}));
+}
+
+TEST(MyVector, EmplaceFromOwnElement) {
+    MyVector<std::string> v{"a", "b", std::string(40, 'c')};
+    v.shrink_to_fit();
+    v.emplace(v.begin(), v[2]);
+    v.emplace_back(v[0]);
+    EXPECT_EQ(v[0], std::string(40, 'c'));
+    EXPECT_EQ(v[4], std::string(40, 'c'));
+    v.insert(v.begin() + 1, v[1]);
+    EXPECT_EQ(v[1], "a");
+    EXPECT_EQ(v[2], "a");
+}
+
+// Every level the CPU supports agrees with the scalar kernels, for all
+// element sizes, unaligned starts and lengths around the vector widths.
+TEST(MyVector, KernelsAgreeAtEveryLevel) {
+    const my_simd::Level saved = my_simd::level();
+    for (my_simd::Level level : {my_simd::Level::scalar, my_simd::Level::sse42, my_simd::Level::avx2,
+                                 my_simd::Level::avx512}) {
+        if (my_simd::set_level(level) != level) continue;
+        SCOPED_TRACE(my_simd::level_name(level));
+        for (size_t n : {0, 1, 7, 16, 31, 64, 65, 200}) {
+            MyVector<std::uint8_t> bytes(n + 1, 0);
+            MyVector<std::uint16_t> shorts(n, 5);
+            MyVector<std::int32_t> ints(n, -1);
+            MyVector<std::uint64_t> longs(n, 0x0102030405060708ull);
+            EXPECT_TRUE(std::all_of(shorts.begin(), shorts.end(), [](auto x) { return x == 5; }));
+            EXPECT_TRUE(std::all_of(longs.begin(), longs.end(), [](auto x) { return x == 0x0102030405060708ull; }));
+            EXPECT_EQ(my_simd::find(bytes.begin() + 1, n, std::uint8_t(1)), n);
+            for (size_t at = 0; at < n; at += 3) {
+                MyVector<std::int32_t> other(ints);
+                EXPECT_EQ(other, ints);
+                other[at] = 7;
+                EXPECT_NE(other, ints);
+                EXPECT_LT(ints, other);
+                EXPECT_EQ(my_simd::mismatch(ints.begin(), other.begin(), n), at);
+                EXPECT_EQ(my_simd::find(other.begin(), n, 7), at);
+                bytes[at + 1] = 1;
+                EXPECT_EQ(my_simd::find(bytes.begin() + 1, n, std::uint8_t(1)), at);
+                bytes[at + 1] = 0;
+                longs[at] = 1;
+                EXPECT_EQ(my_simd::find(longs.begin(), n, std::uint64_t(1)), at);
+                longs[at] = 0x0102030405060708ull;
+            }
+        }
+    }
+    my_simd::set_level(saved);
+}
+
+TEST(MyVector, CompareAndFillBitwiseElements) {
+    MyVector<int> a{1, 2, 3}, b{1, 2, 4}, c{1, 2};
+    EXPECT_LT(a, b);
+    EXPECT_GT(a, c);
+    EXPECT_EQ(a <=> (MyVector<int>{1, 2, 3}), std::strong_ordering::equal);
+    EXPECT_LT(MyVector<int>{-1}, MyVector<int>{0});
+
+    MyVector<char> text(3, 'x');
+    text.resize(5, 'y');
+    EXPECT_EQ(text, (MyVector<char>{'x', 'x', 'x', 'y', 'y'}));
+    text.resize(9, text[0]);
+    EXPECT_EQ(text.back(), 'x');
+    MyVector<char> copy(text);
+    EXPECT_EQ(copy, text);
+
+    my_simd::Level level;
+    EXPECT_TRUE(my_simd::parse_level("avx2", level));
+    EXPECT_EQ(level, my_simd::Level::avx2);
+    EXPECT_FALSE(my_simd::parse_level("avx3", level));
+    EXPECT_LE(my_simd::level(), my_simd::detected_level());
+}